@@ -0,0 +1,224 @@
+//     ____   ______ __
+//    / __ \ / ____// /
+//   / /_/ // /    / /
+//  / ____// /___ / /___   PixInsight Class Library
+// /_/     \____//_____/   PCL 02.01.00.0779
+// ----------------------------------------------------------------------------
+// Standard CFA2RGB Process Module Version 01.01.01.0010
+// ----------------------------------------------------------------------------
+// CFA2RGBAccumulator.cpp - Released 2016/02/03 00:00:00 UTC
+// ----------------------------------------------------------------------------
+// This file is part of the standard CFA2RGB PixInsight module.
+//
+// Copyright (c) 2003-2016 Pleiades Astrophoto S.L. All Rights Reserved.
+//
+// Redistribution and use in both source and binary forms, with or without
+// modification, is permitted provided that the following conditions are met:
+//
+// 1. All redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. All redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the names "PixInsight" and "Pleiades Astrophoto", nor the names
+//    of their contributors, may be used to endorse or promote products derived
+//    from this software without specific prior written permission. For written
+//    permission, please contact info@pixinsight.com.
+//
+// 4. All products derived from this software, in any form whatsoever, must
+//    reproduce the following acknowledgment in the end-user documentation
+//    and/or other materials provided with the product:
+//
+//    "This product is based on software from the PixInsight project, developed
+//    by Pleiades Astrophoto and its contributors (http://pixinsight.com/)."
+//
+//    Alternatively, if that is where third-party acknowledgments normally
+//    appear, this acknowledgment must be reproduced in the product itself.
+//
+// THIS SOFTWARE IS PROVIDED BY PLEIADES ASTROPHOTO AND ITS CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL PLEIADES ASTROPHOTO OR ITS
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, BUSINESS
+// INTERRUPTION; PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; AND LOSS OF USE,
+// DATA OR PROFITS) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// ----------------------------------------------------------------------------
+
+
+#include "CFA2RGBAccumulator.h"
+#include "CFA2RGBEngine.h"
+#include "CFA2RGBWorkerPool.h"
+
+#include <pcl/Exception.h>
+#include <pcl/ReferenceArray.h>
+#include <pcl/Thread.h>
+
+namespace pcl
+{
+
+// ----------------------------------------------------------------------------
+
+template <class P>
+class CFA2RGBAccumulatorThread : public Thread
+{
+public:
+
+   CFA2RGBAccumulatorThread( CFA2RGBAccumulator& A, const GenericImage<P>& rgb, const CFA2RGBCoverageMap* coverage,
+                             int startRow, int endRow ) :
+   Thread(),
+   m_A( A ), m_rgb( rgb ), m_coverage( coverage ), m_startRow( startRow ), m_endRow( endRow )
+   {
+   }
+
+   virtual void Run()
+   {
+      const int width = m_rgb.Width();
+      for ( int c = 0; c < 3; ++c )
+         for ( int y = m_startRow; y < m_endRow; ++y )
+         {
+            const typename P::sample* f = m_rgb.ScanLine( y, c );
+            const uint8* bits = (m_coverage != 0) ? m_coverage->Row( y, c ) : 0;
+            size_type i = size_type( y )*size_type( width );
+            double* m = m_A.m_mean[c].Begin() + i;
+            double* q = m_A.m_m2[c].Begin() + i;
+            uint32* n = m_A.m_count[c].Begin() + i;
+            for ( int x = 0; x < width; ++x )
+               if ( bits == 0 || ((bits[x >> 3] >> (x & 7)) & 1) )
+               {
+                  double v;
+                  P::FromSample( v, f[x] );
+                  double d = v - m[x];
+                  m[x] += d/++n[x];
+                  q[x] += d*(v - m[x]);
+               }
+         }
+   }
+
+private:
+
+   CFA2RGBAccumulator&       m_A;
+   const GenericImage<P>&    m_rgb;
+   const CFA2RGBCoverageMap* m_coverage;
+   int                       m_startRow;
+   int                       m_endRow;
+};
+
+template <class P>
+static void Accumulate( CFA2RGBAccumulator& A, const GenericImage<P>& rgb, const CFA2RGBCoverageMap* coverage,
+                        int maxThreads )
+{
+   const int height = rgb.Height();
+   int numberOfThreads = Thread::NumberOfThreads( height, 16 );
+   if ( maxThreads > 0 )
+      numberOfThreads = Min( numberOfThreads, maxThreads );
+   const int rowsPerThread = height/numberOfThreads;
+
+   ReferenceArray<CFA2RGBAccumulatorThread<P> > threads;
+   for ( int i = 0, j = 1; i < numberOfThreads; ++i, ++j )
+      threads.Add( new CFA2RGBAccumulatorThread<P>( A, rgb, coverage,
+                                                    i*rowsPerThread, (j < numberOfThreads) ? j*rowsPerThread : height ) );
+   if ( numberOfThreads > 1 )
+   {
+      Array<Thread*> tasks;
+      for ( int i = 0; i < numberOfThreads; ++i )
+         tasks.Add( &threads[i] );
+      try
+      {
+         CFA2RGBWorkerPool::Shared().Run( tasks );
+      }
+      catch ( ... )
+      {
+         threads.Destroy();
+         throw;
+      }
+   }
+   else
+      threads[0].Run();
+
+   threads.Destroy();
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBAccumulator::CFA2RGBAccumulator() : m_width( 0 ), m_height( 0 ), m_frames( 0 )
+{
+}
+
+void CFA2RGBAccumulator::Add( const ImageVariant& rgb, const CFA2RGBCoverageMap* coverage, int maxThreads )
+{
+   if ( rgb->NumberOfChannels() != 3 )
+      throw Error( "CFA2RGBAccumulator: Not an RGB image." );
+
+   if ( m_frames == 0 )
+   {
+      m_width = rgb->Width();
+      m_height = rgb->Height();
+      size_type N = size_type( m_width )*size_type( m_height );
+      for ( int c = 0; c < 3; ++c )
+      {
+         m_mean[c] = Array<double>( N, 0.0 );
+         m_m2[c] = Array<double>( N, 0.0 );
+         m_count[c] = Array<uint32>( N, uint32( 0 ) );
+      }
+   }
+   else if ( rgb->Width() != m_width || rgb->Height() != m_height )
+      throw Error( String().Format( "CFA2RGBAccumulator: Incompatible frame dimensions: %dx%d, expected %dx%d.",
+                                    rgb->Width(), rgb->Height(), m_width, m_height ) );
+
+   if ( coverage != 0 )
+      if ( coverage->Width() != m_width || coverage->Height() != m_height )
+         throw Error( "CFA2RGBAccumulator: Coverage map does not match the frame." );
+
+   if ( rgb.IsFloatSample() )
+      switch ( rgb.BitsPerSample() )
+      {
+      case 32: Accumulate( *this, static_cast<const Image&>( *rgb ), coverage, maxThreads ); break;
+      case 64: Accumulate( *this, static_cast<const DImage&>( *rgb ), coverage, maxThreads ); break;
+      }
+   else
+      switch ( rgb.BitsPerSample() )
+      {
+      case  8: Accumulate( *this, static_cast<const UInt8Image&>( *rgb ), coverage, maxThreads ); break;
+      case 16: Accumulate( *this, static_cast<const UInt16Image&>( *rgb ), coverage, maxThreads ); break;
+      case 32: Accumulate( *this, static_cast<const UInt32Image&>( *rgb ), coverage, maxThreads ); break;
+      }
+
+   ++m_frames;
+}
+
+void CFA2RGBAccumulator::GetResults( Image& mean, Image& sigma ) const
+{
+   mean.AllocateData( m_width, m_height, 3, ColorSpace::RGB );
+   sigma.AllocateData( m_width, m_height, 3, ColorSpace::RGB );
+
+   const size_type N = size_type( m_width )*size_type( m_height );
+   for ( int c = 0; c < 3; ++c )
+   {
+      float* m = mean.PixelData( c );
+      float* s = sigma.PixelData( c );
+      for ( size_type i = 0; i < N; ++i )
+      {
+         uint32 n = m_count[c][i];
+         if ( n == 0 )
+         {
+            m[i] = s[i] = 0;
+            continue;
+         }
+         m[i] = float( m_mean[c][i] );
+         s[i] = (n > 1) ? float( Sqrt( m_m2[c][i]/(n - 1) ) ) : 0.0F;
+      }
+   }
+}
+
+// ----------------------------------------------------------------------------
+
+} // pcl
+
+// ****************************************************************************
+// EOF CFA2RGBAccumulator.cpp - Released 2016/02/03 00:00:00 UTC
@@ -0,0 +1,138 @@
+//     ____   ______ __
+//    / __ \ / ____// /
+//   / /_/ // /    / /
+//  / ____// /___ / /___   PixInsight Class Library
+// /_/     \____//_____/   PCL 02.01.00.0779
+// ----------------------------------------------------------------------------
+// Standard CFA2RGB Process Module Version 01.01.01.0010
+// ----------------------------------------------------------------------------
+// CFA2RGBAccumulator.h - Released 2016/02/03 00:00:00 UTC
+// ----------------------------------------------------------------------------
+// This file is part of the standard CFA2RGB PixInsight module.
+//
+// Copyright (c) 2003-2016 Pleiades Astrophoto S.L. All Rights Reserved.
+//
+// Redistribution and use in both source and binary forms, with or without
+// modification, is permitted provided that the following conditions are met:
+//
+// 1. All redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. All redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the names "PixInsight" and "Pleiades Astrophoto", nor the names
+//    of their contributors, may be used to endorse or promote products derived
+//    from this software without specific prior written permission. For written
+//    permission, please contact info@pixinsight.com.
+//
+// 4. All products derived from this software, in any form whatsoever, must
+//    reproduce the following acknowledgment in the end-user documentation
+//    and/or other materials provided with the product:
+//
+//    "This product is based on software from the PixInsight project, developed
+//    by Pleiades Astrophoto and its contributors (http://pixinsight.com/)."
+//
+//    Alternatively, if that is where third-party acknowledgments normally
+//    appear, this acknowledgment must be reproduced in the product itself.
+//
+// THIS SOFTWARE IS PROVIDED BY PLEIADES ASTROPHOTO AND ITS CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL PLEIADES ASTROPHOTO OR ITS
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, BUSINESS
+// INTERRUPTION; PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; AND LOSS OF USE,
+// DATA OR PROFITS) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// ----------------------------------------------------------------------------
+
+
+#ifndef __CFA2RGBAccumulator_h
+#define __CFA2RGBAccumulator_h
+
+#include <pcl/Array.h>
+#include <pcl/Image.h>
+#include <pcl/ImageVariant.h>
+
+namespace pcl
+{
+
+class CFA2RGBCoverageMap;
+
+// ----------------------------------------------------------------------------
+
+/*
+ * Running per-pixel statistics of a sequence of converted frames.
+ *
+ * Keeps the running mean, sum of squared deviations from the mean and
+ * sample count of each channel in double precision, with samples normalized
+ * to [0,1]. Both are updated with Welford's method, so the variance of
+ * nearly constant pixels does not cancel out. Frames are accumulated by row
+ * bands, one band per processor thread, so no two threads ever touch the
+ * same accumulator elements.
+ */
+class CFA2RGBAccumulator
+{
+public:
+
+   CFA2RGBAccumulator();
+
+   /*
+    * Adds a converted RGB frame. If a coverage map is specified, only the
+    * pixels covered by each channel are accumulated, so that the empty sites
+    * of sparse RGB planes do not bias the statistics. Throws an Error if the
+    * frame geometry differs from that of the first accumulated frame.
+    * maxThreads limits the number of threads used, zero meaning all
+    * processors, as in CFA2RGBEngine::SetMaxThreads().
+    */
+   void Add( const ImageVariant& rgb, const CFA2RGBCoverageMap* coverage = 0, int maxThreads = 0 );
+
+   /*
+    * Number of accumulated frames.
+    */
+   int Count() const
+   {
+      return m_frames;
+   }
+
+   int Width() const
+   {
+      return m_width;
+   }
+
+   int Height() const
+   {
+      return m_height;
+   }
+
+   /*
+    * Generates the mean and standard deviation images. Pixels without
+    * samples are zero in both; sigma is zero where fewer than two samples
+    * have been accumulated.
+    */
+   void GetResults( Image& mean, Image& sigma ) const;
+
+private:
+
+   int              m_width;
+   int              m_height;
+   int              m_frames;
+   Array<double>    m_mean[ 3 ];
+   Array<double>    m_m2[ 3 ];    // sum of squared deviations from the mean
+   Array<uint32>    m_count[ 3 ];
+
+   template <class P> friend class CFA2RGBAccumulatorThread;
+};
+
+// ----------------------------------------------------------------------------
+
+} // pcl
+
+#endif   // __CFA2RGBAccumulator_h
+
+// ****************************************************************************
+// EOF CFA2RGBAccumulator.h - Released 2016/02/03 00:00:00 UTC
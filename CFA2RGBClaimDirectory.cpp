@@ -0,0 +1,320 @@
+//     ____   ______ __
+//    / __ \ / ____// /
+//   / /_/ // /    / /
+//  / ____// /___ / /___   PixInsight Class Library
+// /_/     \____//_____/   PCL 02.01.00.0779
+// ----------------------------------------------------------------------------
+// Standard CFA2RGB Process Module Version 01.01.01.0010
+// ----------------------------------------------------------------------------
+// CFA2RGBClaimDirectory.cpp - Released 2016/02/03 00:00:00 UTC
+// ----------------------------------------------------------------------------
+// This file is part of the standard CFA2RGB PixInsight module.
+//
+// Copyright (c) 2003-2016 Pleiades Astrophoto S.L. All Rights Reserved.
+//
+// Redistribution and use in both source and binary forms, with or without
+// modification, is permitted provided that the following conditions are met:
+//
+// 1. All redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. All redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the names "PixInsight" and "Pleiades Astrophoto", nor the names
+//    of their contributors, may be used to endorse or promote products derived
+//    from this software without specific prior written permission. For written
+//    permission, please contact info@pixinsight.com.
+//
+// 4. All products derived from this software, in any form whatsoever, must
+//    reproduce the following acknowledgment in the end-user documentation
+//    and/or other materials provided with the product:
+//
+//    "This product is based on software from the PixInsight project, developed
+//    by Pleiades Astrophoto and its contributors (http://pixinsight.com/)."
+//
+//    Alternatively, if that is where third-party acknowledgments normally
+//    appear, this acknowledgment must be reproduced in the product itself.
+//
+// THIS SOFTWARE IS PROVIDED BY PLEIADES ASTROPHOTO AND ITS CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL PLEIADES ASTROPHOTO OR ITS
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, BUSINESS
+// INTERRUPTION; PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; AND LOSS OF USE,
+// DATA OR PROFITS) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// ----------------------------------------------------------------------------
+
+
+#include "CFA2RGBClaimDirectory.h"
+#include "CFA2RGBFileCache.h"
+
+#include <pcl/Exception.h>
+#include <pcl/File.h>
+
+#ifdef __PCL_WINDOWS
+#  include <windows.h>
+#else
+#  include <errno.h>
+#  include <stdio.h>
+#  include <fcntl.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+namespace pcl
+{
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBClaimDirectory::CFA2RGBClaimDirectory( const String& directory, int timeout, const String& workerId ) :
+m_directory( directory ), m_timeout( Max( 1, timeout ) ), m_workerId( workerId.IsEmpty() ? DefaultWorkerId() : workerId )
+{
+   IsoString id = m_workerId.ToUTF8();
+   m_tag = CFA2RGBFileCache::Hash( id.Begin(), id.Length() ).Left( 12 );
+
+   if ( !m_directory.EndsWith( '/' ) )
+      m_directory += '/';
+   if ( !File::DirectoryExists( m_directory ) )
+      throw Error( "CFA2RGB: The claim directory does not exist: " + directory );
+}
+
+CFA2RGBClaimDirectory::~CFA2RGBClaimDirectory()
+{
+   try
+   {
+      String clockPath = m_directory + m_tag + ".clock";
+      if ( File::Exists( clockPath ) )
+         File::Remove( clockPath );
+   }
+   catch ( ... )
+   {
+   }
+}
+
+/*
+ * An abandoned claim is first renamed to a name unique to this worker.
+ * Renaming is atomic, so when several workers find the same stale claim
+ * only one of them removes it; all of them then compete again for the
+ * exclusive creation of a new claim.
+ */
+bool CFA2RGBClaimDirectory::Claim( const String& inputPath )
+{
+   const String claimPath = FilePath( inputPath, ".claim" );
+   const IsoString contents = ClaimContents( inputPath );
+
+   for ( int attempt = 0; attempt < 2; ++attempt )
+   {
+      if ( IsDone( inputPath ) )
+         return false;
+      if ( CreateExclusive( claimPath, contents ) )
+         return true;
+
+      double age = Age( claimPath );
+      if ( age >= 0 && age < m_timeout )
+         return false;
+
+      if ( age >= 0 )
+      {
+         String stalePath = claimPath + '.' + m_tag + ".stale";
+         try
+         {
+            File::Move( claimPath, stalePath );
+
+            /*
+             * Another worker may have replaced the stale claim since we
+             * checked it. Give a live claim back unless it has been claimed
+             * again in the meantime.
+             */
+            if ( Age( stalePath ) < m_timeout && !File::Exists( claimPath ) )
+            {
+               File::Move( stalePath, claimPath );
+               return false;
+            }
+            File::Remove( stalePath );
+         }
+         catch ( ... )
+         {
+            // Taken over by another worker.
+         }
+      }
+   }
+   return false;
+}
+
+/*
+ * The claim is rewritten through a temporary file renamed over it, so other
+ * workers never see a claim file truncated or partially written.
+ */
+bool CFA2RGBClaimDirectory::Refresh( const String& inputPath )
+{
+   String claimPath = FilePath( inputPath, ".claim" );
+   if ( !IsOwnClaim( claimPath ) )
+      return false;
+   String tmpPath = claimPath + '.' + m_tag + ".tmp";
+   File::WriteTextFile( tmpPath, ClaimContents( inputPath ) );
+   Replace( tmpPath, claimPath );
+   return true;
+}
+
+/*
+ * The done file is written before the claim is removed, so an input file is
+ * never seen as both unclaimed and not done once it has been converted.
+ */
+void CFA2RGBClaimDirectory::Complete( const String& inputPath, const String& outputPath )
+{
+   File::WriteTextFile( FilePath( inputPath, ".done" ), (m_workerId + '\n' + inputPath + '\n' + outputPath + '\n').ToUTF8() );
+   Release( inputPath );
+}
+
+void CFA2RGBClaimDirectory::Release( const String& inputPath )
+{
+   String claimPath = FilePath( inputPath, ".claim" );
+   if ( IsOwnClaim( claimPath ) )
+      File::Remove( claimPath );
+}
+
+bool CFA2RGBClaimDirectory::IsDone( const String& inputPath ) const
+{
+   return File::Exists( FilePath( inputPath, ".done" ) );
+}
+
+String CFA2RGBClaimDirectory::DefaultWorkerId()
+{
+#ifdef __PCL_WINDOWS
+   wchar_t name[ MAX_COMPUTERNAME_LENGTH+1 ];
+   DWORD length = MAX_COMPUTERNAME_LENGTH+1;
+   String host = GetComputerNameW( name, &length ) ? String( reinterpret_cast<const char16_type*>( name ) ) : String( "localhost" );
+   return host + String().Format( ":%u", unsigned( GetCurrentProcessId() ) );
+#else
+   char name[ 256 ];
+   String host = (gethostname( name, sizeof( name ) ) == 0) ? String( IsoString( name ) ) : String( "localhost" );
+   return host + String().Format( ":%d", int( getpid() ) );
+#endif
+}
+
+String CFA2RGBClaimDirectory::FilePath( const String& inputPath, const char* suffix ) const
+{
+   IsoString path = inputPath.ToUTF8();
+   return m_directory + CFA2RGBFileCache::Hash( path.Begin(), path.Length() ) + suffix;
+}
+
+IsoString CFA2RGBClaimDirectory::ClaimContents( const String& inputPath ) const
+{
+   return (m_workerId + '\n' + inputPath + '\n').ToUTF8();
+}
+
+/*
+ * The first line of a claim file identifies the worker holding it.
+ */
+bool CFA2RGBClaimDirectory::IsOwnClaim( const String& claimPath ) const
+{
+   try
+   {
+      if ( !File::Exists( claimPath ) )
+         return false;
+      return File::ReadTextFile( claimPath ).StartsWith( (m_workerId + '\n').ToUTF8().c_str() );
+   }
+   catch ( ... )
+   {
+      // Removed or replaced by another worker.
+      return false;
+   }
+}
+
+/*
+ * Seconds since the last modification of a file, or -1 if it does not exist.
+ * The current time is the modification time of the clock file, which is set
+ * by the file system, as is that of the claim, when the file is written.
+ */
+double CFA2RGBClaimDirectory::Age( const String& filePath ) const
+{
+   double t0 = ModificationTime( filePath );
+   if ( t0 < 0 )
+      return -1;
+   String clockPath = m_directory + m_tag + ".clock";
+   File::WriteTextFile( clockPath, (m_workerId + '\n').ToUTF8() );
+   double t1 = ModificationTime( clockPath );
+   if ( t1 < 0 )
+      throw Error( "CFA2RGB: Unable to access the claim directory clock file: " + clockPath );
+   return Max( 0.0, t1 - t0 );
+}
+
+bool CFA2RGBClaimDirectory::CreateExclusive( const String& filePath, const IsoString& contents )
+{
+#ifdef __PCL_WINDOWS
+   HANDLE h = CreateFileW( reinterpret_cast<LPCWSTR>( filePath.c_str() ), GENERIC_WRITE, 0, 0,
+                           CREATE_NEW, FILE_ATTRIBUTE_NORMAL, 0 );
+   if ( h == INVALID_HANDLE_VALUE )
+   {
+      if ( GetLastError() == ERROR_FILE_EXISTS )
+         return false;
+      throw Error( "CFA2RGB: Unable to create claim file: " + filePath );
+   }
+   DWORD written = 0;
+   WriteFile( h, contents.Begin(), DWORD( contents.Length() ), &written, 0 );
+   CloseHandle( h );
+#else
+   int fd = open( filePath.ToUTF8().c_str(), O_WRONLY|O_CREAT|O_EXCL, 0644 );
+   if ( fd < 0 )
+   {
+      if ( errno == EEXIST )
+         return false;
+      throw Error( "CFA2RGB: Unable to create claim file: " + filePath );
+   }
+   if ( write( fd, contents.Begin(), contents.Length() ) < 0 )
+   {
+      // The claim is valid even if its informative contents are missing.
+   }
+   close( fd );
+#endif
+   return true;
+}
+
+/*
+ * Renames a file over an existing one in a single step.
+ */
+void CFA2RGBClaimDirectory::Replace( const String& filePath, const String& newFilePath )
+{
+#ifdef __PCL_WINDOWS
+   bool ok = MoveFileExW( reinterpret_cast<LPCWSTR>( filePath.c_str() ), reinterpret_cast<LPCWSTR>( newFilePath.c_str() ),
+                          MOVEFILE_REPLACE_EXISTING ) != 0;
+#else
+   bool ok = rename( filePath.ToUTF8().c_str(), newFilePath.ToUTF8().c_str() ) == 0;
+#endif
+   if ( !ok )
+      throw Error( "CFA2RGB: Unable to replace claim file: " + newFilePath );
+}
+
+/*
+ * Modification time of a file in seconds, or -1 if it does not exist.
+ */
+double CFA2RGBClaimDirectory::ModificationTime( const String& filePath )
+{
+#ifdef __PCL_WINDOWS
+   WIN32_FILE_ATTRIBUTE_DATA data;
+   if ( !GetFileAttributesExW( reinterpret_cast<LPCWSTR>( filePath.c_str() ), GetFileExInfoStandard, &data ) )
+      return -1;
+   ULARGE_INTEGER t;
+   t.LowPart = data.ftLastWriteTime.dwLowDateTime;
+   t.HighPart = data.ftLastWriteTime.dwHighDateTime;
+   return double( t.QuadPart )*1.0e-7; // 100 ns units
+#else
+   struct stat s;
+   if ( stat( filePath.ToUTF8().c_str(), &s ) != 0 )
+      return -1;
+   return double( s.st_mtime );
+#endif
+}
+
+// ----------------------------------------------------------------------------
+
+} // pcl
+
+// ****************************************************************************
+// EOF CFA2RGBClaimDirectory.cpp - Released 2016/02/03 00:00:00 UTC
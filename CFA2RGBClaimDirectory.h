@@ -0,0 +1,154 @@
+//     ____   ______ __
+//    / __ \ / ____// /
+//   / /_/ // /    / /
+//  / ____// /___ / /___   PixInsight Class Library
+// /_/     \____//_____/   PCL 02.01.00.0779
+// ----------------------------------------------------------------------------
+// Standard CFA2RGB Process Module Version 01.01.01.0010
+// ----------------------------------------------------------------------------
+// CFA2RGBClaimDirectory.h - Released 2016/02/03 00:00:00 UTC
+// ----------------------------------------------------------------------------
+// This file is part of the standard CFA2RGB PixInsight module.
+//
+// Copyright (c) 2003-2016 Pleiades Astrophoto S.L. All Rights Reserved.
+//
+// Redistribution and use in both source and binary forms, with or without
+// modification, is permitted provided that the following conditions are met:
+//
+// 1. All redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. All redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the names "PixInsight" and "Pleiades Astrophoto", nor the names
+//    of their contributors, may be used to endorse or promote products derived
+//    from this software without specific prior written permission. For written
+//    permission, please contact info@pixinsight.com.
+//
+// 4. All products derived from this software, in any form whatsoever, must
+//    reproduce the following acknowledgment in the end-user documentation
+//    and/or other materials provided with the product:
+//
+//    "This product is based on software from the PixInsight project, developed
+//    by Pleiades Astrophoto and its contributors (http://pixinsight.com/)."
+//
+//    Alternatively, if that is where third-party acknowledgments normally
+//    appear, this acknowledgment must be reproduced in the product itself.
+//
+// THIS SOFTWARE IS PROVIDED BY PLEIADES ASTROPHOTO AND ITS CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL PLEIADES ASTROPHOTO OR ITS
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, BUSINESS
+// INTERRUPTION; PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; AND LOSS OF USE,
+// DATA OR PROFITS) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// ----------------------------------------------------------------------------
+
+
+#ifndef __CFA2RGBClaimDirectory_h
+#define __CFA2RGBClaimDirectory_h
+
+#include <pcl/String.h>
+
+namespace pcl
+{
+
+// ----------------------------------------------------------------------------
+
+/*
+ * Shared directory through which several processes, possibly running on
+ * different nodes of a cluster with a common file system, split a batch of
+ * target frames without a scheduler.
+ *
+ * A worker claims a frame by creating its claim file exclusively, so each
+ * frame is converted by a single worker, and records completion with a done
+ * file when the output file has been written. Files are named after the
+ * SHA-1 hash of the full input path, which must be the same on all nodes.
+ *
+ * A claim older than the timeout is considered abandoned by a dead worker
+ * and can be taken over. Workers refresh their claims as they progress, but
+ * the timeout must exceed the time needed to convert and write one frame.
+ * Ages are measured against the clock of the file system, by comparing
+ * modification times with that of a file written by the worker, so clock
+ * skew between nodes cannot expire live claims.
+ */
+class CFA2RGBClaimDirectory
+{
+public:
+
+   /*
+    * timeout is the age of a claim, in seconds, after which it is reclaimed.
+    */
+   CFA2RGBClaimDirectory( const String& directory, int timeout, const String& workerId = String() );
+
+   /*
+    * Removes the clock file of this worker.
+    */
+   ~CFA2RGBClaimDirectory();
+
+   const String& WorkerId() const
+   {
+      return m_workerId;
+   }
+
+   /*
+    * Claims an input file for this worker. Returns false if it has been
+    * completed or is being converted by another worker.
+    */
+   bool Claim( const String& inputPath );
+
+   /*
+    * Updates the time stamp of a claim held by this worker. Returns false if
+    * the claim has been taken over by another worker.
+    */
+   bool Refresh( const String& inputPath );
+
+   /*
+    * Records a claimed input file as converted and releases its claim.
+    */
+   void Complete( const String& inputPath, const String& outputPath );
+
+   /*
+    * Releases a claim without completing it, so that another worker can
+    * retry the input file. Claims taken over by another worker are left alone.
+    */
+   void Release( const String& inputPath );
+
+   bool IsDone( const String& inputPath ) const;
+
+   /*
+    * Host name and process identifier of the calling process.
+    */
+   static String DefaultWorkerId();
+
+private:
+
+   String m_directory;
+   int    m_timeout;
+   String m_workerId;
+   String m_tag;      // file name safe worker identifier
+
+   String FilePath( const String& inputPath, const char* suffix ) const;
+   IsoString ClaimContents( const String& inputPath ) const;
+   bool IsOwnClaim( const String& claimPath ) const;
+   double Age( const String& filePath ) const;
+
+   static bool CreateExclusive( const String& filePath, const IsoString& contents );
+   static void Replace( const String& filePath, const String& newFilePath );
+   static double ModificationTime( const String& filePath );
+};
+
+// ----------------------------------------------------------------------------
+
+} // pcl
+
+#endif   // __CFA2RGBClaimDirectory_h
+
+// ****************************************************************************
+// EOF CFA2RGBClaimDirectory.h - Released 2016/02/03 00:00:00 UTC
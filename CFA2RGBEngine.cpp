@@ -0,0 +1,1892 @@
+//     ____   ______ __
+//    / __ \ / ____// /
+//   / /_/ // /    / /
+//  / ____// /___ / /___   PixInsight Class Library
+// /_/     \____//_____/   PCL 02.01.00.0779
+// ----------------------------------------------------------------------------
+// Standard CFA2RGB Process Module Version 01.01.01.0010
+// ----------------------------------------------------------------------------
+// CFA2RGBEngine.cpp - Released 2016/02/03 00:00:00 UTC
+// ----------------------------------------------------------------------------
+// This file is part of the standard CFA2RGB PixInsight module.
+//
+// Copyright (c) 2003-2016 Pleiades Astrophoto S.L. All Rights Reserved.
+//
+// Redistribution and use in both source and binary forms, with or without
+// modification, is permitted provided that the following conditions are met:
+//
+// 1. All redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. All redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the names "PixInsight" and "Pleiades Astrophoto", nor the names
+//    of their contributors, may be used to endorse or promote products derived
+//    from this software without specific prior written permission. For written
+//    permission, please contact info@pixinsight.com.
+//
+// 4. All products derived from this software, in any form whatsoever, must
+//    reproduce the following acknowledgment in the end-user documentation
+//    and/or other materials provided with the product:
+//
+//    "This product is based on software from the PixInsight project, developed
+//    by Pleiades Astrophoto and its contributors (http://pixinsight.com/)."
+//
+//    Alternatively, if that is where third-party acknowledgments normally
+//    appear, this acknowledgment must be reproduced in the product itself.
+//
+// THIS SOFTWARE IS PROVIDED BY PLEIADES ASTROPHOTO AND ITS CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL PLEIADES ASTROPHOTO OR ITS
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, BUSINESS
+// INTERRUPTION; PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; AND LOSS OF USE,
+// DATA OR PROFITS) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// ----------------------------------------------------------------------------
+
+
+#include "CFA2RGBEngine.h"
+#include "CFA2RGBInstance.h"
+#include "CFA2RGBParameters.h"
+#include "CFA2RGBPattern.h"
+#include "CFA2RGBProgress.h"
+#include "CFA2RGBWorkerPool.h"
+
+#include <pcl/Exception.h>
+#include <pcl/ReferenceArray.h>
+#include <pcl/Thread.h>
+#include <pcl/Vector.h>
+
+#include <string.h>
+
+/*
+ * Non-temporal stores and software prefetch require SSE2, which every x64
+ * processor provides.
+ */
+#if defined( __SSE2__ ) || defined( _M_X64 )
+# define __CFA2RGB_STREAMING_STORES
+# include <emmintrin.h>
+#endif
+
+namespace pcl
+{
+
+// ----------------------------------------------------------------------------
+
+/*
+ * Side of the square tiles used to localize incremental updates. A multiple
+ * of every supported pattern period.
+ */
+static const int s_tileSize = 192;
+
+static int AlignDown( int v, int p )
+{
+   return v - ((v % p) + p) % p;
+}
+
+static int AlignUp( int v, int p )
+{
+   return AlignDown( v + p - 1, p );
+}
+
+// ----------------------------------------------------------------------------
+
+/*
+ * Expands columns [x0,x1) of a row for one output channel. phase is the
+ * mosaic column of row element 0 and mask the lane mask of the channel on
+ * this row. Blocks aligned to the mosaic are processed with a fixed-length
+ * inner loop that compilers turn into vector blends.
+ */
+template <typename T>
+static void ExpandRow( T* f, const T* s, int x0, int x1, int phase, const uint8* mask )
+{
+   const int L = CFA2RGBPattern::LaneCount;
+   int x = x0;
+   for ( int k = (x + phase) % L; k != 0 && x < x1; ++x, k = (k + 1) % L )
+      f[x] = mask[k] ? s[x] : T( 0 );
+   for ( ; x + L <= x1; x += L )
+      for ( int i = 0; i < L; ++i )
+         f[x+i] = mask[i] ? s[x+i] : T( 0 );
+   for ( int i = 0; x < x1; ++x, ++i )
+      f[x] = mask[i] ? s[x] : T( 0 );
+}
+
+/*
+ * Outputs larger than this many bytes are expanded with non-temporal stores.
+ * It is well above the last-level cache of current processors: smaller
+ * outputs are better left in the cache, where the next process, the screen
+ * renderer or the pyramid generator will find them.
+ */
+static const size_type s_streamingThreshold = size_type( 64 ) << 20;
+
+/*
+ * Distance in bytes at which source rows are prefetched ahead of a streamed
+ * expansion: eight cache lines, enough to cover memory latency at the rate
+ * rows are expanded.
+ */
+static const int s_prefetchDistance = 512;
+
+template <class P>
+static bool IsStreamingOutput( const GenericImage<P>& rgb )
+{
+   return rgb.ImageSize() > s_streamingThreshold;
+}
+
+#ifdef __CFA2RGB_STREAMING_STORES
+
+/*
+ * ExpandRow() with non-temporal stores. Output lines are written in full
+ * 16-byte chunks, so they are neither read for ownership nor left in the
+ * cache, where they would evict the source lines. Each source line is
+ * prefetched s_prefetchDistance bytes ahead.
+ */
+template <typename T>
+static void StreamRow( T* f, const T* s, int x0, int x1, int phase, const uint8* mask )
+{
+   const int L = CFA2RGBPattern::LaneCount;
+   const int N = int( 16/sizeof( T ) );
+
+   // Two copies of the lane mask, so that the N lanes of a chunk never wrap.
+   uint8 lanes[ 2*L ];
+   for ( int i = 0; i < L; ++i )
+      lanes[i] = lanes[i+L] = mask[i];
+
+   int x = x0;
+   int k = (x + phase) % L;
+   for ( ; x < x1 && (reinterpret_cast<uintptr_t>( f + x ) & 15) != 0; ++x, k = (k + 1 < L) ? k + 1 : 0 )
+      f[x] = lanes[k] ? s[x] : T( 0 );
+
+   for ( ; x + N <= x1; x += N )
+   {
+      if ( (reinterpret_cast<uintptr_t>( s + x ) & 63) < 16 )
+         _mm_prefetch( reinterpret_cast<const char*>( s + x ) + s_prefetchDistance, _MM_HINT_NTA );
+      alignas( 16 ) T v[ N ];
+      for ( int i = 0; i < N; ++i )
+         v[i] = lanes[k+i] ? s[x+i] : T( 0 );
+      _mm_stream_si128( reinterpret_cast<__m128i*>( f + x ), _mm_load_si128( reinterpret_cast<const __m128i*>( v ) ) );
+      if ( (k += N) >= L )
+         k -= L;
+   }
+
+   for ( ; x < x1; ++x, k = (k + 1 < L) ? k + 1 : 0 )
+      f[x] = lanes[k] ? s[x] : T( 0 );
+
+   // Streaming stores are weakly ordered: make them visible to other threads.
+   _mm_sfence();
+}
+
+#endif   // __CFA2RGB_STREAMING_STORES
+
+template <typename T>
+static void ExpandRow( T* f, const T* s, int x0, int x1, int phase, const uint8* mask, bool streaming )
+{
+#ifdef __CFA2RGB_STREAMING_STORES
+   if ( streaming )
+   {
+      StreamRow( f, s, x0, x1, phase, mask );
+      return;
+   }
+#endif
+   ExpandRow( f, s, x0, x1, phase, mask );
+}
+
+/*
+ * Writes the coverage bits of columns [x0,x1) of a row for one channel.
+ */
+static void CoverRow( uint8* bits, int x0, int x1, int phase, const uint8* mask )
+{
+   const int L = CFA2RGBPattern::LaneCount;
+   for ( int x = x0, k = (x0 + phase) % L; x < x1; ++x, k = (k + 1) % L )
+      if ( mask[k] )
+         bits[x >> 3] |= uint8( 1 << (x & 7) );
+      else
+         bits[x >> 3] &= uint8( ~(1 << (x & 7)) );
+}
+
+/*
+ * Generates the pyramid rows that depend on rows [y0,y1) of a converted
+ * image, y0 being a multiple of the pyramid row alignment. Conversion
+ * threads call this right after converting each group of aligned rows, while
+ * they are still in the cache; coarser levels read the rows just generated
+ * for the finer ones. dense is true for interpolated images, where every
+ * pixel of a cell has a value in each channel.
+ */
+template <class P>
+static void BuildPyramid( CFA2RGBPyramid& pyramid, const GenericImage<P>& rgb, const CFA2RGBPattern& pattern,
+                          bool dense, int y0, int y1 )
+{
+   const int n = pattern.Period();
+   int counts[ 3 ] = { 0, 0, 0 };
+   for ( int y = 0; y < n; ++y )
+      for ( int x = 0; x < n; ++x )
+         if ( dense )
+            for ( int c = 0; c < 3; ++c )
+               ++counts[c];
+         else
+            ++counts[pattern.Channel( x, y )];
+
+   Image& L0 = pyramid.Level( 0 );
+   for ( int j = y0/n, j1 = Min( y1/n, L0.Height() ); j < j1; ++j )
+      for ( int c = 0; c < 3; ++c )
+      {
+         float* f = L0.ScanLine( j, c );
+         for ( int x = 0; x < L0.Width(); ++x )
+            f[x] = 0;
+         for ( int dy = 0; dy < n; ++dy )
+         {
+            const typename P::sample* s = rgb.ScanLine( j*n + dy, c );
+            for ( int x = 0; x < L0.Width(); ++x, s += n )
+            {
+               double v = 0;
+               for ( int dx = 0; dx < n; ++dx )
+                  v += s[dx];
+               f[x] += float( v );
+            }
+         }
+         const float scale = float( 1/(counts[c]*double( P::MaxSampleValue() )) );
+         for ( int x = 0; x < L0.Width(); ++x )
+            f[x] *= scale;
+      }
+
+   for ( int k = 1; k < pyramid.NumberOfLevels(); ++k )
+   {
+      const Image& A = pyramid.Level( k-1 );
+      Image& B = pyramid.Level( k );
+      const int m = n << k;
+      for ( int j = y0/m, j1 = Min( y1/m, B.Height() ); j < j1; ++j )
+         for ( int c = 0; c < 3; ++c )
+         {
+            const float* a0 = A.ScanLine( 2*j, c );
+            const float* a1 = A.ScanLine( 2*j + 1, c );
+            float* b = B.ScanLine( j, c );
+            for ( int x = 0; x < B.Width(); ++x, a0 += 2, a1 += 2 )
+               b[x] = 0.25F*(a0[0] + a0[1] + a1[0] + a1[1]);
+         }
+   }
+}
+
+/*
+ * Tracks the groups of aligned rows completed by a conversion thread and
+ * generates their pyramid rows.
+ */
+template <class P>
+class PyramidFeed
+{
+public:
+
+   PyramidFeed( CFA2RGBPyramid* pyramid, const GenericImage<P>& rgb, const CFA2RGBPattern& pattern, bool dense = false ) :
+   m_pyramid( pyramid ), m_rgb( rgb ), m_pattern( pattern ), m_dense( dense ),
+   m_align( (pyramid != 0) ? pyramid->RowAlignment( pattern.Period() ) : 1 ), m_start( 0 )
+   {
+   }
+
+   void Start( int y )
+   {
+      m_start = y;
+   }
+
+   /*
+    * Called after row y has been converted; last is true for the last row of
+    * a band.
+    */
+   void RowDone( int y, bool last )
+   {
+      if ( m_pyramid != 0 )
+         if ( (y + 1) % m_align == 0 || last )
+         {
+            BuildPyramid( *m_pyramid, m_rgb, m_pattern, m_dense, m_start, y + 1 );
+            m_start = y + 1;
+         }
+   }
+
+private:
+
+   CFA2RGBPyramid*        m_pyramid;
+   const GenericImage<P>& m_rgb;
+   const CFA2RGBPattern&  m_pattern;
+   bool                   m_dense;
+   int                    m_align;
+   int                    m_start;
+};
+
+template <class P>
+class CFA2RGBThread : public Thread
+{
+public:
+
+   CFA2RGBThread( GenericImage<P>& rgb, const GenericImage<P>& src, bool inPlace,
+                  const Point& offset, const Point& phase, const CFA2RGBPattern& pattern,
+                  CFA2RGBCoverageMap* coverage, CFA2RGBPyramid* pyramid, bool streaming,
+                  const Array<Rect>& rects, size_type start, size_type end ) :
+   Thread(),
+   m_rgb( rgb ), m_src( src ), m_inPlace( inPlace ), m_offset( offset ), m_phase( phase ), m_pattern( pattern ),
+   m_coverage( coverage ), m_pyramid( pyramid ), m_streaming( streaming ), m_rects( rects ), m_start( start ), m_end( end )
+   {
+   }
+
+   virtual void Run()
+   {
+      CFA2RGBProgress::Band progress;
+
+      PyramidFeed<P> feed( m_pyramid, m_rgb, m_pattern );
+      for ( size_type i = m_start; i < m_end; ++i )
+      {
+         const Rect& r = m_rects[i];
+         feed.Start( r.y0 );
+         for ( int y = r.y0; y < r.y1; ++y )
+         {
+            for ( int c = 0; c < 3; ++c )
+            {
+               const uint8* mask = m_pattern.LaneMask( y + m_phase.y, c );
+               ExpandRow( m_rgb.ScanLine( y, c ), m_src.ScanLine( y + m_offset.y, m_inPlace ? c : 0 ) + m_offset.x,
+                          r.x0, r.x1, m_phase.x, mask, m_streaming );
+               if ( m_coverage != 0 )
+                  CoverRow( m_coverage->Row( y, c ), r.x0, r.x1, m_phase.x, mask );
+            }
+            feed.RowDone( y, y + 1 == r.y1 );
+            if ( !progress.Row() )
+               return;
+         }
+      }
+   }
+
+private:
+
+   GenericImage<P>&       m_rgb;
+   const GenericImage<P>& m_src;
+   bool                   m_inPlace;
+   Point                  m_offset; // position of the target origin in the source image
+   Point                  m_phase;  // position of the target origin in the CFA mosaic
+   const CFA2RGBPattern&  m_pattern;
+   CFA2RGBCoverageMap*    m_coverage;
+   CFA2RGBPyramid*        m_pyramid; // requires full-width rectangles aligned to the pyramid
+   bool                   m_streaming;
+   const Array<Rect>&     m_rects;
+   size_type              m_start;
+   size_type              m_end;
+};
+
+/*
+ * Number of threads available to a conversion limited to maxThreads threads,
+ * zero meaning all processors.
+ */
+static int ThreadCount( int count, int overheadLimit, int maxThreads )
+{
+   int n = Thread::NumberOfThreads( count, overheadLimit );
+   return (maxThreads > 0) ? Min( n, maxThreads ) : n;
+}
+
+/*
+ * Kernel threads are never started: they are run by the persistent workers
+ * of the module, which are bound to processors. Concurrent conversions
+ * share the same workers. A monitored conversion always goes through the
+ * pool, so that the calling thread is free to poll its progress.
+ */
+template <class T>
+static void RunThreads( ReferenceArray<T>& threads )
+{
+   CFA2RGBProgress* progress = CFA2RGBProgress::Current();
+   if ( threads.Length() > 1 || progress != 0 )
+   {
+      Array<Thread*> tasks;
+      for ( size_type i = 0; i < threads.Length(); ++i )
+         tasks.Add( &threads[i] );
+      try
+      {
+         CFA2RGBWorkerPool::Shared().Run( tasks, progress );
+      }
+      catch ( ... )
+      {
+         threads.Destroy();
+         throw;
+      }
+   }
+   else
+      threads[0].Run();
+
+   threads.Destroy();
+}
+
+/*
+ * Expands the specified list of disjoint rectangles, distributing them
+ * among the available processor threads.
+ */
+template <class P>
+static void Expand( GenericImage<P>& rgb, const GenericImage<P>& src, bool inPlace,
+                    const Point& offset, const Point& phase, const CFA2RGBPattern& pattern,
+                    CFA2RGBCoverageMap* coverage, CFA2RGBPyramid* pyramid, const Array<Rect>& rects, int maxThreads )
+{
+   if ( rects.IsEmpty() )
+      return;
+
+   /*
+    * Non-temporal stores only save memory traffic when the output lines are
+    * not read: a streamed line needs no read for ownership and does not
+    * evict source lines. In-place expansions rewrite each line just after
+    * reading it, so the line is already in the cache and streaming it would
+    * save nothing. This holds for every channel, since the CFA plane is
+    * copied to the other channels before the expansion. Pyramid levels are
+    * generated from rows just converted, so they need the output in the
+    * cache as well.
+    */
+   const bool streaming = !inPlace && pyramid == 0 && IsStreamingOutput( rgb );
+
+   const int numberOfThreads = ThreadCount( rects.Length(), 1, maxThreads );
+   const size_type rectsPerThread = rects.Length()/numberOfThreads;
+
+   ReferenceArray<CFA2RGBThread<P> > threads;
+   for ( int i = 0, j = 1; i < numberOfThreads; ++i, ++j )
+      threads.Add( new CFA2RGBThread<P>( rgb, src, inPlace, offset, phase, pattern, coverage, pyramid, streaming, rects,
+                                         i*rectsPerThread, (j < numberOfThreads) ? j*rectsPerThread : rects.Length() ) );
+   RunThreads( threads );
+}
+
+/*
+ * Splits a rectangle into horizontal bands, one per processor thread. Band
+ * boundaries are multiples of align rows from the top of the rectangle.
+ */
+static Array<Rect> Bands( const Rect& r, int maxThreads, int align = 1 )
+{
+   const int groups = Max( 1, r.Height()/align );
+   const int numberOfThreads = ThreadCount( groups, Max( 1, 16/align ), maxThreads );
+   const int rowsPerThread = groups/numberOfThreads*align;
+   Array<Rect> bands;
+   for ( int i = 0, j = 1; i < numberOfThreads; ++i, ++j )
+      bands.Add( Rect( r.x0, r.y0 + i*rowsPerThread, r.x1, (j < numberOfThreads) ? r.y0 + j*rowsPerThread : r.y1 ) );
+   return bands;
+}
+
+// ----------------------------------------------------------------------------
+
+template <class P>
+static typename P::sample BlockMean( double sum, int count )
+{
+   double mean = sum/count;
+   return typename P::sample( P::IsFloatSample() ? mean : mean + 0.5 );
+}
+
+/*
+ * Block binning of quad-Bayer and nonacell mosaics. Each block of same-color
+ * pixels is averaged into one sample of a Bayer-sampled row, which is then
+ * expanded into the three output channels.
+ */
+template <class P>
+class CFA2RGBBinThread : public Thread
+{
+public:
+
+   CFA2RGBBinThread( GenericImage<P>& rgb, const GenericImage<P>& src, const Point& start, const Point& phase,
+                     const CFA2RGBPattern& binned, int blockSize, CFA2RGBCoverageMap* coverage,
+                     CFA2RGBPyramid* pyramid, const Rect& band ) :
+   Thread(),
+   m_rgb( rgb ), m_src( src ), m_start( start ), m_phase( phase ), m_binned( binned ), m_blockSize( blockSize ),
+   m_coverage( coverage ), m_pyramid( pyramid ), m_band( band )
+   {
+   }
+
+   virtual void Run()
+   {
+      CFA2RGBProgress::Band progress;
+
+      const int width = m_rgb.Width();
+      const int n = m_blockSize;
+      DVector sum( width );
+      GenericVector<typename P::sample> row( width );
+      PyramidFeed<P> feed( m_pyramid, m_rgb, m_binned );
+      feed.Start( m_band.y0 );
+
+      for ( int y = m_band.y0; y < m_band.y1; ++y )
+      {
+         for ( int x = 0; x < width; ++x )
+            sum[x] = 0;
+         for ( int j = 0; j < n; ++j )
+         {
+            const typename P::sample* s = m_src.ScanLine( m_start.y + y*n + j ) + m_start.x;
+            for ( int x = 0; x < width; ++x, s += n )
+            {
+               double v = 0;
+               for ( int i = 0; i < n; ++i )
+                  v += s[i];
+               sum[x] += v;
+            }
+         }
+         for ( int x = 0; x < width; ++x )
+            row[x] = BlockMean<P>( sum[x], n*n );
+
+         for ( int c = 0; c < 3; ++c )
+         {
+            const uint8* mask = m_binned.LaneMask( y + m_phase.y, c );
+            ExpandRow( m_rgb.ScanLine( y, c ), row.Begin(), 0, width, m_phase.x, mask );
+            if ( m_coverage != 0 )
+               CoverRow( m_coverage->Row( y, c ), 0, width, m_phase.x, mask );
+         }
+         feed.RowDone( y, y + 1 == m_band.y1 );
+         if ( !progress.Row() )
+            return;
+      }
+   }
+
+private:
+
+   GenericImage<P>&       m_rgb;
+   const GenericImage<P>& m_src;
+   Point                  m_start; // source position of the first complete block
+   Point                  m_phase; // position of the target origin in the binned mosaic
+   const CFA2RGBPattern&  m_binned;
+   int                    m_blockSize;
+   CFA2RGBCoverageMap*    m_coverage;
+   CFA2RGBPyramid*        m_pyramid;
+   Rect                   m_band;
+};
+
+/*
+ * Bins the blocks of same-color pixels within a region of the CFA. phase is
+ * the position of the region in the mosaic. Incomplete blocks at the region
+ * boundaries are discarded.
+ */
+template <class P>
+static void Bin( GenericImage<P>& rgb, const GenericImage<P>& cfa, const Rect& roi, const Point& phase,
+                 const CFA2RGBPattern& pattern, CFA2RGBCoverageMap* coverage, CFA2RGBPyramid* pyramid, int maxThreads )
+{
+   const int n = pattern.BlockSize();
+   Point start( roi.x0 + AlignUp( phase.x, n ) - phase.x, roi.y0 + AlignUp( phase.y, n ) - phase.y );
+   int width = (roi.x1 - start.x)/n;
+   int height = (roi.y1 - start.y)/n;
+   if ( width <= 0 || height <= 0 )
+      throw Error( "CFA2RGB: The image is too small for block binning." );
+
+   if ( rgb.Width() != width || rgb.Height() != height || rgb.NumberOfChannels() != 3 )
+      rgb.AllocateData( width, height, 3, ColorSpace::RGB );
+   if ( coverage != 0 )
+      coverage->Allocate( width, height );
+
+   const CFA2RGBPattern& binned = pattern.BinnedPattern();
+   int align = 1;
+   if ( pyramid != 0 )
+   {
+      pyramid->Allocate( width, height, binned.Period() );
+      align = pyramid->RowAlignment( binned.Period() );
+   }
+
+   Point binnedPhase( (phase.x + start.x - roi.x0)/n, (phase.y + start.y - roi.y0)/n );
+   Array<Rect> bands = Bands( rgb.Bounds(), maxThreads, align );
+   ReferenceArray<CFA2RGBBinThread<P> > threads;
+   for ( Array<Rect>::const_iterator i = bands.Begin(); i != bands.End(); ++i )
+      threads.Add( new CFA2RGBBinThread<P>( rgb, cfa, start, binnedPhase, binned, n, coverage, pyramid, *i ) );
+   RunThreads( threads );
+}
+
+// ----------------------------------------------------------------------------
+
+/*
+ * Sums of cell binning. 8-bit and 16-bit samples are summed in 32-bit
+ * integers, which cannot overflow for up to 3x3 cells; other samples are
+ * summed in double precision. Sums saturate at the maximum sample value.
+ */
+template <class P>
+struct CellBinSum
+{
+   typedef double type;
+
+   static typename P::sample Mean( type sum, int count )
+   {
+      return BlockMean<P>( sum, count );
+   }
+
+   static typename P::sample Saturate( type sum )
+   {
+      return typename P::sample( Min( sum, type( P::MaxSampleValue() ) ) );
+   }
+};
+
+template <class P>
+struct IntegerCellBinSum
+{
+   typedef uint32 type;
+
+   static typename P::sample Mean( type sum, int count )
+   {
+      return typename P::sample( (sum + (count >> 1))/count );
+   }
+
+   static typename P::sample Saturate( type sum )
+   {
+      return typename P::sample( Min( sum, type( P::MaxSampleValue() ) ) );
+   }
+};
+
+template <>
+struct CellBinSum<UInt8PixelTraits> : public IntegerCellBinSum<UInt8PixelTraits>
+{
+};
+
+template <>
+struct CellBinSum<UInt16PixelTraits> : public IntegerCellBinSum<UInt16PixelTraits>
+{
+};
+
+/*
+ * Cell binning. Each output row is accumulated from factor source rows of
+ * the same pattern row in a single streaming pass, and then either stored
+ * as a row of the binned CFA mosaic or expanded into the three output
+ * channels.
+ */
+template <class P>
+class CFA2RGBCellBinThread : public Thread
+{
+public:
+
+   typedef typename P::sample                    sample;
+   typedef typename CellBinSum<P>::type          sum_type;
+
+   CFA2RGBCellBinThread( GenericImage<P>& target, const GenericImage<P>& src, const Point& start,
+                         const CFA2RGBPattern& pattern, int factor, bool sum, bool cfaOutput,
+                         CFA2RGBCoverageMap* coverage, CFA2RGBPyramid* pyramid, const Rect& band ) :
+   Thread(),
+   m_target( target ), m_src( src ), m_start( start ), m_pattern( pattern ), m_factor( factor ), m_sum( sum ),
+   m_cfaOutput( cfaOutput ), m_coverage( coverage ), m_pyramid( pyramid ), m_band( band )
+   {
+   }
+
+   virtual void Run()
+   {
+      CFA2RGBProgress::Band progress;
+
+      const int width = m_target.Width();
+      const int p = m_pattern.Period();
+      const int n = m_factor;
+      const int cells = width/p;
+      GenericVector<sum_type> sums( width );
+      GenericVector<sample> row( width );
+      PyramidFeed<P> feed( m_cfaOutput ? 0 : m_pyramid, m_target, m_pattern );
+      feed.Start( m_band.y0 );
+
+      for ( int y = m_band.y0; y < m_band.y1; ++y )
+      {
+         sum_type* t = sums.Begin();
+         for ( int x = 0; x < width; ++x )
+            t[x] = 0;
+
+         const int y0 = m_start.y + (y/p)*n*p + y%p;
+         for ( int j = 0; j < n; ++j )
+         {
+            const sample* s = m_src.ScanLine( y0 + j*p ) + m_start.x;
+            for ( int cell = 0; cell < cells; ++cell, s += n*p )
+               for ( int i = 0; i < n; ++i )
+                  for ( int k = 0; k < p; ++k )
+                     t[cell*p + k] += s[i*p + k];
+         }
+
+         sample* r = m_cfaOutput ? m_target.ScanLine( y ) : row.Begin();
+         if ( m_sum )
+            for ( int x = 0; x < width; ++x )
+               r[x] = CellBinSum<P>::Saturate( t[x] );
+         else
+            for ( int x = 0; x < width; ++x )
+               r[x] = CellBinSum<P>::Mean( t[x], n*n );
+
+         if ( !m_cfaOutput )
+            for ( int c = 0; c < 3; ++c )
+            {
+               const uint8* mask = m_pattern.LaneMask( y, c );
+               ExpandRow( m_target.ScanLine( y, c ), r, 0, width, 0/*phase*/, mask );
+               if ( m_coverage != 0 )
+                  CoverRow( m_coverage->Row( y, c ), 0, width, 0/*phase*/, mask );
+            }
+         feed.RowDone( y, y + 1 == m_band.y1 );
+         if ( !progress.Row() )
+            return;
+      }
+   }
+
+private:
+
+   GenericImage<P>&       m_target;
+   const GenericImage<P>& m_src;
+   Point                  m_start; // source position of the first complete group of cells
+   const CFA2RGBPattern&  m_pattern;
+   int                    m_factor;
+   bool                   m_sum;
+   bool                   m_cfaOutput;
+   CFA2RGBCoverageMap*    m_coverage;
+   CFA2RGBPyramid*        m_pyramid;
+   Rect                   m_band;
+};
+
+/*
+ * Bins groups of pattern cells within a region of the CFA. phase is the
+ * position of the region in the mosaic; binning starts at the first pattern
+ * cell boundary, so the binned mosaic has the phase of the pattern origin.
+ * Incomplete groups at the region boundaries are discarded.
+ */
+template <class P>
+static void CellBin( GenericImage<P>& target, const GenericImage<P>& cfa, const Rect& roi, const Point& phase,
+                     const CFA2RGBEngine& engine, CFA2RGBCoverageMap* coverage, CFA2RGBPyramid* pyramid )
+{
+   const CFA2RGBPattern& pattern = engine.Pattern();
+   const int p = pattern.Period();
+   const int n = engine.CellBinningFactor();
+   Point start( roi.x0 + AlignUp( phase.x, p ) - phase.x, roi.y0 + AlignUp( phase.y, p ) - phase.y );
+   int width = ((roi.x1 - start.x)/(n*p))*p;
+   int height = ((roi.y1 - start.y)/(n*p))*p;
+   if ( width <= 0 || height <= 0 )
+      throw Error( "CFA2RGB: The image is too small for cell binning." );
+
+   const bool cfaOutput = engine.IsCFAOutput();
+   if ( cfaOutput )
+   {
+      if ( target.Width() != width || target.Height() != height || target.NumberOfChannels() != 1 )
+         target.AllocateData( width, height, 1, ColorSpace::Gray );
+      coverage = 0;
+      pyramid = 0;
+   }
+   else if ( target.Width() != width || target.Height() != height || target.NumberOfChannels() != 3 )
+      target.AllocateData( width, height, 3, ColorSpace::RGB );
+   if ( coverage != 0 )
+      coverage->Allocate( width, height );
+
+   int align = 1;
+   if ( pyramid != 0 )
+   {
+      pyramid->Allocate( width, height, pattern.Period() );
+      align = pyramid->RowAlignment( pattern.Period() );
+   }
+
+   Array<Rect> bands = Bands( target.Bounds(), engine.MaxThreads(), align );
+   ReferenceArray<CFA2RGBCellBinThread<P> > threads;
+   for ( Array<Rect>::const_iterator i = bands.Begin(); i != bands.End(); ++i )
+      threads.Add( new CFA2RGBCellBinThread<P>( target, cfa, start, pattern, n, engine.IsCellBinningSum(), cfaOutput,
+                                                coverage, pyramid, *i ) );
+   RunThreads( threads );
+}
+
+// ----------------------------------------------------------------------------
+
+/*
+ * Green-only output at full resolution. Green samples are copied; the green
+ * value of a red or blue site is the mean of its nearest green samples that
+ * lie within the region being converted.
+ */
+template <class P>
+class CFA2RGBGreenThread : public Thread
+{
+public:
+
+   CFA2RGBGreenThread( GenericImage<P>& green, const GenericImage<P>& cfa, const Rect& roi, const Point& phase,
+                       const CFA2RGBPattern& pattern, const Rect& band ) :
+   Thread(),
+   m_green( green ), m_cfa( cfa ), m_roi( roi ), m_phase( phase ), m_pattern( pattern ), m_band( band )
+   {
+   }
+
+   virtual void Run()
+   {
+      CFA2RGBProgress::Band progress;
+
+      const int width = m_roi.Width();
+      const int height = m_roi.Height();
+      const int stride = m_cfa.Width();
+      const int period = m_pattern.Period();
+      const int r = m_pattern.GreenRadius();
+
+      for ( int y = m_band.y0; y < m_band.y1; ++y )
+      {
+         typename P::sample* g = m_green.ScanLine( y );
+         const typename P::sample* s = m_cfa.ScanLine( m_roi.y0 + y ) + m_roi.x0;
+         const int py = y + m_phase.y;
+         const uint32 greenMask = m_pattern.RowMask( py, 1 );
+         const bool interiorRow = y >= r && y < height - r;
+
+         for ( int x = 0, px = m_phase.x % period; x < width; ++x, px = (px + 1 < period) ? px + 1 : 0 )
+         {
+            if ( greenMask & (uint32( 1 ) << px) )
+            {
+               g[x] = s[x];
+               continue;
+            }
+
+            const CFA2RGBPattern::Neighbors& n = m_pattern.GreenNeighbors( px, py );
+            double sum = 0;
+            int count = 0;
+            if ( interiorRow && x >= r && x < width - r )
+            {
+               for ( int i = 0; i < n.count; ++i )
+                  sum += s[x + n.dy[i]*stride + n.dx[i]];
+               count = n.count;
+            }
+            else
+               for ( int i = 0; i < n.count; ++i )
+               {
+                  int xi = x + n.dx[i];
+                  int yi = y + n.dy[i];
+                  if ( xi >= 0 && xi < width && yi >= 0 && yi < height )
+                  {
+                     sum += s[xi + n.dy[i]*stride];
+                     ++count;
+                  }
+               }
+            g[x] = (count > 0) ? BlockMean<P>( sum, count ) : typename P::sample( 0 );
+         }
+         if ( !progress.Row() )
+            return;
+      }
+   }
+
+private:
+
+   GenericImage<P>&       m_green;
+   const GenericImage<P>& m_cfa;
+   Rect                   m_roi;
+   Point                  m_phase;
+   const CFA2RGBPattern&  m_pattern;
+   Rect                   m_band;
+};
+
+/*
+ * Green-only output with one pixel per pattern cell: the mean of the green
+ * samples of each complete cell.
+ */
+template <class P>
+class CFA2RGBGreenCellThread : public Thread
+{
+public:
+
+   CFA2RGBGreenCellThread( GenericImage<P>& green, const GenericImage<P>& cfa, const Point& start,
+                           const CFA2RGBPattern& pattern, const Rect& band ) :
+   Thread(),
+   m_green( green ), m_cfa( cfa ), m_start( start ), m_pattern( pattern ), m_band( band )
+   {
+   }
+
+   virtual void Run()
+   {
+      CFA2RGBProgress::Band progress;
+
+      const int width = m_green.Width();
+      const int n = m_pattern.Period();
+      int count = 0;
+      for ( int j = 0; j < n; ++j )
+         for ( int i = 0; i < n; ++i )
+            if ( m_pattern.Channel( i, j ) == 1 )
+               ++count;
+
+      DVector sum( width );
+      for ( int y = m_band.y0; y < m_band.y1; ++y )
+      {
+         for ( int x = 0; x < width; ++x )
+            sum[x] = 0;
+         for ( int j = 0; j < n; ++j )
+         {
+            const uint32 greenMask = m_pattern.RowMask( j, 1 );
+            const typename P::sample* s = m_cfa.ScanLine( m_start.y + y*n + j ) + m_start.x;
+            for ( int x = 0; x < width; ++x, s += n )
+            {
+               double v = 0;
+               for ( int i = 0; i < n; ++i )
+                  if ( greenMask & (uint32( 1 ) << i) )
+                     v += s[i];
+               sum[x] += v;
+            }
+         }
+
+         typename P::sample* g = m_green.ScanLine( y );
+         for ( int x = 0; x < width; ++x )
+            g[x] = BlockMean<P>( sum[x], count );
+         if ( !progress.Row() )
+            return;
+      }
+   }
+
+private:
+
+   GenericImage<P>&       m_green;
+   const GenericImage<P>& m_cfa;
+   Point                  m_start; // source position of the first complete cell
+   const CFA2RGBPattern&  m_pattern;
+   Rect                   m_band;
+};
+
+/*
+ * Generates a single-channel green image from a region of the CFA. phase is
+ * the position of the region in the mosaic. In cell mode, incomplete pattern
+ * cells at the region boundaries are discarded.
+ */
+template <class P>
+static void Green( GenericImage<P>& green, const GenericImage<P>& cfa, const Rect& roi, const Point& phase,
+                   const CFA2RGBPattern& pattern, bool cells, int maxThreads )
+{
+   if ( cells )
+   {
+      const int n = pattern.Period();
+      Point start( roi.x0 + AlignUp( phase.x, n ) - phase.x, roi.y0 + AlignUp( phase.y, n ) - phase.y );
+      int width = (roi.x1 - start.x)/n;
+      int height = (roi.y1 - start.y)/n;
+      if ( width <= 0 || height <= 0 )
+         throw Error( "CFA2RGB: The image is too small for superpixel output." );
+
+      if ( green.Width() != width || green.Height() != height || green.NumberOfChannels() != 1 )
+         green.AllocateData( width, height, 1, ColorSpace::Gray );
+
+      Array<Rect> bands = Bands( green.Bounds(), maxThreads );
+      ReferenceArray<CFA2RGBGreenCellThread<P> > threads;
+      for ( Array<Rect>::const_iterator i = bands.Begin(); i != bands.End(); ++i )
+         threads.Add( new CFA2RGBGreenCellThread<P>( green, cfa, start, pattern, *i ) );
+      RunThreads( threads );
+   }
+   else
+   {
+      if ( green.Width() != roi.Width() || green.Height() != roi.Height() || green.NumberOfChannels() != 1 )
+         green.AllocateData( roi.Width(), roi.Height(), 1, ColorSpace::Gray );
+
+      Array<Rect> bands = Bands( green.Bounds(), maxThreads );
+      ReferenceArray<CFA2RGBGreenThread<P> > threads;
+      for ( Array<Rect>::const_iterator i = bands.Begin(); i != bands.End(); ++i )
+         threads.Add( new CFA2RGBGreenThread<P>( green, cfa, roi, phase, pattern, *i ) );
+      RunThreads( threads );
+   }
+}
+
+// ----------------------------------------------------------------------------
+
+/*
+ * Neighbor sums of the interpolation kernels. Floating point and 32-bit
+ * samples are summed in double precision.
+ */
+template <class P>
+struct InterpolationSum
+{
+   typedef double type;
+
+   static typename P::sample Mean( type sum, int count )
+   {
+      return BlockMean<P>( sum, count );
+   }
+};
+
+/*
+ * 2^32/n rounded up, for n <= Neighbors::MaxCount. For s + n/2 < 2^32/n,
+ * ((s + n/2)*R[n]) >> 32 is exactly round( s/n ), so 8-bit and 16-bit
+ * samples are averaged with 32-bit integer sums and a multiplication,
+ * without divisions or conversions to floating point.
+ */
+static const uint64 s_reciprocals[ CFA2RGBPattern::Neighbors::MaxCount+1 ] =
+{
+   0, 4294967296ull, 2147483648ull, 1431655766ull, 1073741824ull, 858993460ull, 715827883ull, 613566757ull, 536870912ull
+};
+
+template <class P>
+struct IntegerInterpolationSum
+{
+   typedef uint32 type;
+
+   static typename P::sample Mean( type sum, int count )
+   {
+      return typename P::sample( ((sum + (count >> 1))*s_reciprocals[count]) >> 32 );
+   }
+};
+
+template <>
+struct InterpolationSum<UInt8PixelTraits> : public IntegerInterpolationSum<UInt8PixelTraits>
+{
+};
+
+template <>
+struct InterpolationSum<UInt16PixelTraits> : public IntegerInterpolationSum<UInt16PixelTraits>
+{
+};
+
+template <typename T>
+static T AbsDiff( T a, T b )
+{
+   return (a > b) ? T( a - b ) : T( b - a );
+}
+
+/*
+ * Lateral CA correction of a region being interpolated: the radial scale of
+ * each channel, which is the identity for green, and the optical center in
+ * region coordinates.
+ */
+struct LateralCA
+{
+   CFA2RGBRadialScale scale[ 3 ];
+   double             cx, cy;
+   double             r2Norm;  // 1/(half diagonal)^2
+
+   /*
+    * origin is the position of the region in the mosaic, whose dimensions
+    * are those set for the engine, if any, or else the specified ones.
+    */
+   LateralCA( const CFA2RGBEngine& engine, int width, int height, const Point& origin )
+   {
+      scale[0] = engine.RedScale();
+      scale[2] = engine.BlueScale();
+      if ( engine.MosaicWidth() > 0 && engine.MosaicHeight() > 0 )
+      {
+         width = engine.MosaicWidth();
+         height = engine.MosaicHeight();
+      }
+      cx = 0.5*(width - 1) - origin.x;
+      cy = 0.5*(height - 1) - origin.y;
+      r2Norm = 4/(double( width )*width + double( height )*height);
+   }
+};
+
+/*
+ * Transforms columns [x0,x1) of an interpolated row with a color matrix. The
+ * row has just been written, so it is still in the L1 cache, and the loop
+ * has no dependencies between pixels, so compilers vectorize it.
+ */
+template <class P>
+static void ColorMatrixRow( typename P::sample* r, typename P::sample* g, typename P::sample* b, int x0, int x1,
+                            const CFA2RGBColorMatrix& matrix )
+{
+   typedef typename P::sample sample;
+   const double m00 = matrix.m[0][0], m01 = matrix.m[0][1], m02 = matrix.m[0][2];
+   const double m10 = matrix.m[1][0], m11 = matrix.m[1][1], m12 = matrix.m[1][2];
+   const double m20 = matrix.m[2][0], m21 = matrix.m[2][1], m22 = matrix.m[2][2];
+   const double max = double( P::MaxSampleValue() );
+   const double round = P::IsFloatSample() ? 0 : 0.5;
+   for ( int x = x0; x < x1; ++x )
+   {
+      const double v0 = r[x], v1 = g[x], v2 = b[x];
+      r[x] = sample( Range( m00*v0 + m01*v1 + m02*v2, 0.0, max ) + round );
+      g[x] = sample( Range( m10*v0 + m11*v1 + m12*v2, 0.0, max ) + round );
+      b[x] = sample( Range( m20*v0 + m21*v1 + m22*v2, 0.0, max ) + round );
+   }
+}
+
+/*
+ * Interpolated RGB output. Samples of the channel of each site are copied;
+ * the other channels are the mean of their nearest sites within the region
+ * being converted. With gradient interpolation, interior sites with a
+ * directional neighbor set use the pair along the smaller gradient. With
+ * lateral CA correction, the red and blue channels are resampled instead.
+ */
+template <class P>
+class CFA2RGBInterpolateThread : public Thread
+{
+public:
+
+   typedef typename P::sample                    sample;
+   typedef typename InterpolationSum<P>::type    sum_type;
+
+   CFA2RGBInterpolateThread( GenericImage<P>& rgb, const GenericImage<P>& cfa, const Rect& roi, const Point& phase,
+                             const CFA2RGBPattern& pattern, bool gradient, const LateralCA* ca,
+                             const CFA2RGBColorMatrix* matrix, CFA2RGBCoverageMap* coverage,
+                             CFA2RGBPyramid* pyramid, const Array<Rect>& rects, size_type start, size_type end ) :
+   Thread(),
+   m_rgb( rgb ), m_cfa( cfa ), m_roi( roi ), m_phase( phase ), m_pattern( pattern ), m_gradient( gradient ), m_ca( ca ),
+   m_matrix( matrix ), m_coverage( coverage ), m_pyramid( pyramid ), m_rects( rects ), m_start( start ), m_end( end )
+   {
+   }
+
+   virtual void Run()
+   {
+      CFA2RGBProgress::Band progress;
+
+      const int width = m_roi.Width();
+      const int height = m_roi.Height();
+      const int stride = m_cfa.Width();
+      const int period = m_pattern.Period();
+      const int r = m_pattern.NeighborRadius();
+
+      PyramidFeed<P> feed( m_pyramid, m_rgb, m_pattern, true/*dense*/ );
+      for ( size_type i = m_start; i < m_end; ++i )
+      {
+         const Rect& rect = m_rects[i];
+         feed.Start( rect.y0 );
+         for ( int y = rect.y0; y < rect.y1; ++y )
+         {
+            const sample* s = m_cfa.ScanLine( m_roi.y0 + y ) + m_roi.x0;
+            const int py = y + m_phase.y;
+            const bool interiorRow = y >= r && y < height - r;
+
+            for ( int c = 0; c < 3; ++c )
+            {
+               sample* f = m_rgb.ScanLine( y, c );
+               const uint32 mask = m_pattern.RowMask( py, c );
+
+               if ( m_ca != 0 && !m_ca->scale[c].IsIdentity() )
+                  Resample( f, rect.x0, rect.x1, y, c );
+               else
+               {
+                  for ( int x = rect.x0, px = (x + m_phase.x) % period; x < rect.x1; ++x, px = (px + 1 < period) ? px + 1 : 0 )
+                  {
+                     if ( mask & (uint32( 1 ) << px) )
+                     {
+                        f[x] = s[x];
+                        continue;
+                     }
+
+                     const CFA2RGBPattern::Neighbors& n = m_pattern.ChannelNeighbors( px, py, c );
+                     if ( interiorRow && x >= r && x < width - r )
+                     {
+                        const sample* p = s + x;
+                        if ( m_gradient && n.directional )
+                        {
+                           sample h0 = p[n.dy[0]*stride + n.dx[0]], h1 = p[n.dy[1]*stride + n.dx[1]];
+                           sample v0 = p[n.dy[2]*stride + n.dx[2]], v1 = p[n.dy[3]*stride + n.dx[3]];
+                           sample dh = AbsDiff( h0, h1 );
+                           sample dv = AbsDiff( v0, v1 );
+                           if ( dh < dv )
+                              f[x] = InterpolationSum<P>::Mean( sum_type( h0 ) + sum_type( h1 ), 2 );
+                           else if ( dv < dh )
+                              f[x] = InterpolationSum<P>::Mean( sum_type( v0 ) + sum_type( v1 ), 2 );
+                           else
+                              f[x] = InterpolationSum<P>::Mean( sum_type( h0 ) + sum_type( h1 ) + sum_type( v0 ) + sum_type( v1 ), 4 );
+                        }
+                        else
+                        {
+                           sum_type sum = 0;
+                           for ( int k = 0; k < n.count; ++k )
+                              sum += p[n.dy[k]*stride + n.dx[k]];
+                           f[x] = InterpolationSum<P>::Mean( sum, n.count );
+                        }
+                     }
+                     else
+                     {
+                        sum_type sum = 0;
+                        int count = 0;
+                        for ( int k = 0; k < n.count; ++k )
+                        {
+                           int xk = x + n.dx[k];
+                           int yk = y + n.dy[k];
+                           if ( xk >= 0 && xk < width && yk >= 0 && yk < height )
+                           {
+                              sum += s[xk + n.dy[k]*stride];
+                              ++count;
+                           }
+                        }
+                        f[x] = (count > 0) ? InterpolationSum<P>::Mean( sum, count ) : sample( 0 );
+                     }
+                  }
+               }
+
+               if ( m_coverage != 0 )
+                  CoverRow( m_coverage->Row( y, c ), rect.x0, rect.x1, m_phase.x, m_pattern.LaneMask( py, c ) );
+            }
+            if ( m_matrix != 0 )
+               ColorMatrixRow<P>( m_rgb.ScanLine( y, 0 ), m_rgb.ScanLine( y, 1 ), m_rgb.ScanLine( y, 2 ),
+                                  rect.x0, rect.x1, *m_matrix );
+            feed.RowDone( y, y + 1 == rect.y1 );
+            if ( !progress.Row() )
+               return;
+         }
+      }
+   }
+
+   /*
+    * Value of channel c at (x,y): the CFA sample at sites of that channel,
+    * or else the mean of its nearest sites within the region.
+    */
+   double ChannelValue( int x, int y, int c ) const
+   {
+      const sample* s = m_cfa.ScanLine( m_roi.y0 + y ) + m_roi.x0;
+      const int px = (x + m_phase.x) % m_pattern.Period();
+      const int py = y + m_phase.y;
+      if ( m_pattern.RowMask( py, c ) & (uint32( 1 ) << px) )
+         return s[x];
+
+      const CFA2RGBPattern::Neighbors& n = m_pattern.ChannelNeighbors( px, py, c );
+      double sum = 0;
+      int count = 0;
+      for ( int k = 0; k < n.count; ++k )
+      {
+         int xk = x + n.dx[k];
+         int yk = y + n.dy[k];
+         if ( xk >= 0 && xk < m_roi.Width() && yk >= 0 && yk < m_roi.Height() )
+         {
+            sum += s[xk + n.dy[k]*m_cfa.Width()];
+            ++count;
+         }
+      }
+      return (count > 0) ? sum/count : 0.0;
+   }
+
+   /*
+    * Lateral CA correction of channel c of a row: each pixel is sampled
+    * bilinearly at its radially scaled position, clamped to the region.
+    */
+   void Resample( sample* f, int x0, int x1, int y, int c ) const
+   {
+      const int width = m_roi.Width();
+      const int height = m_roi.Height();
+      const CFA2RGBRadialScale& scale = m_ca->scale[c];
+      const double dy = y - m_ca->cy;
+
+      for ( int x = x0; x < x1; ++x )
+      {
+         const double dx = x - m_ca->cx;
+         const double k = scale.Scale( (dx*dx + dy*dy)*m_ca->r2Norm );
+         const double qx = Range( m_ca->cx + dx*k, 0.0, double( width - 1 ) );
+         const double qy = Range( m_ca->cy + dy*k, 0.0, double( height - 1 ) );
+         const int ix0 = int( qx ), iy0 = int( qy );
+         const int ix1 = Min( ix0 + 1, width - 1 ), iy1 = Min( iy0 + 1, height - 1 );
+         const double fx = qx - ix0, fy = qy - iy0;
+
+         double v0 = ChannelValue( ix0, iy0, c );
+         if ( fx > 0 )
+            v0 += fx*(ChannelValue( ix1, iy0, c ) - v0);
+         if ( fy > 0 )
+         {
+            double v1 = ChannelValue( ix0, iy1, c );
+            if ( fx > 0 )
+               v1 += fx*(ChannelValue( ix1, iy1, c ) - v1);
+            v0 += fy*(v1 - v0);
+         }
+         f[x] = BlockMean<P>( v0, 1 );
+      }
+   }
+
+private:
+
+   GenericImage<P>&          m_rgb;
+   const GenericImage<P>&    m_cfa;
+   Rect                      m_roi;
+   Point                     m_phase;  // position of the region in the CFA mosaic
+   const CFA2RGBPattern&     m_pattern;
+   bool                      m_gradient;
+   const LateralCA*          m_ca;
+   const CFA2RGBColorMatrix* m_matrix;
+   CFA2RGBCoverageMap*       m_coverage;
+   CFA2RGBPyramid*           m_pyramid; // requires full-width rectangles aligned to the pyramid
+   const Array<Rect>&        m_rects;
+   size_type                 m_start;
+   size_type                 m_end;
+};
+
+/*
+ * Interpolates the specified list of disjoint rectangles of a region of the
+ * CFA, distributing them among the available processor threads. rgb must
+ * have the dimensions of the region.
+ */
+template <class P>
+static void Interpolate( GenericImage<P>& rgb, const GenericImage<P>& cfa, const Rect& roi, const Point& phase,
+                         const CFA2RGBPattern& pattern, bool gradient, const LateralCA* ca,
+                         const CFA2RGBColorMatrix* matrix, CFA2RGBCoverageMap* coverage,
+                         CFA2RGBPyramid* pyramid, const Array<Rect>& rects, int maxThreads )
+{
+   if ( rects.IsEmpty() )
+      return;
+
+   const int numberOfThreads = ThreadCount( rects.Length(), 1, maxThreads );
+   const size_type rectsPerThread = rects.Length()/numberOfThreads;
+
+   ReferenceArray<CFA2RGBInterpolateThread<P> > threads;
+   for ( int i = 0, j = 1; i < numberOfThreads; ++i, ++j )
+      threads.Add( new CFA2RGBInterpolateThread<P>( rgb, cfa, roi, phase, pattern, gradient, ca, matrix, coverage, pyramid, rects,
+                           i*rectsPerThread, (j < numberOfThreads) ? j*rectsPerThread : rects.Length() ) );
+   RunThreads( threads );
+}
+
+// ----------------------------------------------------------------------------
+
+/*
+ * Packing groups: number of pixels and bytes in the smallest repeating unit
+ * of each packing scheme, indexed by CFA2RGBRawPackingParameter value.
+ */
+static const struct { int pixels, bytes, bits; }
+s_packings[ CFA2RGBRawPackingParameter::NumberOfItems ] =
+{
+   { 4, 5, 10 },  // MIPIRAW10
+   { 2, 3, 12 },  // MIPIRAW12
+   { 4, 7, 14 },  // MIPIRAW14
+   { 2, 3, 12 }   // Packed12
+};
+
+/*
+ * Unpacks the first width pixels of a packed row, rounded up to whole
+ * groups, into samples scaled to the 16-bit range. Each scheme is unpacked
+ * with a fixed-size group loop that compilers can vectorize as byte shuffles.
+ */
+static void UnpackRow( uint16* f, const uint8* s, int width, pcl_enum packing )
+{
+   switch ( packing )
+   {
+   case CFA2RGBRawPackingParameter::MIPIRAW10:
+      for ( int x = 0; x < width; x += 4, s += 5, f += 4 )
+         for ( int i = 0; i < 4; ++i )
+            f[i] = uint16( ((s[i] << 2) | ((s[4] >> 2*i) & 0x03)) << 6 );
+      break;
+   default:
+   case CFA2RGBRawPackingParameter::MIPIRAW12:
+      for ( int x = 0; x < width; x += 2, s += 3, f += 2 )
+         for ( int i = 0; i < 2; ++i )
+            f[i] = uint16( ((s[i] << 4) | ((s[2] >> 4*i) & 0x0f)) << 4 );
+      break;
+   case CFA2RGBRawPackingParameter::MIPIRAW14:
+      for ( int x = 0; x < width; x += 4, s += 7, f += 4 )
+      {
+         uint32 lsb = uint32( s[4] ) | (uint32( s[5] ) << 8) | (uint32( s[6] ) << 16);
+         for ( int i = 0; i < 4; ++i )
+            f[i] = uint16( ((s[i] << 6) | ((lsb >> 6*i) & 0x3f)) << 2 );
+      }
+      break;
+   case CFA2RGBRawPackingParameter::Packed12:
+      for ( int x = 0; x < width; x += 2, s += 3, f += 2 )
+      {
+         f[0] = uint16( (s[0] | ((s[1] & 0x0f) << 8)) << 4 );
+         f[1] = uint16( ((s[1] >> 4) | (s[2] << 4)) << 4 );
+      }
+      break;
+   }
+}
+
+class CFA2RGBPackedThread : public Thread
+{
+public:
+
+   CFA2RGBPackedThread( UInt16Image& rgb, const CFA2RGBPackedFrame& frame, const CFA2RGBPattern& pattern,
+                        CFA2RGBCoverageMap* coverage, CFA2RGBPyramid* pyramid, bool streaming, const Rect& band ) :
+   Thread(),
+   m_rgb( rgb ), m_frame( frame ), m_pattern( pattern ), m_coverage( coverage ), m_pyramid( pyramid ),
+   m_streaming( streaming ), m_band( band )
+   {
+   }
+
+   virtual void Run()
+   {
+      CFA2RGBProgress::Band progress;
+
+      const int width = m_frame.width;
+      const int groupPixels = s_packings[m_frame.packing].pixels;
+      GenericVector<uint16> row( (width + groupPixels - 1)/groupPixels*groupPixels );
+
+      const uint8* data = reinterpret_cast<const uint8*>( m_frame.data );
+      const size_type stride = m_frame.Stride();
+
+      PyramidFeed<UInt16PixelTraits> feed( m_pyramid, m_rgb, m_pattern );
+      feed.Start( m_band.y0 );
+
+      for ( int y = m_band.y0; y < m_band.y1; ++y )
+      {
+         UnpackRow( row.Begin(), data + y*stride, width, m_frame.packing );
+         for ( int c = 0; c < 3; ++c )
+         {
+            const uint8* mask = m_pattern.LaneMask( y, c );
+            ExpandRow( m_rgb.ScanLine( y, c ), row.Begin(), 0, width, 0, mask, m_streaming );
+            if ( m_coverage != 0 )
+               CoverRow( m_coverage->Row( y, c ), 0, width, 0, mask );
+         }
+         feed.RowDone( y, y + 1 == m_band.y1 );
+         if ( !progress.Row() )
+            return;
+      }
+   }
+
+private:
+
+   UInt16Image&              m_rgb;
+   const CFA2RGBPackedFrame& m_frame;
+   const CFA2RGBPattern&     m_pattern;
+   CFA2RGBCoverageMap*       m_coverage;
+   CFA2RGBPyramid*           m_pyramid;
+   bool                      m_streaming;
+   Rect                      m_band;
+};
+
+// ----------------------------------------------------------------------------
+
+template <class P>
+static void ConvertInPlace( GenericImage<P>& image, const Point& origin, const CFA2RGBEngine& engine,
+                            CFA2RGBCoverageMap* coverage, CFA2RGBPyramid* pyramid )
+{
+   if ( engine.IsGreenOutput() )
+   {
+      GenericImage<P> green;
+      Green( green, image, image.Bounds(), origin, engine.Pattern(), engine.IsSuperpixelOutput(),
+             engine.MaxThreads() );
+      image.Assign( green );
+      return;
+   }
+
+   if ( engine.IsBinning() )
+   {
+      GenericImage<P> rgb;
+      Bin( rgb, image, image.Bounds(), origin, engine.Pattern(), coverage, pyramid, engine.MaxThreads() );
+      image.Assign( rgb );
+      return;
+   }
+
+   if ( engine.IsCellBinning() )
+   {
+      GenericImage<P> binned;
+      CellBin( binned, image, image.Bounds(), origin, engine, coverage, pyramid );
+      image.Assign( binned );
+      return;
+   }
+
+   /*
+    * Interpolation reads neighbor samples, so it works from a copy of the
+    * CFA plane.
+    */
+   GenericImage<P> cfa;
+   if ( engine.IsInterpolating() )
+   {
+      cfa.Assign( image, image.Bounds(), 0, 0 );
+      image.AllocateData( cfa.Width(), cfa.Height(), 3, ColorSpace::RGB );
+   }
+   else
+      image.SetColorSpace( ColorSpace::RGB );
+
+   if ( coverage != 0 )
+      coverage->Allocate( image.Width(), image.Height() );
+   int align = 1;
+   if ( pyramid != 0 )
+   {
+      pyramid->Allocate( image.Width(), image.Height(), engine.Period() );
+      align = pyramid->RowAlignment( engine.Period() );
+   }
+
+   Array<Rect> bands = Bands( image.Bounds(), engine.MaxThreads(), align );
+   if ( engine.IsInterpolating() )
+   {
+      LateralCA ca( engine, image.Width(), image.Height(), origin );
+      Interpolate( image, cfa, cfa.Bounds(), origin, engine.Pattern(), engine.IsGradientInterpolation(),
+                   engine.IsCorrectingLateralCA() ? &ca : 0,
+                   engine.IsApplyingColorMatrix() ? &engine.ColorMatrix() : 0, coverage, pyramid, bands, engine.MaxThreads() );
+   }
+   else
+      Expand( image, image, true/*inPlace*/, Point( 0 ), origin, engine.Pattern(), coverage, pyramid,
+              bands, engine.MaxThreads() );
+}
+
+template <class P>
+static void ConvertTo( ImageVariant& target, const GenericImage<P>& cfa, const Rect& roi, const Point& phase,
+                       const CFA2RGBEngine& engine, CFA2RGBCoverageMap* coverage, CFA2RGBPyramid* pyramid )
+{
+   GenericImage<P>& rgb = static_cast<GenericImage<P>&>( *target );
+   if ( engine.IsGreenOutput() )
+   {
+      Green( rgb, cfa, roi, phase, engine.Pattern(), engine.IsSuperpixelOutput(),
+             engine.MaxThreads() );
+      return;
+   }
+
+   if ( engine.IsBinning() )
+   {
+      Bin( rgb, cfa, roi, phase, engine.Pattern(), coverage, pyramid, engine.MaxThreads() );
+      return;
+   }
+
+   if ( engine.IsCellBinning() )
+   {
+      CellBin( rgb, cfa, roi, phase, engine, coverage, pyramid );
+      return;
+   }
+
+   if ( rgb.Width() != roi.Width() || rgb.Height() != roi.Height() || rgb.NumberOfChannels() != 3 )
+      rgb.AllocateData( roi.Width(), roi.Height(), 3, ColorSpace::RGB );
+   if ( coverage != 0 )
+      coverage->Allocate( rgb.Width(), rgb.Height() );
+   int align = 1;
+   if ( pyramid != 0 )
+   {
+      pyramid->Allocate( rgb.Width(), rgb.Height(), engine.Period() );
+      align = pyramid->RowAlignment( engine.Period() );
+   }
+   Array<Rect> bands = Bands( rgb.Bounds(), engine.MaxThreads(), align );
+   if ( engine.IsInterpolating() )
+   {
+      LateralCA ca( engine, cfa.Width(), cfa.Height(), phase );
+      Interpolate( rgb, cfa, roi, phase, engine.Pattern(), engine.IsGradientInterpolation(),
+                   engine.IsCorrectingLateralCA() ? &ca : 0,
+                   engine.IsApplyingColorMatrix() ? &engine.ColorMatrix() : 0, coverage, pyramid, bands, engine.MaxThreads() );
+   }
+   else
+      Expand( rgb, cfa, false/*inPlace*/, roi.LeftTop(), phase, engine.Pattern(), coverage, pyramid,
+              bands, engine.MaxThreads() );
+}
+
+template <class P>
+static void UpdateTo( ImageVariant& target, const GenericImage<P>& cfa, const CFA2RGBEngine& engine,
+                      CFA2RGBCoverageMap* coverage, const Array<Rect>& tiles )
+{
+   GenericImage<P>& rgb = static_cast<GenericImage<P>&>( *target );
+   if ( engine.IsInterpolating() )
+      Interpolate( rgb, cfa, cfa.Bounds(), Point( 0 ), engine.Pattern(), engine.IsGradientInterpolation(),
+                   0/*ca*/, engine.IsApplyingColorMatrix() ? &engine.ColorMatrix() : 0, coverage, 0/*pyramid*/,
+                   tiles, engine.MaxThreads() );
+   else
+      Expand( rgb, cfa, false/*inPlace*/, Point( 0 ), Point( 0 ), engine.Pattern(),
+              coverage, 0/*pyramid*/, tiles, engine.MaxThreads() );
+}
+
+// ----------------------------------------------------------------------------
+
+void CFA2RGBCoverageMap::Allocate( int width, int height )
+{
+   if ( width != m_width || height != m_height )
+   {
+      m_width = width;
+      m_height = height;
+      m_rowBytes = (width + 7) >> 3;
+      for ( int c = 0; c < 3; ++c )
+         m_planes[c] = ByteArray( size_type( m_rowBytes )*size_type( height ), uint8( 0 ) );
+   }
+}
+
+// ----------------------------------------------------------------------------
+
+void CFA2RGBPyramid::Allocate( int width, int height, int period )
+{
+   width /= period;
+   height /= period;
+   for ( int i = 0; i < m_levels; ++i, width >>= 1, height >>= 1 )
+      if ( width > 0 && height > 0 )
+      {
+         if ( m_level[i].Width() != width || m_level[i].Height() != height || m_level[i].NumberOfChannels() != 3 )
+            m_level[i].AllocateData( width, height, 3, ColorSpace::RGB );
+      }
+      else
+         m_level[i].FreeData();
+}
+
+// ----------------------------------------------------------------------------
+
+int CFA2RGBPackedFrame::BitsPerSample() const
+{
+   return s_packings[packing].bits;
+}
+
+size_type CFA2RGBPackedFrame::RowBytes() const
+{
+   return size_type( (width + s_packings[packing].pixels - 1)/s_packings[packing].pixels )*s_packings[packing].bytes;
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBEngine::CFA2RGBEngine( const CFA2RGBInstance& instance ) :
+m_pattern( &CFA2RGBPattern::ForId( instance.p_bayerPattern ) ),
+m_blockBinning( instance.p_blockBinning ),
+m_outputMode( instance.p_outputMode ),
+m_interpolation( instance.p_interpolation ),
+m_maxThreads( 0 ),
+m_progress( 0 ),
+m_mosaicWidth( 0 ),
+m_mosaicHeight( 0 ),
+m_cellBinning( CFA2RGBCellBinningParameter::Factor( instance.p_cellBinning ) ),
+m_cellBinningSum( instance.p_cellBinningMode == CFA2RGBCellBinningModeParameter::Sum ),
+m_cellBinningCFA( instance.p_cellBinningOutput == CFA2RGBCellBinningOutputParameter::CFA )
+{
+   if ( instance.p_correctLateralCA )
+      SetLateralCACorrection(
+         CFA2RGBRadialScale( instance.p_lateralCARed[0], instance.p_lateralCARed[1], instance.p_lateralCARed[2] ),
+         CFA2RGBRadialScale( instance.p_lateralCABlue[0], instance.p_lateralCABlue[1], instance.p_lateralCABlue[2] ) );
+   // Matrices read from keywords are set for each image by the instance.
+   if ( instance.p_applyColorMatrix )
+      if ( instance.p_colorMatrixSource == CFA2RGBColorMatrixSourceParameter::Parameters )
+         SetColorMatrix( CFA2RGBColorMatrix( instance.p_colorMatrix ) );
+}
+
+CFA2RGBEngine::CFA2RGBEngine( pcl_enum bayerPattern, bool blockBinning, pcl_enum outputMode, pcl_enum interpolation ) :
+m_pattern( &CFA2RGBPattern::ForId( bayerPattern ) ),
+m_blockBinning( blockBinning ),
+m_outputMode( outputMode ),
+m_interpolation( interpolation ),
+m_maxThreads( 0 ),
+m_progress( 0 ),
+m_mosaicWidth( 0 ),
+m_mosaicHeight( 0 ),
+m_cellBinning( 1 ),
+m_cellBinningSum( false ),
+m_cellBinningCFA( false )
+{
+}
+
+bool CFA2RGBEngine::IsBinning() const
+{
+   return m_blockBinning && m_pattern->BlockSize() > 1 && !IsGreenOutput();
+}
+
+bool CFA2RGBEngine::IsGreenOutput() const
+{
+   return m_outputMode != CFA2RGBOutputModeParameter::RGB;
+}
+
+bool CFA2RGBEngine::IsSuperpixelOutput() const
+{
+   return m_outputMode == CFA2RGBOutputModeParameter::GreenSuperpixel;
+}
+
+bool CFA2RGBEngine::IsCellBinning() const
+{
+   return m_cellBinning > 1 && !IsGreenOutput() && !IsBinning();
+}
+
+bool CFA2RGBEngine::IsCFAOutput() const
+{
+   return m_cellBinningCFA && IsCellBinning();
+}
+
+bool CFA2RGBEngine::IsInterpolating() const
+{
+   return m_interpolation != CFA2RGBInterpolationParameter::None && !IsGreenOutput() && !IsBinning() && !IsCellBinning();
+}
+
+bool CFA2RGBEngine::IsGradientInterpolation() const
+{
+   return m_interpolation == CFA2RGBInterpolationParameter::Gradient;
+}
+
+bool CFA2RGBEngine::IsCorrectingLateralCA() const
+{
+   return IsInterpolating() && (!m_redScale.IsIdentity() || !m_blueScale.IsIdentity());
+}
+
+bool CFA2RGBEngine::IsApplyingColorMatrix() const
+{
+   return IsInterpolating() && !m_colorMatrix.IsIdentity();
+}
+
+int CFA2RGBEngine::Halo() const
+{
+   return IsInterpolating() ? m_pattern->NeighborRadius() : 0;
+}
+
+void CFA2RGBEngine::Convert( ImageVariant& image, const Point& origin, CFA2RGBCoverageMap* coverage,
+                             CFA2RGBPyramid* pyramid ) const
+{
+   CFA2RGBProgress::Scope scope( m_progress );
+
+   if ( image.IsFloatSample() )
+      switch ( image.BitsPerSample() )
+      {
+      case 32: ConvertInPlace( static_cast<Image&>( *image ), origin, *this, coverage, pyramid ); break;
+      case 64: ConvertInPlace( static_cast<DImage&>( *image ), origin, *this, coverage, pyramid ); break;
+      }
+   else
+      switch ( image.BitsPerSample() )
+      {
+      case  8: ConvertInPlace( static_cast<UInt8Image&>( *image ), origin, *this, coverage, pyramid ); break;
+      case 16: ConvertInPlace( static_cast<UInt16Image&>( *image ), origin, *this, coverage, pyramid ); break;
+      case 32: ConvertInPlace( static_cast<UInt32Image&>( *image ), origin, *this, coverage, pyramid ); break;
+      }
+}
+
+void CFA2RGBEngine::Convert( ImageVariant& rgb, const ImageVariant& cfa, CFA2RGBCoverageMap* coverage,
+                             CFA2RGBPyramid* pyramid ) const
+{
+   Convert( rgb, cfa, cfa->Bounds(), Point( 0 ), coverage, pyramid );
+}
+
+void CFA2RGBEngine::Convert( ImageVariant& rgb, const ImageVariant& cfa, const Rect& rect, const Point& origin,
+                             CFA2RGBCoverageMap* coverage, CFA2RGBPyramid* pyramid ) const
+{
+   CFA2RGBProgress::Scope scope( m_progress );
+
+   Rect roi = rect.Ordered().Intersection( cfa->Bounds() );
+   if ( !roi.IsRect() )
+      throw Error( "CFA2RGB: Empty region of interest." );
+
+   if ( !rgb || rgb.IsFloatSample() != cfa.IsFloatSample() || rgb.BitsPerSample() != cfa.BitsPerSample() )
+      rgb.CreateImage( cfa.IsFloatSample(), false/*isComplex*/, cfa.BitsPerSample() );
+
+   if ( cfa.IsFloatSample() )
+      switch ( cfa.BitsPerSample() )
+      {
+      case 32: ConvertTo( rgb, static_cast<const Image&>( *cfa ), roi, origin + roi.LeftTop(), *this, coverage, pyramid ); break;
+      case 64: ConvertTo( rgb, static_cast<const DImage&>( *cfa ), roi, origin + roi.LeftTop(), *this, coverage, pyramid ); break;
+      }
+   else
+      switch ( cfa.BitsPerSample() )
+      {
+      case  8: ConvertTo( rgb, static_cast<const UInt8Image&>( *cfa ), roi, origin + roi.LeftTop(), *this, coverage, pyramid ); break;
+      case 16: ConvertTo( rgb, static_cast<const UInt16Image&>( *cfa ), roi, origin + roi.LeftTop(), *this, coverage, pyramid ); break;
+      case 32: ConvertTo( rgb, static_cast<const UInt32Image&>( *cfa ), roi, origin + roi.LeftTop(), *this, coverage, pyramid ); break;
+      }
+}
+
+void CFA2RGBEngine::Convert( ImageVariant& rgb, const CFA2RGBPackedFrame& frame, CFA2RGBCoverageMap* coverage,
+                             CFA2RGBPyramid* pyramid ) const
+{
+   CFA2RGBProgress::Scope scope( m_progress );
+   if ( frame.packing < 0 || frame.packing >= CFA2RGBRawPackingParameter::NumberOfItems )
+      throw Error( "CFA2RGB: Unknown raw packing scheme." );
+   if ( frame.data == 0 || frame.width <= 0 || frame.height <= 0 )
+      throw Error( "CFA2RGB: Empty packed frame." );
+   if ( frame.Stride() < frame.RowBytes() )
+      throw Error( "CFA2RGB: The row stride is too small for the packed frame width." );
+   if ( IsBinning() )
+      throw Error( "CFA2RGB: Block binning is not available for packed raw frames." );
+
+   if ( !rgb || rgb.IsFloatSample() || rgb.BitsPerSample() != 16 )
+      rgb.CreateImage( false/*isFloat*/, false/*isComplex*/, 16 );
+
+   UInt16Image& image = static_cast<UInt16Image&>( *rgb );
+
+   if ( IsGreenOutput() || IsInterpolating() || IsCellBinning() )
+   {
+      /*
+       * Interpolation and cell binning read neighbor rows, so the mosaic is
+       * unpacked first. UnpackRow() writes whole groups, so rows whose width
+       * is not a multiple of the group size are unpacked into a padded row
+       * and then copied, lest they overwrite the next row.
+       */
+      UInt16Image cfa( frame.width, frame.height );
+      const int groupPixels = s_packings[frame.packing].pixels;
+      GenericVector<uint16> row( (frame.width + groupPixels - 1)/groupPixels*groupPixels );
+      const bool padded = frame.width % groupPixels != 0;
+      for ( int y = 0; y < frame.height; ++y )
+      {
+         const uint8* s = static_cast<const uint8*>( frame.data ) + y*frame.Stride();
+         if ( padded )
+         {
+            UnpackRow( row.Begin(), s, frame.width, frame.packing );
+            ::memcpy( cfa.ScanLine( y ), row.Begin(), frame.width*sizeof( uint16 ) );
+         }
+         else
+            UnpackRow( cfa.ScanLine( y ), s, frame.width, frame.packing );
+      }
+      if ( IsGreenOutput() )
+         Green( image, cfa, cfa.Bounds(), Point( 0 ), *m_pattern, IsSuperpixelOutput(), m_maxThreads );
+      else
+         ConvertTo( rgb, cfa, cfa.Bounds(), Point( 0 ), *this, coverage, pyramid );
+      return;
+   }
+
+   if ( image.Width() != frame.width || image.Height() != frame.height || image.NumberOfChannels() != 3 )
+      image.AllocateData( frame.width, frame.height, 3, ColorSpace::RGB );
+   if ( coverage != 0 )
+      coverage->Allocate( frame.width, frame.height );
+   int align = 1;
+   if ( pyramid != 0 )
+   {
+      pyramid->Allocate( frame.width, frame.height, Period() );
+      align = pyramid->RowAlignment( Period() );
+   }
+
+   const bool streaming = pyramid == 0 && IsStreamingOutput( image );
+   Array<Rect> bands = Bands( image.Bounds(), m_maxThreads, align );
+   ReferenceArray<CFA2RGBPackedThread> threads;
+   for ( Array<Rect>::const_iterator i = bands.Begin(); i != bands.End(); ++i )
+      threads.Add( new CFA2RGBPackedThread( image, frame, *m_pattern, coverage, pyramid, streaming, *i ) );
+   RunThreads( threads );
+}
+
+int CFA2RGBEngine::Period() const
+{
+   return m_pattern->Period();
+}
+
+int CFA2RGBEngine::OutputPeriod() const
+{
+   return IsBinning() ? m_pattern->BinnedPattern().Period() : m_pattern->Period();
+}
+
+void CFA2RGBEngine::GetOutputDimensions( int& outputWidth, int& outputHeight, int width, int height ) const
+{
+   int n = 1;
+   if ( IsSuperpixelOutput() )
+      n = m_pattern->Period();
+   else if ( IsBinning() )
+      n = m_pattern->BlockSize();
+   else if ( IsCellBinning() )
+   {
+      const int p = m_pattern->Period();
+      outputWidth = width/(m_cellBinning*p)*p;
+      outputHeight = height/(m_cellBinning*p)*p;
+      return;
+   }
+   outputWidth = width/n;
+   outputHeight = height/n;
+}
+
+size_type CFA2RGBEngine::Update( ImageVariant& rgb, const ImageVariant& cfa, const Array<Rect>& dirty,
+                                 CFA2RGBCoverageMap* coverage ) const
+{
+   CFA2RGBProgress::Scope scope( m_progress );
+   if ( !CanUpdate( rgb, cfa ) )
+   {
+      Convert( rgb, cfa, coverage );
+      return cfa->NumberOfPixels();
+   }
+
+   if ( coverage != 0 )
+      if ( coverage->Width() != cfa->Width() || coverage->Height() != cfa->Height() )
+      {
+         /*
+          * A new coverage map needs a complete pass.
+          */
+         Convert( rgb, cfa, coverage );
+         return cfa->NumberOfPixels();
+      }
+
+   Array<Rect> tiles = DirtyTiles( dirty, cfa->Width(), cfa->Height() );
+
+   if ( cfa.IsFloatSample() )
+      switch ( cfa.BitsPerSample() )
+      {
+      case 32: UpdateTo( rgb, static_cast<const Image&>( *cfa ), *this, coverage, tiles ); break;
+      case 64: UpdateTo( rgb, static_cast<const DImage&>( *cfa ), *this, coverage, tiles ); break;
+      }
+   else
+      switch ( cfa.BitsPerSample() )
+      {
+      case  8: UpdateTo( rgb, static_cast<const UInt8Image&>( *cfa ), *this, coverage, tiles ); break;
+      case 16: UpdateTo( rgb, static_cast<const UInt16Image&>( *cfa ), *this, coverage, tiles ); break;
+      case 32: UpdateTo( rgb, static_cast<const UInt32Image&>( *cfa ), *this, coverage, tiles ); break;
+      }
+
+   size_type count = 0;
+   for ( Array<Rect>::const_iterator i = tiles.Begin(); i != tiles.End(); ++i )
+      count += size_type( i->Width() )*size_type( i->Height() );
+   return count;
+}
+
+bool CFA2RGBEngine::CanUpdate( const ImageVariant& rgb, const ImageVariant& cfa ) const
+{
+   return !IsBinning() && !IsCellBinning() && !IsGreenOutput() && !IsCFAOutput() && !IsCorrectingLateralCA() &&
+          rgb && rgb.IsFloatSample() == cfa.IsFloatSample() && rgb.BitsPerSample() == cfa.BitsPerSample() &&
+          rgb->Width() == cfa->Width() && rgb->Height() == cfa->Height() && rgb->NumberOfChannels() == 3;
+}
+
+Array<Rect> CFA2RGBEngine::DirtyTiles( const Array<Rect>& dirty, int width, int height ) const
+{
+   const int period = Period();
+   const int halo = Halo();
+   const int tilesX = (width + s_tileSize - 1)/s_tileSize;
+   const int tilesY = (height + s_tileSize - 1)/s_tileSize;
+
+   /*
+    * Accumulate, for each tile, the union of the expanded dirty rectangles
+    * that intersect it. Only tiles overlapped by some rectangle are visited.
+    */
+   Array<Rect> areas( size_type( tilesX )*size_type( tilesY ), Rect( 0, 0, 0, 0 ) );
+   for ( Array<Rect>::const_iterator i = dirty.Begin(); i != dirty.End(); ++i )
+   {
+      Rect d = i->Ordered();
+      Rect r( Max( 0, AlignDown( d.x0 - halo, period ) ), Max( 0, AlignDown( d.y0 - halo, period ) ),
+              Min( width, AlignUp( d.x1 + halo, period ) ), Min( height, AlignUp( d.y1 + halo, period ) ) );
+      if ( !r.IsRect() )
+         continue;
+
+      for ( int ty = r.y0/s_tileSize; ty <= (r.y1 - 1)/s_tileSize; ++ty )
+         for ( int tx = r.x0/s_tileSize; tx <= (r.x1 - 1)/s_tileSize; ++tx )
+         {
+            Rect tile( tx*s_tileSize, ty*s_tileSize, Min( (tx + 1)*s_tileSize, width ), Min( (ty + 1)*s_tileSize, height ) );
+            Rect a = r.Intersection( tile );
+            Rect& area = areas[ty*size_type( tilesX ) + tx];
+            area = area.IsRect() ? area.Union( a ) : a;
+         }
+   }
+
+   Array<Rect> tiles;
+   for ( Array<Rect>::const_iterator i = areas.Begin(); i != areas.End(); ++i )
+      if ( i->IsRect() )
+         tiles.Add( *i );
+   return tiles;
+}
+
+// ----------------------------------------------------------------------------
+
+} // pcl
+
+// ****************************************************************************
+// EOF CFA2RGBEngine.cpp - Released 2016/02/03 00:00:00 UTC
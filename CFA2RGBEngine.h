@@ -0,0 +1,605 @@
+//     ____   ______ __
+//    / __ \ / ____// /
+//   / /_/ // /    / /
+//  / ____// /___ / /___   PixInsight Class Library
+// /_/     \____//_____/   PCL 02.01.00.0779
+// ----------------------------------------------------------------------------
+// Standard CFA2RGB Process Module Version 01.01.01.0010
+// ----------------------------------------------------------------------------
+// CFA2RGBEngine.h - Released 2016/02/03 00:00:00 UTC
+// ----------------------------------------------------------------------------
+// This file is part of the standard CFA2RGB PixInsight module.
+//
+// Copyright (c) 2003-2016 Pleiades Astrophoto S.L. All Rights Reserved.
+//
+// Redistribution and use in both source and binary forms, with or without
+// modification, is permitted provided that the following conditions are met:
+//
+// 1. All redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. All redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the names "PixInsight" and "Pleiades Astrophoto", nor the names
+//    of their contributors, may be used to endorse or promote products derived
+//    from this software without specific prior written permission. For written
+//    permission, please contact info@pixinsight.com.
+//
+// 4. All products derived from this software, in any form whatsoever, must
+//    reproduce the following acknowledgment in the end-user documentation
+//    and/or other materials provided with the product:
+//
+//    "This product is based on software from the PixInsight project, developed
+//    by Pleiades Astrophoto and its contributors (http://pixinsight.com/)."
+//
+//    Alternatively, if that is where third-party acknowledgments normally
+//    appear, this acknowledgment must be reproduced in the product itself.
+//
+// THIS SOFTWARE IS PROVIDED BY PLEIADES ASTROPHOTO AND ITS CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL PLEIADES ASTROPHOTO OR ITS
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, BUSINESS
+// INTERRUPTION; PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; AND LOSS OF USE,
+// DATA OR PROFITS) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// ----------------------------------------------------------------------------
+
+
+#ifndef __CFA2RGBEngine_h
+#define __CFA2RGBEngine_h
+
+#include <pcl/Array.h>
+#include <pcl/ByteArray.h>
+#include <pcl/Image.h>
+#include <pcl/ImageVariant.h>
+#include <pcl/MetaParameter.h> // for pcl_enum
+#include <pcl/Rectangle.h>
+
+#include "CFA2RGBParameters.h"
+
+namespace pcl
+{
+
+class CFA2RGBInstance;
+class CFA2RGBPattern;
+class CFA2RGBProgress;
+
+// ----------------------------------------------------------------------------
+
+/*
+ * Bit-packed per-channel coverage map of a sparse RGB image, as required for
+ * Bayer drizzle integration. Bit x of row y of a channel plane is set iff
+ * that channel has a CFA sample at (x,y). Bits are stored least significant
+ * first, and rows are padded to whole bytes.
+ */
+class CFA2RGBCoverageMap
+{
+public:
+
+   CFA2RGBCoverageMap() : m_width( 0 ), m_height( 0 ), m_rowBytes( 0 )
+   {
+   }
+
+   /*
+    * Sets the map geometry. Existing planes are reused when the geometry
+    * does not change.
+    */
+   void Allocate( int width, int height );
+
+   int Width() const
+   {
+      return m_width;
+   }
+
+   int Height() const
+   {
+      return m_height;
+   }
+
+   int RowBytes() const
+   {
+      return m_rowBytes;
+   }
+
+   bool IsCovered( int x, int y, int c ) const
+   {
+      return (Row( y, c )[x >> 3] >> (x & 7)) & 1;
+   }
+
+   uint8* Row( int y, int c )
+   {
+      return m_planes[c].Begin() + size_type( y )*m_rowBytes;
+   }
+
+   const uint8* Row( int y, int c ) const
+   {
+      return m_planes[c].Begin() + size_type( y )*m_rowBytes;
+   }
+
+   const ByteArray& Plane( int c ) const
+   {
+      return m_planes[c];
+   }
+
+private:
+
+   int       m_width;
+   int       m_height;
+   int       m_rowBytes;
+   ByteArray m_planes[ 3 ];
+};
+
+// ----------------------------------------------------------------------------
+
+/*
+ * Reduced-resolution versions of a converted image, generated in the same
+ * pass as the conversion.
+ *
+ * Level 0 is the superpixel image, with one pixel per CFA pattern cell (half
+ * size for Bayer patterns); each channel is the mean of the samples of that
+ * color within the cell. Every further level halves the previous one by 2x2
+ * averaging. Levels are 32-bit floating point RGB images in [0,1].
+ */
+class CFA2RGBPyramid
+{
+public:
+
+   enum { MaxLevels = 4 };
+
+   CFA2RGBPyramid( int levels = 3 ) : m_levels( Range( levels, 1, int( MaxLevels ) ) )
+   {
+   }
+
+   int NumberOfLevels() const
+   {
+      return m_levels;
+   }
+
+   /*
+    * Level i has 1/(period*2^i) the size of the converted image.
+    */
+   Image& Level( int i )
+   {
+      return m_level[i];
+   }
+
+   const Image& Level( int i ) const
+   {
+      return m_level[i];
+   }
+
+   /*
+    * Number of converted rows that determine a whole number of rows of every
+    * level.
+    */
+   int RowAlignment( int period ) const
+   {
+      return period << (m_levels - 1);
+   }
+
+   /*
+    * Sets the geometry of all levels for a converted image. Existing pixel
+    * data are reused when the geometry does not change.
+    */
+   void Allocate( int width, int height, int period );
+
+private:
+
+   int   m_levels;
+   Image m_level[ MaxLevels ];
+};
+
+// ----------------------------------------------------------------------------
+
+/*
+ * A frame of packed raw sensor data, as delivered by MIPI CSI-2 and GenICam
+ * cameras. Rows start at multiples of stride bytes; a zero stride stands for
+ * tightly packed rows.
+ */
+struct CFA2RGBPackedFrame
+{
+   const void* data;
+   int         width;
+   int         height;
+   size_type   stride;
+   pcl_enum    packing;   // a CFA2RGBRawPackingParameter item
+
+   CFA2RGBPackedFrame( const void* d, int w, int h, pcl_enum p, size_type s = 0 ) :
+   data( d ), width( w ), height( h ), stride( s ), packing( p )
+   {
+   }
+
+   /*
+    * Significant bits of an unpacked sample.
+    */
+   int BitsPerSample() const;
+
+   /*
+    * Bytes occupied by a tightly packed row. Rows are always padded to whole
+    * packing groups.
+    */
+   size_type RowBytes() const;
+
+   size_type Stride() const
+   {
+      return (stride != 0) ? stride : RowBytes();
+   }
+
+   size_type Size() const
+   {
+      return (height > 0) ? (height - 1)*Stride() + RowBytes() : 0;
+   }
+};
+
+// ----------------------------------------------------------------------------
+
+/*
+ * Radial magnification of a color channel relative to green, for lateral
+ * chromatic aberration correction. The channel value of a pixel at distance
+ * r from the optical center is sampled at distance r*Scale( r^2 ), where r is
+ * normalized to the half diagonal of the mosaic.
+ */
+struct CFA2RGBRadialScale
+{
+   double k0, k1, k2;
+
+   CFA2RGBRadialScale( double a0 = 0, double a1 = 0, double a2 = 0 ) : k0( a0 ), k1( a1 ), k2( a2 )
+   {
+   }
+
+   bool IsIdentity() const
+   {
+      return k0 == 0 && k1 == 0 && k2 == 0;
+   }
+
+   double Scale( double r2 ) const
+   {
+      return 1 + k0 + r2*(k1 + r2*k2);
+   }
+};
+
+// ----------------------------------------------------------------------------
+
+/*
+ * Matrix transforming camera RGB into a working color space. Output channel
+ * i is the sum of m[i][j] times camera channel j.
+ */
+struct CFA2RGBColorMatrix
+{
+   double m[ 3 ][ 3 ];
+
+   CFA2RGBColorMatrix()
+   {
+      for ( int i = 0; i < 3; ++i )
+         for ( int j = 0; j < 3; ++j )
+            m[i][j] = (i == j) ? 1 : 0;
+   }
+
+   /*
+    * From nine elements in row-major order.
+    */
+   CFA2RGBColorMatrix( const double* a )
+   {
+      for ( int i = 0; i < 3; ++i )
+         for ( int j = 0; j < 3; ++j )
+            m[i][j] = *a++;
+   }
+
+   bool IsIdentity() const
+   {
+      for ( int i = 0; i < 3; ++i )
+         for ( int j = 0; j < 3; ++j )
+            if ( m[i][j] != ((i == j) ? 1 : 0) )
+               return false;
+      return true;
+   }
+};
+
+// ----------------------------------------------------------------------------
+
+/*
+ * CFA2RGB conversion engine.
+ *
+ * Expands a single-channel CFA mosaic into a sparse RGB image: each channel
+ * keeps the samples of its own color and all remaining pixels are set to
+ * zero. Rows are distributed among the available processor threads.
+ */
+class CFA2RGBEngine
+{
+public:
+
+   CFA2RGBEngine( const CFA2RGBInstance& );
+   CFA2RGBEngine( pcl_enum bayerPattern, bool blockBinning = false,
+                  pcl_enum outputMode = CFA2RGBOutputModeParameter::RGB,
+                  pcl_enum interpolation = CFA2RGBInterpolationParameter::None );
+
+   /*
+    * In-place conversion. The first channel of the image is the CFA; on
+    * return the image is a three-channel RGB image. origin is the position
+    * of the image in the full CFA mosaic (for example, the position of a
+    * preview in its main view), which determines the pattern phase.
+    */
+   void Convert( ImageVariant& image, const Point& origin = Point( 0 ), CFA2RGBCoverageMap* coverage = 0,
+                 CFA2RGBPyramid* pyramid = 0 ) const;
+
+   /*
+    * Out-of-place conversion. The target image is given the sample type of
+    * the CFA image; its pixel data are only reallocated when the geometry
+    * changes, so repeated conversions of equally sized frames reuse them.
+    *
+    * All conversion functions optionally generate a coverage map and a
+    * multi-resolution pyramid of the output image in the same pass.
+    */
+   void Convert( ImageVariant& rgb, const ImageVariant& cfa, CFA2RGBCoverageMap* coverage = 0,
+                 CFA2RGBPyramid* pyramid = 0 ) const;
+
+   /*
+    * Region-of-interest conversion. Only the specified rectangle of cfa is
+    * converted; the target image is given the size of the rectangle, and the
+    * pattern phase is taken from its position in cfa, offset by origin, the
+    * position of cfa in the full mosaic.
+    */
+   void Convert( ImageVariant& rgb, const ImageVariant& cfa, const Rect& roi, const Point& origin = Point( 0 ),
+                 CFA2RGBCoverageMap* coverage = 0, CFA2RGBPyramid* pyramid = 0 ) const;
+
+   /*
+    * Conversion of packed raw sensor data. Each row is unpacked into a small
+    * per-thread buffer and expanded in the same pass, so the 16-bit mosaic is
+    * never materialized. The target is a 16-bit RGB image, with samples
+    * scaled to the full 16-bit range. Block binning is not available for
+    * packed frames.
+    */
+   void Convert( ImageVariant& rgb, const CFA2RGBPackedFrame& frame, CFA2RGBCoverageMap* coverage = 0,
+                 CFA2RGBPyramid* pyramid = 0 ) const;
+
+   /*
+    * Incremental conversion. Recomputes only the parts of rgb, the result of
+    * a previous out-of-place conversion of cfa, that depend on the specified
+    * dirty CFA rectangles. A full conversion is performed instead if rgb does
+    * not match the geometry and sample type of cfa. Returns the number of
+    * pixels recomputed.
+    */
+   size_type Update( ImageVariant& rgb, const ImageVariant& cfa, const Array<Rect>& dirty,
+                     CFA2RGBCoverageMap* coverage = 0 ) const;
+
+   /*
+    * True if Update() can recompute parts of rgb, rather than performing a
+    * complete conversion of cfa.
+    */
+   bool CanUpdate( const ImageVariant& rgb, const ImageVariant& cfa ) const;
+
+   /*
+    * The areas that Update() recomputes for a list of dirty rectangles: each
+    * rectangle is grown by Halo() pixels, aligned to the CFA period and
+    * clipped to the image, then split at tile boundaries. The returned
+    * rectangles are disjoint, at most one per tile.
+    */
+   Array<Rect> DirtyTiles( const Array<Rect>& dirty, int width, int height ) const;
+
+   const CFA2RGBPattern& Pattern() const
+   {
+      return *m_pattern;
+   }
+
+   /*
+    * True if blocks of same-color pixels of a quad-Bayer or nonacell mosaic
+    * are averaged into a Bayer-sampled image of reduced size. Incremental
+    * updates of binned output always perform a full conversion.
+    */
+   bool IsBinning() const;
+
+   /*
+    * True if the output is a single-channel green image instead of sparse
+    * RGB planes. Red and blue sites are filled with the mean of their
+    * nearest green neighbors, or, in superpixel mode, each pattern cell
+    * yields the mean of its green samples. Block binning, coverage maps and
+    * pyramids do not apply to green output.
+    */
+   bool IsGreenOutput() const;
+
+   bool IsSuperpixelOutput() const;
+
+   /*
+    * Cell binning: the samples at each position of the CFA pattern are
+    * averaged or summed over groups of factor x factor pattern cells, which
+    * yields a mosaic with the same pattern and 1/factor of the original
+    * dimensions. The binned mosaic is either expanded into sparse RGB planes
+    * or returned as a single-channel CFA image. Sums saturate at the maximum
+    * sample value. Cell binning does not apply to green output and block
+    * binning, and binned output is not interpolated.
+    */
+   void SetCellBinning( int factor, bool sum = false, bool cfaOutput = false )
+   {
+      m_cellBinning = Range( factor, 1, 3 );
+      m_cellBinningSum = sum;
+      m_cellBinningCFA = cfaOutput;
+   }
+
+   bool IsCellBinning() const;
+
+   int CellBinningFactor() const
+   {
+      return IsCellBinning() ? m_cellBinning : 1;
+   }
+
+   bool IsCellBinningSum() const
+   {
+      return m_cellBinningSum;
+   }
+
+   /*
+    * True if the output is a binned single-channel CFA mosaic.
+    */
+   bool IsCFAOutput() const;
+
+   /*
+    * True if missing samples of RGB output are interpolated instead of left
+    * at zero. Bilinear interpolation averages the nearest sites of each
+    * channel; gradient interpolation uses only the horizontal or vertical
+    * pair of a directional neighbor set (see CFA2RGBPattern::Neighbors),
+    * whichever differs least. Block-binned output is not interpolated.
+    *
+    * 8-bit and 16-bit integer images are interpolated with integer
+    * arithmetic only, with the same rounded results as the floating point
+    * kernels.
+    */
+   bool IsInterpolating() const;
+
+   bool IsGradientInterpolation() const;
+
+   /*
+    * Lateral chromatic aberration correction, fused with interpolation: the
+    * red and blue channels of each output pixel are resampled at radially
+    * scaled positions, bilinearly from the interpolated values of the four
+    * surrounding pixels, computed from the original CFA samples. Only done
+    * when interpolating. Incremental updates perform a full conversion.
+    */
+   void SetLateralCACorrection( const CFA2RGBRadialScale& red, const CFA2RGBRadialScale& blue )
+   {
+      m_redScale = red;
+      m_blueScale = blue;
+   }
+
+   bool IsCorrectingLateralCA() const;
+
+   const CFA2RGBRadialScale& RedScale() const
+   {
+      return m_redScale;
+   }
+
+   const CFA2RGBRadialScale& BlueScale() const
+   {
+      return m_blueScale;
+   }
+
+   /*
+    * Dimensions of the full CFA mosaic, whose center is the optical center
+    * for lateral CA correction, when an in-place conversion is applied to a
+    * part of it (such as a preview). Zero, the default, stands for the
+    * dimensions of the image being converted.
+    */
+   void SetMosaicDimensions( int width, int height )
+   {
+      m_mosaicWidth = Max( 0, width );
+      m_mosaicHeight = Max( 0, height );
+   }
+
+   int MosaicWidth() const
+   {
+      return m_mosaicWidth;
+   }
+
+   int MosaicHeight() const
+   {
+      return m_mosaicHeight;
+   }
+
+   /*
+    * Color matrix applied by the interpolation threads to each output row,
+    * right after its three channels have been interpolated, so that output
+    * in the working color space costs no separate pass. Only interpolated
+    * RGB output is color managed: sparse and binned outputs are left in
+    * camera RGB.
+    */
+   void SetColorMatrix( const CFA2RGBColorMatrix& matrix )
+   {
+      m_colorMatrix = matrix;
+   }
+
+   const CFA2RGBColorMatrix& ColorMatrix() const
+   {
+      return m_colorMatrix;
+   }
+
+   bool IsApplyingColorMatrix() const;
+
+   /*
+    * Limits the number of threads used by each conversion, for engines that
+    * run concurrently. Zero, the default, uses all available processors.
+    */
+   void SetMaxThreads( int n )
+   {
+      m_maxThreads = Max( 0, n );
+   }
+
+   int MaxThreads() const
+   {
+      return m_maxThreads;
+   }
+
+   /*
+    * Progress object updated by conversions, which stop with ProcessAborted
+    * once it has been aborted. Zero, the default, disables both progress
+    * reporting and cancellation. Not owned by the engine.
+    */
+   void SetProgress( CFA2RGBProgress* progress )
+   {
+      m_progress = progress;
+   }
+
+   CFA2RGBProgress* Progress() const
+   {
+      return m_progress;
+   }
+
+   /*
+    * Horizontal and vertical period of the CFA pattern, in pixels.
+    */
+   int Period() const;
+
+   /*
+    * Period of the pattern sampled by the output image, which is that of the
+    * binned pattern when binning.
+    */
+   int OutputPeriod() const;
+
+   /*
+    * Dimensions of the output image for a mosaic of the specified size whose
+    * origin is at a pattern cell boundary.
+    */
+   void GetOutputDimensions( int& outputWidth, int& outputHeight, int width, int height ) const;
+
+   int OutputChannels() const
+   {
+      return (IsGreenOutput() || IsCFAOutput()) ? 1 : 3;
+   }
+
+   /*
+    * Distance in pixels from which CFA samples contribute to an output pixel.
+    * The sparse expansion does not read neighbor samples; interpolation reads
+    * the nearest sites of each channel.
+    */
+   int Halo() const;
+
+private:
+
+   const CFA2RGBPattern* m_pattern;
+   bool                  m_blockBinning;
+   pcl_enum              m_outputMode;
+   pcl_enum              m_interpolation;
+   int                   m_maxThreads;
+   CFA2RGBProgress*      m_progress;
+   CFA2RGBRadialScale    m_redScale;
+   CFA2RGBRadialScale    m_blueScale;
+   int                   m_mosaicWidth;
+   int                   m_mosaicHeight;
+   CFA2RGBColorMatrix    m_colorMatrix;
+   int                   m_cellBinning;
+   bool                  m_cellBinningSum;
+   bool                  m_cellBinningCFA;
+};
+
+// ----------------------------------------------------------------------------
+
+} // pcl
+
+#endif   // __CFA2RGBEngine_h
+
+// ****************************************************************************
+// EOF CFA2RGBEngine.h - Released 2016/02/03 00:00:00 UTC
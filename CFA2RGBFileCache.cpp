@@ -0,0 +1,287 @@
+//     ____   ______ __
+//    / __ \ / ____// /
+//   / /_/ // /    / /
+//  / ____// /___ / /___   PixInsight Class Library
+// /_/     \____//_____/   PCL 02.01.00.0779
+// ----------------------------------------------------------------------------
+// Standard CFA2RGB Process Module Version 01.01.01.0010
+// ----------------------------------------------------------------------------
+// CFA2RGBFileCache.cpp - Released 2016/02/03 00:00:00 UTC
+// ----------------------------------------------------------------------------
+// This file is part of the standard CFA2RGB PixInsight module.
+//
+// Copyright (c) 2003-2016 Pleiades Astrophoto S.L. All Rights Reserved.
+//
+// Redistribution and use in both source and binary forms, with or without
+// modification, is permitted provided that the following conditions are met:
+//
+// 1. All redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. All redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the names "PixInsight" and "Pleiades Astrophoto", nor the names
+//    of their contributors, may be used to endorse or promote products derived
+//    from this software without specific prior written permission. For written
+//    permission, please contact info@pixinsight.com.
+//
+// 4. All products derived from this software, in any form whatsoever, must
+//    reproduce the following acknowledgment in the end-user documentation
+//    and/or other materials provided with the product:
+//
+//    "This product is based on software from the PixInsight project, developed
+//    by Pleiades Astrophoto and its contributors (http://pixinsight.com/)."
+//
+//    Alternatively, if that is where third-party acknowledgments normally
+//    appear, this acknowledgment must be reproduced in the product itself.
+//
+// THIS SOFTWARE IS PROVIDED BY PLEIADES ASTROPHOTO AND ITS CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL PLEIADES ASTROPHOTO OR ITS
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, BUSINESS
+// INTERRUPTION; PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; AND LOSS OF USE,
+// DATA OR PROFITS) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// ----------------------------------------------------------------------------
+
+
+#include "CFA2RGBFileCache.h"
+
+#include <pcl/Cryptography.h>
+#include <pcl/File.h>
+#include <pcl/FileInfo.h>
+
+namespace pcl
+{
+
+// ----------------------------------------------------------------------------
+
+/*
+ * Size of the blocks read by HashFile().
+ */
+static const size_type s_hashBlockSize = 4*1024*1024;
+
+static IsoString TimeStamp( const FileInfo& info )
+{
+   FileTime t = info.LastModified();
+   return IsoString().Format( "%04d%02d%02d%02d%02d%02d.%03d",
+                              int( t.year ), int( t.month ), int( t.day ),
+                              int( t.hour ), int( t.minute ), int( t.second ), int( t.milliseconds ) );
+}
+
+static IsoString EscapeField( const IsoString& s )
+{
+   IsoString e;
+   for ( IsoString::const_iterator i = s.Begin(); i != s.End(); ++i )
+      switch ( *i )
+      {
+      case '\\': e += "\\\\"; break;
+      case '\t': e += "\\t"; break;
+      case '\n': e += "\\n"; break;
+      case '\r': e += "\\r"; break;
+      default:   e += *i; break;
+      }
+   return e;
+}
+
+/*
+ * Returns false if the field contains an invalid escape sequence.
+ */
+static bool UnescapeField( IsoString& s, const IsoString& e )
+{
+   s.Clear();
+   for ( IsoString::const_iterator i = e.Begin(); i != e.End(); ++i )
+   {
+      if ( *i != '\\' )
+      {
+         s += *i;
+         continue;
+      }
+      if ( ++i == e.End() )
+         return false;
+      switch ( *i )
+      {
+      case '\\': s += '\\'; break;
+      case 't':  s += '\t'; break;
+      case 'n':  s += '\n'; break;
+      case 'r':  s += '\r'; break;
+      default:   return false;
+      }
+   }
+   return true;
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBFileCache::CFA2RGBFileCache( const String& indexFilePath ) : m_indexFilePath( indexFilePath )
+{
+   if ( !File::Exists( m_indexFilePath ) )
+      return;
+
+   try
+   {
+      IsoStringList lines;
+      File::ReadTextFile( m_indexFilePath ).Break( lines, '\n' );
+      for ( IsoStringList::const_iterator i = lines.Begin(); i != lines.End(); ++i )
+      {
+         // Not trimmed: paths may begin or end with spaces.
+         IsoString line = *i;
+         if ( line.EndsWith( '\r' ) )
+            line.DeleteRight( line.Length()-1 );
+
+         IsoStringList fields;
+         line.Break( fields, '\t' );
+         if ( fields.Length() != 7 )
+            continue;
+
+         IsoString inputPath, outputPath;
+         Entry e;
+         if ( !UnescapeField( inputPath, fields[0] ) ||
+              !UnescapeField( e.inputTime, fields[2] ) ||
+              !UnescapeField( e.contentHash, fields[3] ) ||
+              !UnescapeField( e.settings, fields[4] ) ||
+              !UnescapeField( outputPath, fields[5] ) )
+            continue;
+         e.inputPath   = inputPath.UTF8ToUTF16();
+         e.inputSize   = fields[1].ToUInt64();
+         e.outputPath  = outputPath.UTF8ToUTF16();
+         e.outputSize  = fields[6].ToUInt64();
+         Set( e );
+      }
+   }
+   catch ( ... )
+   {
+      m_entries.Clear();
+   }
+}
+
+bool CFA2RGBFileCache::IsValid( const String& inputPath, const IsoString& settings )
+{
+   SortedArray<Entry>::const_iterator e = m_entries.Search( Entry( inputPath ) );
+   if ( e == m_entries.End() || e->settings != settings || !IsOutputValid( *e ) )
+      return false;
+
+   FileInfo input( inputPath );
+   return input.Exists() && input.Size() == e->inputSize && TimeStamp( input ) == e->inputTime;
+}
+
+bool CFA2RGBFileCache::IsValid( const String& inputPath, const IsoString& contentHash, const IsoString& settings )
+{
+   /*
+    * The entry of the same path, if any, is checked first: the file may only
+    * have been touched.
+    */
+   SortedArray<Entry>::const_iterator e = m_entries.Search( Entry( inputPath ) );
+   if ( e == m_entries.End() || e->contentHash != contentHash || e->settings != settings || !IsOutputValid( *e ) )
+      for ( e = m_entries.Begin(); e != m_entries.End(); ++e )
+         if ( e->contentHash == contentHash && e->settings == settings && IsOutputValid( *e ) )
+            break;
+   if ( e == m_entries.End() )
+      return false;
+
+   FileInfo input( inputPath );
+   Entry updated = *e;
+   updated.inputPath = inputPath;
+   updated.inputSize = input.Size();
+   updated.inputTime = TimeStamp( input );
+   Set( updated );
+   Append( updated );
+   return true;
+}
+
+void CFA2RGBFileCache::Add( const String& inputPath, const IsoString& contentHash, const IsoString& settings,
+                            const String& outputPath )
+{
+   FileInfo input( inputPath );
+   Entry e( inputPath );
+   e.inputSize   = input.Size();
+   e.inputTime   = TimeStamp( input );
+   e.contentHash = contentHash;
+   e.settings    = settings;
+   e.outputPath  = outputPath;
+   e.outputSize  = FileInfo( outputPath ).Size();
+   Set( e );
+   Append( e );
+}
+
+void CFA2RGBFileCache::Compact() const
+{
+   IsoString text;
+   for ( SortedArray<Entry>::const_iterator i = m_entries.Begin(); i != m_entries.End(); ++i )
+   {
+      text += EntryLine( *i );
+      text += '\n';
+   }
+   File::WriteTextFile( m_indexFilePath, text );
+}
+
+IsoString CFA2RGBFileCache::Hash( const void* data, size_type size )
+{
+   SHA1 hash;
+   hash.Initialize();
+   hash.Update( data, size );
+   return IsoString::ToHex( hash.Finalize() );
+}
+
+IsoString CFA2RGBFileCache::HashFile( const String& filePath )
+{
+   SHA1 hash;
+   hash.Initialize();
+
+   File file = File::OpenFileForReading( filePath );
+   ByteArray buffer( s_hashBlockSize );
+   for ( int64 remaining = file.Size(); remaining > 0; )
+   {
+      size_type size = size_type( Min( remaining, int64( s_hashBlockSize ) ) );
+      file.Read( buffer.Begin(), size );
+      hash.Update( buffer.Begin(), size );
+      remaining -= size;
+   }
+   file.Close();
+
+   return IsoString::ToHex( hash.Finalize() );
+}
+
+void CFA2RGBFileCache::Set( const Entry& e )
+{
+   m_entries.Remove( e );
+   m_entries.Add( e );
+}
+
+void CFA2RGBFileCache::Append( const Entry& e ) const
+{
+   File file = File::OpenOrCreateFileForWriting( m_indexFilePath );
+   file.SeekEnd( 0 );
+   file.OutTextLn( EntryLine( e ) );
+   file.Close();
+}
+
+bool CFA2RGBFileCache::IsOutputValid( const Entry& e )
+{
+   FileInfo output( e.outputPath );
+   return output.Exists() && output.Size() == e.outputSize;
+}
+
+IsoString CFA2RGBFileCache::EntryLine( const Entry& e )
+{
+   return EscapeField( e.inputPath.ToUTF8() ) + '\t'
+        + IsoString().Format( "%llu", e.inputSize ) + '\t'
+        + EscapeField( e.inputTime ) + '\t'
+        + EscapeField( e.contentHash ) + '\t'
+        + EscapeField( e.settings ) + '\t'
+        + EscapeField( e.outputPath.ToUTF8() ) + '\t'
+        + IsoString().Format( "%llu", e.outputSize );
+}
+
+// ----------------------------------------------------------------------------
+
+} // pcl
+
+// ****************************************************************************
+// EOF CFA2RGBFileCache.cpp - Released 2016/02/03 00:00:00 UTC
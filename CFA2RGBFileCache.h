@@ -0,0 +1,177 @@
+//     ____   ______ __
+//    / __ \ / ____// /
+//   / /_/ // /    / /
+//  / ____// /___ / /___   PixInsight Class Library
+// /_/     \____//_____/   PCL 02.01.00.0779
+// ----------------------------------------------------------------------------
+// Standard CFA2RGB Process Module Version 01.01.01.0010
+// ----------------------------------------------------------------------------
+// CFA2RGBFileCache.h - Released 2016/02/03 00:00:00 UTC
+// ----------------------------------------------------------------------------
+// This file is part of the standard CFA2RGB PixInsight module.
+//
+// Copyright (c) 2003-2016 Pleiades Astrophoto S.L. All Rights Reserved.
+//
+// Redistribution and use in both source and binary forms, with or without
+// modification, is permitted provided that the following conditions are met:
+//
+// 1. All redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. All redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the names "PixInsight" and "Pleiades Astrophoto", nor the names
+//    of their contributors, may be used to endorse or promote products derived
+//    from this software without specific prior written permission. For written
+//    permission, please contact info@pixinsight.com.
+//
+// 4. All products derived from this software, in any form whatsoever, must
+//    reproduce the following acknowledgment in the end-user documentation
+//    and/or other materials provided with the product:
+//
+//    "This product is based on software from the PixInsight project, developed
+//    by Pleiades Astrophoto and its contributors (http://pixinsight.com/)."
+//
+//    Alternatively, if that is where third-party acknowledgments normally
+//    appear, this acknowledgment must be reproduced in the product itself.
+//
+// THIS SOFTWARE IS PROVIDED BY PLEIADES ASTROPHOTO AND ITS CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL PLEIADES ASTROPHOTO OR ITS
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, BUSINESS
+// INTERRUPTION; PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; AND LOSS OF USE,
+// DATA OR PROFITS) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// ----------------------------------------------------------------------------
+
+
+#ifndef __CFA2RGBFileCache_h
+#define __CFA2RGBFileCache_h
+
+#include <pcl/SortedArray.h>
+#include <pcl/String.h>
+
+namespace pcl
+{
+
+// ----------------------------------------------------------------------------
+
+/*
+ * On-disk index of the frames converted in batch mode, used to skip frames
+ * whose output files are still valid when a batch is run again.
+ *
+ * Each entry binds an input file, identified by the SHA-1 hash of its
+ * contents, and a settings signature to the output file generated from them.
+ * Entries are found by input path, as long as the size and modification time
+ * of the file are unchanged, and otherwise by content hash, so that moved or
+ * renamed input files still match the output files converted from them.
+ * Entries are appended to the index file as soon as their output files have
+ * been written, so an interrupted batch keeps the work already done; the
+ * last entry for an input file supersedes any previous ones. Entries are
+ * lines of tab-separated fields, with backslashes, tabs and line breaks in
+ * the fields escaped as in C string literals.
+ */
+class CFA2RGBFileCache
+{
+public:
+
+   struct Entry
+   {
+      String    inputPath;
+      uint64    inputSize;
+      IsoString inputTime;   // modification time stamp
+      IsoString contentHash;
+      IsoString settings;
+      String    outputPath;
+      uint64    outputSize;
+
+      Entry( const String& path = String() ) : inputPath( path ), inputSize( 0 ), outputSize( 0 )
+      {
+      }
+
+      bool operator ==( const Entry& x ) const
+      {
+         return inputPath == x.inputPath;
+      }
+
+      bool operator <( const Entry& x ) const
+      {
+         return inputPath < x.inputPath;
+      }
+   };
+
+   /*
+    * Loads the index file, if it exists. A damaged index is discarded.
+    */
+   CFA2RGBFileCache( const String& indexFilePath );
+
+   const String& IndexFilePath() const
+   {
+      return m_indexFilePath;
+   }
+
+   /*
+    * Returns true if the input file has already been converted with the
+    * specified settings, under the same path, size and modification time,
+    * and its output file is unchanged. The file is not read.
+    */
+   bool IsValid( const String& inputPath, const IsoString& settings );
+
+   /*
+    * Returns true if a file with the specified contents has already been
+    * converted with the specified settings, under any path, and its output
+    * file is unchanged. The input path is then recorded as another name of
+    * that file. The caller computes the hash from the data it has read, or
+    * with HashFile().
+    */
+   bool IsValid( const String& inputPath, const IsoString& contentHash, const IsoString& settings );
+
+   /*
+    * Records a converted frame and appends it to the index file. The input
+    * and output file sizes and times are taken from the file system.
+    */
+   void Add( const String& inputPath, const IsoString& contentHash, const IsoString& settings,
+             const String& outputPath );
+
+   /*
+    * Rewrites the index file with one entry per input file.
+    */
+   void Compact() const;
+
+   /*
+    * Hexadecimal SHA-1 digest of a memory block.
+    */
+   static IsoString Hash( const void* data, size_type size );
+
+   /*
+    * Hexadecimal SHA-1 digest of a file, read sequentially in blocks. Hashing
+    * a file just before decoding it leaves its contents in the system file
+    * cache, so the decoder does not read it from the disk again.
+    */
+   static IsoString HashFile( const String& filePath );
+
+private:
+
+   String              m_indexFilePath;
+   SortedArray<Entry>  m_entries;
+
+   void Set( const Entry& );
+   void Append( const Entry& ) const;
+   static bool IsOutputValid( const Entry& );
+   static IsoString EntryLine( const Entry& );
+};
+
+// ----------------------------------------------------------------------------
+
+} // pcl
+
+#endif   // __CFA2RGBFileCache_h
+
+// ****************************************************************************
+// EOF CFA2RGBFileCache.h - Released 2016/02/03 00:00:00 UTC
@@ -0,0 +1,280 @@
+//     ____   ______ __
+//    / __ \ / ____// /
+//   / /_/ // /    / /
+//  / ____// /___ / /___   PixInsight Class Library
+// /_/     \____//_____/   PCL 02.01.00.0779
+// ----------------------------------------------------------------------------
+// Standard CFA2RGB Process Module Version 01.01.01.0010
+// ----------------------------------------------------------------------------
+// CFA2RGBFrameQueue.cpp - Released 2016/02/03 00:00:00 UTC
+// ----------------------------------------------------------------------------
+// This file is part of the standard CFA2RGB PixInsight module.
+//
+// Copyright (c) 2003-2016 Pleiades Astrophoto S.L. All Rights Reserved.
+//
+// Redistribution and use in both source and binary forms, with or without
+// modification, is permitted provided that the following conditions are met:
+//
+// 1. All redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. All redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the names "PixInsight" and "Pleiades Astrophoto", nor the names
+//    of their contributors, may be used to endorse or promote products derived
+//    from this software without specific prior written permission. For written
+//    permission, please contact info@pixinsight.com.
+//
+// 4. All products derived from this software, in any form whatsoever, must
+//    reproduce the following acknowledgment in the end-user documentation
+//    and/or other materials provided with the product:
+//
+//    "This product is based on software from the PixInsight project, developed
+//    by Pleiades Astrophoto and its contributors (http://pixinsight.com/)."
+//
+//    Alternatively, if that is where third-party acknowledgments normally
+//    appear, this acknowledgment must be reproduced in the product itself.
+//
+// THIS SOFTWARE IS PROVIDED BY PLEIADES ASTROPHOTO AND ITS CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL PLEIADES ASTROPHOTO OR ITS
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, BUSINESS
+// INTERRUPTION; PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; AND LOSS OF USE,
+// DATA OR PROFITS) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// ----------------------------------------------------------------------------
+
+
+#include "CFA2RGBFrameQueue.h"
+#include "CFA2RGBProgress.h"
+
+#include <pcl/Exception.h>
+#include <pcl/Thread.h>
+
+namespace pcl
+{
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBFrameQueueThread : public Thread
+{
+public:
+
+   CFA2RGBFrameQueueThread( CFA2RGBFrameQueue& queue ) : Thread(), m_queue( queue )
+   {
+   }
+
+   virtual void Run()
+   {
+      m_queue.Process();
+   }
+
+private:
+
+   CFA2RGBFrameQueue& m_queue;
+};
+
+// ----------------------------------------------------------------------------
+
+static double Seconds( std::chrono::steady_clock::duration d )
+{
+   return std::chrono::duration<double>( d ).count();
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBFrameQueue::CFA2RGBFrameQueue( const CFA2RGBEngine& engine, int depth ) :
+m_engine( engine ),
+m_depth( Range( depth, 1, 3 ) ),
+m_head( 0 ),
+m_count( 0 ),
+m_converted( 0 ),
+m_serial( 0 ),
+m_stop( false ),
+m_thread( 0 )
+{
+   m_thread = new CFA2RGBFrameQueueThread( *this );
+   m_thread->Start( ThreadPriority::DefaultMax );
+}
+
+CFA2RGBFrameQueue::~CFA2RGBFrameQueue()
+{
+   {
+      std::lock_guard<std::mutex> lock( m_mutex );
+      m_stop = true;
+   }
+   m_notEmpty.notify_all();
+   m_thread->Wait();
+   delete m_thread;
+}
+
+int CFA2RGBFrameQueue::Count() const
+{
+   std::lock_guard<std::mutex> lock( m_mutex );
+   return m_count;
+}
+
+uint64 CFA2RGBFrameQueue::Submit( const Frame& frame )
+{
+   uint64 serial;
+   Enqueue( frame, true/*wait*/, serial );
+   return serial;
+}
+
+bool CFA2RGBFrameQueue::TrySubmit( const Frame& frame, uint64& serial )
+{
+   return Enqueue( frame, false/*wait*/, serial );
+}
+
+bool CFA2RGBFrameQueue::Receive( Frame& frame )
+{
+   std::unique_lock<std::mutex> lock( m_mutex );
+   if ( m_count == 0 )
+      return false;
+   Wait( lock, [this]{ return m_converted > 0; } );
+
+   // Release the shared image and raw data as soon as they are handed over.
+   Slot& slot = m_slots[m_head];
+   frame = slot.frame;
+   slot.frame = Frame();
+   m_head = (m_head + 1) % m_depth;
+   --m_count;
+   --m_converted;
+   lock.unlock();
+
+   m_changed.notify_all();
+   return true;
+}
+
+CFA2RGBFrameQueue::Statistics CFA2RGBFrameQueue::GetStatistics() const
+{
+   std::lock_guard<std::mutex> lock( m_mutex );
+   return m_stats;
+}
+
+// ----------------------------------------------------------------------------
+
+bool CFA2RGBFrameQueue::Enqueue( const Frame& frame, bool wait, uint64& serial )
+{
+   clock::time_point submitted = clock::now();
+
+   std::unique_lock<std::mutex> lock( m_mutex );
+   if ( m_count == m_depth )
+   {
+      if ( !wait )
+      {
+         ++m_stats.rejected;
+         return false;
+      }
+      Wait( lock, [this]{ return m_count < m_depth; } );
+      m_stats.blockedTime += Seconds( clock::now() - submitted );
+   }
+
+   Slot& slot = m_slots[(m_head + m_count) % m_depth];
+   slot.frame = frame;
+   serial = slot.frame.serial = m_serial++;
+   slot.submitted = submitted;
+   ++m_count;
+   ++m_stats.submitted;
+   lock.unlock();
+
+   m_notEmpty.notify_one();
+   return true;
+}
+
+/*
+ * Only the root thread can poll the progress object; other threads just wait.
+ */
+template <class Predicate>
+void CFA2RGBFrameQueue::Wait( std::unique_lock<std::mutex>& lock, Predicate ready )
+{
+   CFA2RGBProgress* progress = m_engine.Progress();
+   if ( progress != 0 && Thread::IsRootThread() )
+   {
+      while ( !m_changed.wait_for( lock, std::chrono::milliseconds( CFA2RGBProgress::PollInterval ), ready ) )
+      {
+         lock.unlock();
+         progress->Poll();
+         lock.lock();
+      }
+   }
+   else
+      m_changed.wait( lock, ready );
+}
+
+/*
+ * Runs on the dispatcher thread. The conversion itself is split into tasks
+ * run by the shared worker pool, and the dispatcher runs tasks of its own
+ * conversion while it waits for them.
+ */
+void CFA2RGBFrameQueue::Process()
+{
+   for ( ;; )
+   {
+      std::unique_lock<std::mutex> lock( m_mutex );
+      m_notEmpty.wait( lock, [this]{ return m_converted < m_count || m_stop; } );
+      if ( m_stop )
+         return;
+      Slot& slot = m_slots[(m_head + m_converted) % m_depth];
+      lock.unlock();
+
+      Frame& frame = slot.frame;
+      clock::time_point start = clock::now();
+      try
+      {
+         CFA2RGBProgress* progress = m_engine.Progress();
+         if ( progress != 0 && progress->IsAborted() )
+            throw ProcessAborted();
+
+         CFA2RGBEngine engine( m_engine );
+         if ( frame.hasMatrix )
+            engine.SetColorMatrix( frame.matrix );
+         if ( frame.raw.IsEmpty() )
+            engine.Convert( frame.image, Point( 0 ), frame.coverage, frame.pyramid );
+         else
+         {
+            // Through a constant array, so that shared raw data are not copied.
+            const ByteArray& raw = frame.raw;
+            CFA2RGBPackedFrame packed( raw.Begin(), frame.packed.width, frame.packed.height,
+                                       frame.packed.packing, frame.packed.stride );
+            engine.Convert( frame.image, packed, frame.coverage, frame.pyramid );
+         }
+      }
+      catch ( ... )
+      {
+         // Returned to the receiver; a failed frame must not stall the queue.
+         frame.error = std::current_exception();
+      }
+      clock::time_point end = clock::now();
+      frame.latency = Seconds( end - slot.submitted );
+      frame.conversionTime = Seconds( end - start );
+
+      lock.lock();
+      ++m_converted;
+      if ( frame.error )
+         ++m_stats.failed;
+      else
+      {
+         uint64 n = ++m_stats.converted;
+         m_stats.meanLatency += (frame.latency - m_stats.meanLatency)/n;
+         m_stats.meanConversion += (frame.conversionTime - m_stats.meanConversion)/n;
+         m_stats.maxLatency = Max( m_stats.maxLatency, frame.latency );
+      }
+      lock.unlock();
+
+      m_changed.notify_all();
+   }
+}
+
+// ----------------------------------------------------------------------------
+
+} // pcl
+
+// ****************************************************************************
+// EOF CFA2RGBFrameQueue.cpp - Released 2016/02/03 00:00:00 UTC
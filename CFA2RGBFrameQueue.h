@@ -0,0 +1,215 @@
+//     ____   ______ __
+//    / __ \ / ____// /
+//   / /_/ // /    / /
+//  / ____// /___ / /___   PixInsight Class Library
+// /_/     \____//_____/   PCL 02.01.00.0779
+// ----------------------------------------------------------------------------
+// Standard CFA2RGB Process Module Version 01.01.01.0010
+// ----------------------------------------------------------------------------
+// CFA2RGBFrameQueue.h - Released 2016/02/03 00:00:00 UTC
+// ----------------------------------------------------------------------------
+// This file is part of the standard CFA2RGB PixInsight module.
+//
+// Copyright (c) 2003-2016 Pleiades Astrophoto S.L. All Rights Reserved.
+//
+// Redistribution and use in both source and binary forms, with or without
+// modification, is permitted provided that the following conditions are met:
+//
+// 1. All redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. All redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the names "PixInsight" and "Pleiades Astrophoto", nor the names
+//    of their contributors, may be used to endorse or promote products derived
+//    from this software without specific prior written permission. For written
+//    permission, please contact info@pixinsight.com.
+//
+// 4. All products derived from this software, in any form whatsoever, must
+//    reproduce the following acknowledgment in the end-user documentation
+//    and/or other materials provided with the product:
+//
+//    "This product is based on software from the PixInsight project, developed
+//    by Pleiades Astrophoto and its contributors (http://pixinsight.com/)."
+//
+//    Alternatively, if that is where third-party acknowledgments normally
+//    appear, this acknowledgment must be reproduced in the product itself.
+//
+// THIS SOFTWARE IS PROVIDED BY PLEIADES ASTROPHOTO AND ITS CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL PLEIADES ASTROPHOTO OR ITS
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, BUSINESS
+// INTERRUPTION; PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; AND LOSS OF USE,
+// DATA OR PROFITS) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// ----------------------------------------------------------------------------
+
+
+#ifndef __CFA2RGBFrameQueue_h
+#define __CFA2RGBFrameQueue_h
+
+#include <pcl/ByteArray.h>
+#include <pcl/ImageVariant.h>
+
+#include "CFA2RGBEngine.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+
+namespace pcl
+{
+
+class CFA2RGBFrameQueueThread;
+
+// ----------------------------------------------------------------------------
+
+/*
+ * Bounded asynchronous conversion queue.
+ *
+ * Frames are submitted by a producer thread, such as a camera capture loop
+ * or the batch reader, and converted in submission order on a dispatcher
+ * thread whose conversion tasks run on the shared worker pool. Converted
+ * frames are received back in the same order. A frame takes one of a fixed
+ * number of slots (double or triple buffering) from submission until it has
+ * been received: when all slots are in use, Submit() blocks (backpressure),
+ * while TrySubmit() returns false instead, letting the caller drop the frame.
+ *
+ * Frames are shared, not copied: the producer must not modify a submitted
+ * image or raw buffer until the frame has been received.
+ */
+class CFA2RGBFrameQueue
+{
+public:
+
+   struct Frame
+   {
+      size_type           index;          // caller data, returned unchanged
+      ImageVariant        image;          // CFA mosaic, converted in place; output of a packed frame
+      ByteArray           raw;            // packed raw data; converted instead of image if not empty
+      CFA2RGBPackedFrame  packed;         // geometry of the packed raw data
+      bool                hasMatrix;      // matrix replaces the color matrix of the engine
+      CFA2RGBColorMatrix  matrix;
+      CFA2RGBCoverageMap* coverage;       // optional, owned by the caller
+      CFA2RGBPyramid*     pyramid;        // optional, owned by the caller
+
+      uint64              serial;         // set by Submit()
+      double              latency;        // s, submission to end of conversion
+      double              conversionTime; // s, conversion alone
+      std::exception_ptr  error;          // thrown by the conversion, if any
+
+      Frame() :
+      index( 0 ), packed( 0, 0, 0, 0 ), hasMatrix( false ), coverage( 0 ), pyramid( 0 ),
+      serial( 0 ), latency( 0 ), conversionTime( 0 )
+      {
+      }
+   };
+
+   struct Statistics
+   {
+      uint64 submitted      = 0; // frames accepted
+      uint64 converted      = 0; // frames converted successfully
+      uint64 rejected       = 0; // TrySubmit() calls refused because the queue was full
+      uint64 failed         = 0; // frames that could not be converted
+      double meanLatency    = 0; // s, submission to end of conversion
+      double maxLatency     = 0; // s
+      double meanConversion = 0; // s, conversion time alone
+      double blockedTime    = 0; // s, total time Submit() spent waiting for a free slot
+   };
+
+   /*
+    * depth is the number of frame slots, constrained to the range [1,3].
+    * While waiting, Submit() and Receive() poll the progress object of the
+    * engine, if any. Once it has been aborted, frames are no longer
+    * converted, and are received with a ProcessAborted error.
+    */
+   CFA2RGBFrameQueue( const CFA2RGBEngine&, int depth = 2 );
+
+   /*
+    * Finishes the conversion in progress, if any, and stops the dispatcher
+    * thread. Frames not yet received are discarded.
+    */
+   virtual ~CFA2RGBFrameQueue();
+
+   int Depth() const
+   {
+      return m_depth;
+   }
+
+   /*
+    * Number of frames submitted and not yet received.
+    */
+   int Count() const;
+
+   bool IsFull() const
+   {
+      return Count() == m_depth;
+   }
+
+   /*
+    * Queues a frame, blocking while all slots are in use. Returns the serial
+    * number of the frame.
+    */
+   uint64 Submit( const Frame& );
+
+   /*
+    * Non-blocking variant of Submit(). Returns false if no slot is available.
+    */
+   bool TrySubmit( const Frame&, uint64& serial );
+
+   /*
+    * Waits until the oldest frame has been converted and removes it from the
+    * queue. Returns false if the queue is empty. Conversion errors are not
+    * thrown, but returned in the error member of the frame.
+    */
+   bool Receive( Frame& );
+
+   Statistics GetStatistics() const;
+
+private:
+
+   typedef std::chrono::steady_clock clock;
+
+   struct Slot
+   {
+      Frame             frame;
+      clock::time_point submitted;
+   };
+
+   CFA2RGBEngine            m_engine;
+   int                      m_depth;
+   Slot                     m_slots[ 3 ];
+   int                      m_head;      // oldest slot
+   int                      m_count;     // slots holding frames
+   int                      m_converted; // slots from m_head holding converted frames
+   uint64                   m_serial;
+   bool                     m_stop;
+   Statistics               m_stats;
+   mutable std::mutex       m_mutex;
+   std::condition_variable  m_notEmpty;  // a frame has been submitted
+   std::condition_variable  m_changed;   // a frame has been converted or received
+   CFA2RGBFrameQueueThread* m_thread;
+
+   bool Enqueue( const Frame&, bool wait, uint64& serial );
+   template <class Predicate>
+   void Wait( std::unique_lock<std::mutex>&, Predicate ready );
+   void Process();
+
+   friend class CFA2RGBFrameQueueThread;
+};
+
+// ----------------------------------------------------------------------------
+
+} // pcl
+
+#endif   // __CFA2RGBFrameQueue_h
+
+// ****************************************************************************
+// EOF CFA2RGBFrameQueue.h - Released 2016/02/03 00:00:00 UTC
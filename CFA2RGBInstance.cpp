@@ -50,10 +50,26 @@
 // POSSIBILITY OF SUCH DAMAGE.
 // ----------------------------------------------------------------------------
 
+#include "CFA2RGBAccumulator.h"
+#include "CFA2RGBClaimDirectory.h"
+#include "CFA2RGBEngine.h"
+#include "CFA2RGBFileCache.h"
+#include "CFA2RGBFrameQueue.h"
 #include "CFA2RGBInstance.h"
+#include "CFA2RGBMemoryPlan.h"
+#include "CFA2RGBOutputWriter.h"
 #include "CFA2RGBParameters.h"
+#include "CFA2RGBProgress.h"
+#include "CFA2RGBViewScheduler.h"
 
+#include <pcl/AutoPointer.h>
 #include <pcl/AutoViewLock.h>
+#include <pcl/Console.h>
+#include <pcl/ElapsedTime.h>
+#include <pcl/ErrorHandler.h>
+#include <pcl/FileFormat.h>
+#include <pcl/FileFormatInstance.h>
+#include <pcl/ImageWindow.h>
 
 namespace pcl
 {
@@ -62,8 +78,50 @@ namespace pcl
 
 CFA2RGBInstance::CFA2RGBInstance( const MetaProcess* m ) :
 ProcessImplementation( m ),
-p_bayerPattern( CFA2RGBBayerPatternParameter::Default )
+p_bayerPattern( CFA2RGBBayerPatternParameter::Default ),
+p_blockBinning( TheCFA2RGBBlockBinningParameter->DefaultValue() ),
+p_cellBinning( CFA2RGBCellBinningParameter::Default ),
+p_cellBinningMode( CFA2RGBCellBinningModeParameter::Default ),
+p_cellBinningOutput( CFA2RGBCellBinningOutputParameter::Default ),
+p_generateCoverageMaps( TheCFA2RGBGenerateCoverageMapsParameter->DefaultValue() ),
+p_outputMode( CFA2RGBOutputModeParameter::Default ),
+p_interpolation( CFA2RGBInterpolationParameter::Default ),
+p_correctLateralCA( TheCFA2RGBCorrectLateralCAParameter->DefaultValue() ),
+p_applyColorMatrix( TheCFA2RGBApplyColorMatrixParameter->DefaultValue() ),
+p_colorMatrixSource( CFA2RGBColorMatrixSourceParameter::Default ),
+p_useROI( TheCFA2RGBUseROIParameter->DefaultValue() ),
+p_roi( 0 ),
+p_sourceView(),
+p_dirtyRects(),
+p_memoryBudget( int32( TheCFA2RGBMemoryBudgetParameter->DefaultValue() ) ),
+p_convertOpenViews( TheCFA2RGBConvertOpenViewsParameter->DefaultValue() ),
+p_outputSampleFormat( CFA2RGBOutputSampleFormatParameter::Default ),
+p_targetFrames(),
+p_rawPacking( CFA2RGBRawPackingParameter::Default ),
+p_rawWidth( int32( TheCFA2RGBRawWidthParameter->DefaultValue() ) ),
+p_rawHeight( int32( TheCFA2RGBRawHeightParameter->DefaultValue() ) ),
+p_rawStride( int32( TheCFA2RGBRawStrideParameter->DefaultValue() ) ),
+p_outputDirectory(),
+p_outputPostfix( TheCFA2RGBOutputPostfixParameter->DefaultValue() ),
+p_overwriteExistingFiles( TheCFA2RGBOverwriteExistingFilesParameter->DefaultValue() ),
+p_useFileCache( TheCFA2RGBUseFileCacheParameter->DefaultValue() ),
+p_outputCompression( CFA2RGBOutputCompressionParameter::Default ),
+p_outputByteShuffling( TheCFA2RGBOutputByteShufflingParameter->DefaultValue() ),
+p_onError( CFA2RGBOnErrorParameter::Default ),
+p_writeOutputFiles( TheCFA2RGBWriteOutputFilesParameter->DefaultValue() ),
+p_integrateFrames( TheCFA2RGBIntegrateFramesParameter->DefaultValue() ),
+p_generatePyramid( TheCFA2RGBGeneratePyramidParameter->DefaultValue() ),
+p_pyramidLevels( int32( TheCFA2RGBPyramidLevelsParameter->DefaultValue() ) ),
+p_pyramidFormat( CFA2RGBPyramidFormatParameter::Default ),
+p_claimDirectory(),
+p_claimTimeout( int32( TheCFA2RGBClaimTimeoutParameter->DefaultValue() ) ),
+o_conversionTime( 0 ),
+o_conversionRate( 0 )
 {
+   for ( int i = 0; i < 3; ++i )
+      p_lateralCARed[i] = p_lateralCABlue[i] = 0;
+   for ( int i = 0; i < 9; ++i )
+      p_colorMatrix[i] = (i % 4 == 0) ? 1 : 0;
 }
 
 CFA2RGBInstance::CFA2RGBInstance( const CFA2RGBInstance& x ) :
@@ -78,13 +136,75 @@ void CFA2RGBInstance::Assign( const ProcessImplementation& p )
    if ( x != 0 )
    {
       p_bayerPattern             = x->p_bayerPattern;
+      p_blockBinning             = x->p_blockBinning;
+      p_cellBinning              = x->p_cellBinning;
+      p_cellBinningMode          = x->p_cellBinningMode;
+      p_cellBinningOutput        = x->p_cellBinningOutput;
+      p_generateCoverageMaps     = x->p_generateCoverageMaps;
+      p_outputMode               = x->p_outputMode;
+      p_interpolation            = x->p_interpolation;
+      p_correctLateralCA         = x->p_correctLateralCA;
+      for ( int i = 0; i < 3; ++i )
+      {
+         p_lateralCARed[i]       = x->p_lateralCARed[i];
+         p_lateralCABlue[i]      = x->p_lateralCABlue[i];
+      }
+      p_applyColorMatrix         = x->p_applyColorMatrix;
+      p_colorMatrixSource        = x->p_colorMatrixSource;
+      for ( int i = 0; i < 9; ++i )
+         p_colorMatrix[i]        = x->p_colorMatrix[i];
+      p_useROI                   = x->p_useROI;
+      p_roi                      = x->p_roi;
+      p_sourceView               = x->p_sourceView;
+      p_dirtyRects               = x->p_dirtyRects;
+      p_memoryBudget             = x->p_memoryBudget;
+      p_convertOpenViews         = x->p_convertOpenViews;
+      p_outputSampleFormat       = x->p_outputSampleFormat;
+      p_targetFrames             = x->p_targetFrames;
+      p_rawPacking               = x->p_rawPacking;
+      p_rawWidth                 = x->p_rawWidth;
+      p_rawHeight                = x->p_rawHeight;
+      p_rawStride                = x->p_rawStride;
+      p_outputDirectory          = x->p_outputDirectory;
+      p_outputPostfix            = x->p_outputPostfix;
+      p_overwriteExistingFiles   = x->p_overwriteExistingFiles;
+      p_useFileCache             = x->p_useFileCache;
+      p_outputCompression        = x->p_outputCompression;
+      p_outputByteShuffling      = x->p_outputByteShuffling;
+      p_onError                  = x->p_onError;
+      p_writeOutputFiles         = x->p_writeOutputFiles;
+      p_integrateFrames          = x->p_integrateFrames;
+      p_generatePyramid          = x->p_generatePyramid;
+      p_pyramidLevels            = x->p_pyramidLevels;
+      p_pyramidFormat            = x->p_pyramidFormat;
+      p_claimDirectory           = x->p_claimDirectory;
+      p_claimTimeout             = x->p_claimTimeout;
+      o_conversionTime           = x->o_conversionTime;
+      o_conversionRate           = x->o_conversionRate;
    }
 }
 
+/*
+ * The history only needs the pixel data replaced by the conversion, which is
+ * the single-channel CFA, and the view properties where the coverage maps
+ * are stored. Keywords, the RGB working space and mask relations are left
+ * unchanged, so no copies of them are kept.
+ */
+UndoFlags CFA2RGBInstance::UndoMode( const View& ) const
+{
+   return UndoFlag::PixelData | UndoFlag::Properties;
+}
+
 bool CFA2RGBInstance::CanExecuteOn( const View& view, String& whyNot ) const
 {
    if ( view.Image().IsComplexSample() )
       whyNot = "CFA2RGB cannot be executed on complex images.";
+   else if ( !p_sourceView.IsEmpty() && view.IsPreview() )
+      whyNot = "Incremental updates can only be executed on main views.";
+   else if ( !p_sourceView.IsEmpty() && p_useROI )
+      whyNot = "Incremental updates cannot be combined with a region of interest.";
+   else if ( !p_sourceView.IsEmpty() && p_outputSampleFormat != CFA2RGBOutputSampleFormatParameter::SameAsInput )
+      whyNot = "Incremental updates keep the sample format of the source view.";
    else
    {
       whyNot.Clear();
@@ -95,77 +215,1399 @@ bool CFA2RGBInstance::CanExecuteOn( const View& view, String& whyNot ) const
 
 // ----------------------------------------------------------------------------
 
-template <class P>
-void Apply(GenericImage<P>& img, pcl_enum bayerPattern )
+/*
+ * Deletes the properties set by previous conversions, including those of
+ * earlier module versions, which no longer describe the image.
+ */
+static void DeleteModuleProperties( View& view )
+{
+   PropertyArray properties = view.Properties();
+   for ( PropertyArray::const_iterator i = properties.Begin(); i != properties.End(); ++i )
+      if ( i->Id().StartsWith( "CFA2RGB:" ) )
+         view.DeleteProperty( i->Id(), false/*notify*/ );
+}
+
+bool CFA2RGBInstance::ExecuteOn( View& view )
+{
+   if ( !p_sourceView.IsEmpty() )
+      return UpdateView( view );
+
+   AutoViewLock lock( view );
+
+   ImageVariant image = view.Image();
+   if ( image.IsComplexSample() )
+      return false;
+
+   /*
+    * Previews share the sample format of their main views, so only main
+    * views can be given a more compact output format. The view is not
+    * changed until the conversion is known to fit within the memory budget.
+    */
+   int bitsPerSample = image.BitsPerSample();
+   bool floatSample = image.IsFloatSample();
+   const bool requantize = !view.IsPreview() && OutputSampleFormat( bitsPerSample, floatSample );
+
+   /*
+    * A preview is a crop of its main view: keep the CFA phase of the mosaic
+    * by referring pixel coordinates to the parent image origin.
+    */
+   Point origin( 0 );
+   if ( view.IsPreview() )
+      origin = view.Window().PreviewRect( view.Id() ).LeftTop();
+
+   CFA2RGBEngine engine( *this );
+   if ( IsColorMatrixFromKeywords() )
+   {
+      FITSKeywordArray keywords;
+      view.Window().GetKeywords( keywords );
+      engine.SetColorMatrix( KeywordColorMatrix( keywords, view.FullId() ) );
+   }
+   if ( view.IsPreview() )
+   {
+      // The optical center is that of the main view.
+      View mainView = view.Window().MainView();
+      engine.SetMosaicDimensions( mainView.Width(), mainView.Height() );
+   }
+
+   Rect roi = RegionOfInterest( image );
+   if ( !roi.IsRect() )
+      throw Error( "CFA2RGB: The region of interest does not intersect " + view.FullId() );
+
+   /*
+    * The history keeps a copy of the source image until the conversion has
+    * finished.
+    */
+   CFA2RGBMemoryPlan plan( engine, MemoryBudget() );
+   const bool coverageMaps = p_generateCoverageMaps && engine.OutputChannels() == 3;
+   plan.PlanView( roi.Width(), roi.Height(), bitsPerSample >> 3, coverageMaps, p_useROI, image.ImageSize() );
+   Console().WriteLn( "<end><cbr>" + plan.Report() );
+   if ( !plan.IsFeasible() )
+      throw Error( "CFA2RGB: Insufficient memory to convert " + view.FullId() );
+
+   if ( requantize )
+   {
+      view.Window().SetSampleFormat( bitsPerSample, floatSample );
+      image = view.Image();
+   }
+
+   int width, height;
+   engine.GetOutputDimensions( width, height, roi.Width(), roi.Height() );
+   CFA2RGBProgress progress;
+   progress.Initialize( "CFA2RGB: Converting " + view.FullId(), height );
+   engine.SetProgress( &progress );
+
+   CFA2RGBCoverageMap coverage;
+   double pixels = double( roi.Width() )*roi.Height();
+   ElapsedTime T;
+   ConvertImage( engine, image, roi, origin, coverageMaps ? &coverage : 0 );
+   SetConversionTiming( T(), pixels );
+
+   DeleteModuleProperties( view );
+
+   if ( coverageMaps )
+   {
+      /*
+       * Store the bit-packed coverage planes as view properties, so they are
+       * saved along with the image in XISF files.
+       */
+      view.SetPropertyValue( "CFA2RGB:CoverageR", coverage.Plane( 0 ), false/*notify*/, ViewPropertyAttribute::Storable );
+      view.SetPropertyValue( "CFA2RGB:CoverageG", coverage.Plane( 1 ), false/*notify*/, ViewPropertyAttribute::Storable );
+      view.SetPropertyValue( "CFA2RGB:CoverageB", coverage.Plane( 2 ), false/*notify*/, ViewPropertyAttribute::Storable );
+   }
+
+   progress.Complete();
+   return true;
+}
+
+/*
+ * Incremental update. The target view holds the result of a previous
+ * out-of-place conversion of the source view, whose pixels have changed
+ * within the dirty rectangles since then. Only the output pixels that depend
+ * on those rectangles are recomputed; the engine falls back to a complete
+ * conversion if the target does not match the geometry and sample type of
+ * the source. The pattern is unchanged, so coverage maps stored in the
+ * target view remain valid and are left as they are.
+ */
+bool CFA2RGBInstance::UpdateView( View& view )
 {
-	bool Rx, Ry, Gx0, Gx1, Bx, By;
-    Rx = Ry = Gx0 = Gx1 = Bx = By = 0;
-	switch ( bayerPattern )
+   View source = View::ViewById( p_sourceView.ToIsoString() );
+   if ( source.IsNull() )
+      throw Error( "CFA2RGB: No such source view: " + p_sourceView );
+   if ( source == view )
+      throw Error( "CFA2RGB: The source of an incremental update cannot be its target view: " + view.FullId() );
+
+   ImageVariant cfa = source.Image();
+   if ( cfa.IsComplexSample() || cfa->NumberOfChannels() != 1 )
+      throw Error( "CFA2RGB: The source of an incremental update must be a single-channel CFA image: " + source.FullId() );
+
+   AutoViewLock lock( view );
+   source.Lock();
+   source.UnlockForRead();
+
+   try
+   {
+      CFA2RGBEngine engine( *this );
+      if ( IsColorMatrixFromKeywords() )
+      {
+         FITSKeywordArray keywords;
+         source.Window().GetKeywords( keywords );
+         engine.SetColorMatrix( KeywordColorMatrix( keywords, source.FullId() ) );
+      }
+
+      ImageVariant image = view.Image();
+
+      // Conversion kernels report the rows of each tile they recompute.
+      size_type rows = 0;
+      if ( engine.CanUpdate( image, cfa ) )
       {
-      case CFA2RGBBayerPatternParameter::RGGB: Gx0=Bx=By=1; break;
-      case CFA2RGBBayerPatternParameter::BGGR: Rx=Ry=Gx0=1; break;
-      case CFA2RGBBayerPatternParameter::GRBG: Rx=Gx1=1; break;
-      case CFA2RGBBayerPatternParameter::GBRG: Ry=Gx1=Bx=1; break;
+         Array<Rect> tiles = engine.DirtyTiles( p_dirtyRects, cfa->Width(), cfa->Height() );
+         for ( Array<Rect>::const_iterator i = tiles.Begin(); i != tiles.End(); ++i )
+            rows += i->Height();
       }
+      else
+      {
+         int width, height;
+         engine.GetOutputDimensions( width, height, cfa->Width(), cfa->Height() );
+         rows = height;
+      }
+
+      CFA2RGBProgress progress;
+      progress.Initialize( "CFA2RGB: Updating " + view.FullId(), rows );
+      engine.SetProgress( &progress );
+
+      ElapsedTime T;
+      size_type pixels = engine.Update( image, cfa, p_dirtyRects );
+      if ( progress.IsAborted() )
+         throw ProcessAborted();
+      SetConversionTiming( T(), double( pixels ) );
+
+      Console().WriteLn( String().Format( "<end><cbr>%.3f Mpx recomputed from %u dirty rectangle(s)",
+                                          pixels/1.0e+06, unsigned( p_dirtyRects.Length() ) ) );
+      progress.Complete();
+   }
+   catch ( ... )
+   {
+      source.Unlock();
+      throw;
+   }
 
-	for ( int x = 0; x < img.Width(); ++x )
-	{
-		const bool x1(x&1);
-		for ( int y = 0; y < img.Height(); ++y )
-		{
-			const bool y1(y&1);
-			if ( x1!=Rx || y1!=Ry ) img.Pixel(x,y,0) = 0; //R
-			if ( y1 ? x1!=Gx1 : x1!=Gx0 ) img.Pixel(x,y,1) = 0; //G
-			if ( x1!=Bx || y1!=By ) img.Pixel(x,y,2) = 0; //B
-		}
-	}
+   source.Unlock();
+   return true;
 }
 
-bool CFA2RGBInstance::ExecuteOn( View& view )
+// ----------------------------------------------------------------------------
+
+bool CFA2RGBInstance::CanExecuteOn( const ImageVariant& image, String& whyNot ) const
 {
-   AutoViewLock lock( view );
+   int bitsPerSample = image.BitsPerSample();
+   bool floatSample = image.IsFloatSample();
+   if ( image.IsComplexSample() )
+      whyNot = "CFA2RGB cannot be executed on complex images.";
+   else if ( OutputSampleFormat( bitsPerSample, floatSample ) )
+      whyNot = "The output sample format can only be changed when CFA2RGB is executed on a view.";
+   else if ( IsColorMatrixFromKeywords() )
+      whyNot = "Color matrix keywords are only available when CFA2RGB is executed on a view.";
+   else if ( !p_sourceView.IsEmpty() )
+      whyNot = "Incremental updates are only available when CFA2RGB is executed on a view.";
+   else
+   {
+      whyNot.Clear();
+      return true;
+   }
+   return false;
+}
 
-   ImageVariant source = view.Image();
-   if ( source.IsComplexSample() )
+/*
+ * Converts an image in place, for scripts that process Image objects
+ * directly. There is no view, so there is no history, undo data or screen
+ * update to maintain; only the progress of the conversion is written to the
+ * console, and it can be aborted as on a view. Coverage maps are view
+ * properties, so they are not generated. CFA2RGB defines no format hints:
+ * the hints argument is ignored.
+ */
+bool CFA2RGBInstance::ExecuteOn( ImageVariant& image, const IsoString& hints )
+{
+   if ( image.IsComplexSample() )
       return false;
 
-   source.SetColorSpace(ColorSpace::RGB);
+   Rect roi = RegionOfInterest( image );
+   if ( !roi.IsRect() )
+      throw Error( "CFA2RGB: The region of interest does not intersect the image." );
+
+   CFA2RGBEngine engine( *this );
+
+   CFA2RGBMemoryPlan plan( engine, MemoryBudget() );
+   plan.PlanView( roi.Width(), roi.Height(), image.BytesPerSample(), false/*coverageMaps*/, p_useROI );
+   if ( !plan.IsFeasible() )
+      throw Error( "CFA2RGB: Insufficient memory to convert the image." );
+
+   int width, height;
+   engine.GetOutputDimensions( width, height, roi.Width(), roi.Height() );
+   CFA2RGBProgress progress;
+   progress.Initialize( "CFA2RGB: Converting image", height );
+   engine.SetProgress( &progress );
 
-   if ( source.IsFloatSample() )
-      switch ( source.BitsPerSample() )
+   double pixels = double( roi.Width() )*roi.Height();
+   ElapsedTime T;
+   ConvertImage( engine, image, roi, Point( 0 ) );
+   if ( progress.IsAborted() )
+      throw ProcessAborted();
+   SetConversionTiming( T(), pixels );
+
+   progress.Complete();
+   return true;
+}
+
+/*
+ * The rectangle of an image to be converted: the whole image, or the region
+ * of interest clipped to its bounds, which may be empty.
+ */
+Rect CFA2RGBInstance::RegionOfInterest( const ImageVariant& image ) const
+{
+   if ( p_useROI )
+      return p_roi.Ordered().Intersection( image->Bounds() );
+   return image->Bounds();
+}
+
+/*
+ * A region of interest is converted out of place, so that only the rectangle
+ * is allocated and processed; the image is then replaced with the converted
+ * region. origin is the position of the image in the full CFA mosaic.
+ */
+void CFA2RGBInstance::ConvertImage( const CFA2RGBEngine& engine, ImageVariant& image, const Rect& roi,
+                                    const Point& origin, CFA2RGBCoverageMap* coverage ) const
+{
+   if ( p_useROI )
+   {
+      ImageVariant rgb;
+      engine.Convert( rgb, image, roi, origin, coverage );
+      image.CopyImage( rgb );
+   }
+   else
+      engine.Convert( image, origin, coverage );
+}
+
+bool CFA2RGBInstance::IsColorMatrixFromKeywords() const
+{
+   return p_applyColorMatrix && p_colorMatrixSource == CFA2RGBColorMatrixSourceParameter::Keywords;
+}
+
+/*
+ * Reads the color matrix of an image from its FWDMAT11 ... FWDMAT33 keywords,
+ * named after the ForwardMatrix tags of DNG files: FWDMATij is the weight of
+ * camera channel j in output channel i.
+ */
+CFA2RGBColorMatrix CFA2RGBInstance::KeywordColorMatrix( const FITSKeywordArray& keywords, const String& imageId ) const
+{
+   double m[ 9 ];
+   bool found[ 9 ] = { false, false, false, false, false, false, false, false, false };
+   for ( FITSKeywordArray::const_iterator k = keywords.Begin(); k != keywords.End(); ++k )
+      for ( int i = 0; i < 9; ++i )
+         if ( k->name == IsoString().Format( "FWDMAT%d%d", i/3 + 1, i%3 + 1 ) )
+            found[i] = k->GetNumericValue( m[i] );
+   for ( int i = 0; i < 9; ++i )
+      if ( !found[i] )
+         throw Error( imageId + ": Missing or invalid color matrix keyword: " + IsoString().Format( "FWDMAT%d%d", i/3 + 1, i%3 + 1 ) );
+   return CFA2RGBColorMatrix( m );
+}
+
+void CFA2RGBInstance::SetConversionTiming( double seconds, double pixels )
+{
+   o_conversionTime = seconds;
+   o_conversionRate = (seconds > 0) ? pixels/seconds/1.0e+06 : 0;
+}
+
+// ----------------------------------------------------------------------------
+
+bool CFA2RGBInstance::CanExecuteGlobal( String& whyNot ) const
+{
+   if ( p_convertOpenViews )
+   {
+      if ( ImageWindow::AllWindows().IsEmpty() )
+         whyNot = "There are no open images to convert.";
+      else
       {
-      case 32: Apply( static_cast<Image&>( *source ), p_bayerPattern ); break;
-      case 64: Apply( static_cast<DImage&>( *source ), p_bayerPattern ); break;
+         whyNot.Clear();
+         return true;
       }
+   }
+   else if ( p_targetFrames.IsEmpty() )
+      whyNot = "No target frames have been specified.";
+   else if ( !p_writeOutputFiles && !p_integrateFrames )
+      whyNot = "Batch execution would neither write output files nor integrate the converted frames.";
+   else if ( p_integrateFrames && (p_outputMode != CFA2RGBOutputModeParameter::RGB || CFA2RGBEngine( *this ).IsCFAOutput()) )
+      whyNot = "Frame integration requires RGB output.";
+   else if ( (p_rawWidth <= 0 || p_rawHeight <= 0) && HasRawTargets() )
+      whyNot = "The dimensions of packed raw frames have not been specified.";
+   else if ( IsColorMatrixFromKeywords() && HasRawTargets() )
+      whyNot = "Packed raw frames have no keywords to read a color matrix from.";
+   else if ( p_writeOutputFiles && !p_outputDirectory.IsEmpty() && !File::DirectoryExists( p_outputDirectory ) )
+      whyNot = "The specified output directory does not exist: " + p_outputDirectory;
+   else if ( !p_claimDirectory.Trimmed().IsEmpty() && p_integrateFrames )
+      whyNot = "Frame integration cannot be distributed through a claim directory.";
+   else if ( !p_claimDirectory.Trimmed().IsEmpty() && !p_writeOutputFiles )
+      whyNot = "Distributed batch conversion requires writing output files.";
+   else if ( !p_claimDirectory.Trimmed().IsEmpty() && !File::DirectoryExists( p_claimDirectory.Trimmed() ) )
+      whyNot = "The specified claim directory does not exist: " + p_claimDirectory;
    else
-      switch ( source.BitsPerSample() )
+   {
+      whyNot.Clear();
+      return true;
+   }
+   return false;
+}
+
+/*
+ * The target frame whose output file is being written, to be recorded in the
+ * file cache and the claim directory once the write has succeeded.
+ */
+struct PendingOutput
+{
+   String    inputPath;
+   IsoString contentHash;
+   IsoString settings;
+};
+
+/*
+ * Waits for the pending output file, if any, and accounts for its outcome.
+ * Returns false if the file could not be written, in which case its claim is
+ * released so that another worker can retry the frame.
+ */
+static bool CollectOutput( CFA2RGBOutputWriter& writer, Console& console, int& succeeded, int& failed,
+                           CFA2RGBFileCache* cache, CFA2RGBClaimDirectory* claims, const PendingOutput& pending )
+{
+   if ( writer.Wait() )
+   {
+      if ( !writer.Succeeded() )
+      {
+         ++failed;
+         console.CriticalLn( "<end><cbr>*** Error: " + writer.ErrorMessage() );
+         if ( claims != 0 )
+            claims->Release( pending.inputPath );
+         return false;
+      }
+      ++succeeded;
+      if ( cache != 0 )
+         cache->Add( pending.inputPath, pending.contentHash, pending.settings, writer.FilePath() );
+      if ( claims != 0 )
+         claims->Complete( pending.inputPath, writer.FilePath() );
+   }
+   return true;
+}
+
+/*
+ * Estimates the memory required to convert a frame and logs the plan when it
+ * changes. Throws an Error if the frame cannot be converted within the
+ * memory budget. Returns true if the frame being converted must be stored,
+ * and its output file written, before the frame is read.
+ */
+static bool PlanFrame( CFA2RGBMemoryPlan& plan, const String& filePath, Console& console, String& lastReport )
+{
+   String report = plan.Report();
+   if ( report != lastReport )
+      console.WriteLn( "<end><cbr>" + (lastReport = report) );
+   if ( !plan.IsFeasible() )
+      throw Error( filePath + ": Insufficient memory to convert the frame." );
+   return plan.Strategy() == CFA2RGBMemoryPlan::Sequential;
+}
+
+/*
+ * Milliseconds between two attempts to claim the frames being converted by
+ * other workers.
+ */
+static const unsigned s_claimRetryInterval = 2000;
+
+/*
+ * Batch state of a target frame from the time it is read until its results
+ * have been stored.
+ */
+struct TargetFrame
+{
+   ImageOptions     options;
+   FITSKeywordArray keywords;
+   IsoString        settings;
+   IsoString        contentHash;
+   double           pixels = 0;
+};
+
+/*
+ * Converts each enabled target frame in place and either writes it to an
+ * XISF file, feeds it to the integration accumulator, or both. Frames are
+ * read on this thread and converted by a frame queue, so the next frame is
+ * read while the current one is being converted, and output files are
+ * compressed and written on a background thread while the next frame is
+ * converted: at most three frames are held in memory. If three frames do not
+ * fit within the memory budget, each frame is converted and its output file
+ * written before the next frame is read.
+ */
+bool CFA2RGBInstance::ExecuteGlobal()
+{
+   if ( p_convertOpenViews )
+      return ExecuteViews();
+
+   Console console;
+   console.EnableAbort();
+
+   CFA2RGBEngine engine( *this );
+   CFA2RGBAccumulator accumulator;
+   CFA2RGBCoverageMap coverage;
+   // Stored in output files; integration needs them in any case.
+   const bool coverageMaps = p_generateCoverageMaps && p_writeOutputFiles && engine.OutputChannels() == 3;
+   const IsoString hints = CFA2RGBOutputWriter::Hints(
+            CFA2RGBOutputCompressionParameter::CodecName( p_outputCompression ), p_outputByteShuffling );
+   CFA2RGBOutputWriter writer( hints );
+
+   /*
+    * Reduced-scale previews are generated by the conversion threads from the
+    * rows they have just converted, and written next to each output file.
+    */
+   CFA2RGBPyramid pyramid( p_pyramidLevels );
+   CFA2RGBPyramid* levels = (p_generatePyramid && p_writeOutputFiles && engine.OutputChannels() == 3) ? &pyramid : 0;
+
+   /*
+    * Frame sizes are only known as frames are read, so the batch monitor
+    * counts frames.
+    */
+   size_type enabledFrames = 0;
+   for ( image_list::const_iterator i = p_targetFrames.Begin(); i != p_targetFrames.End(); ++i )
+      if ( i->enabled )
+         ++enabledFrames;
+   CFA2RGBProgress progress;
+   progress.InitializeFrames( "CFA2RGB: Converting target frames", enabledFrames );
+   engine.SetProgress( &progress );
+
+   /*
+    * With a claim directory, several processes share the batch, each one
+    * converting the frames it manages to claim. A worker does not finish
+    * until the frames claimed by others have been completed. The file cache
+    * index cannot be shared safely between processes, so it is disabled in
+    * this mode.
+    */
+   AutoPointer<CFA2RGBClaimDirectory> claims;
+   String claimDirectory = p_claimDirectory.Trimmed();
+   if ( !claimDirectory.IsEmpty() )
+   {
+      claims = new CFA2RGBClaimDirectory( claimDirectory, p_claimTimeout );
+      console.WriteLn( "<end><cbr>Using claim directory: " + claimDirectory );
+      console.WriteLn( "Worker: " + claims->WorkerId() );
+   }
+
+   /*
+    * The cache lets reruns skip frames already converted with the same
+    * settings. Integration needs every frame, so it disables the cache.
+    */
+   AutoPointer<CFA2RGBFileCache> cache;
+   if ( p_useFileCache && p_writeOutputFiles && !p_integrateFrames && !claims )
+   {
+      cache = new CFA2RGBFileCache( CacheFilePath() );
+      console.WriteLn( "<end><cbr>Using file cache: " + cache->IndexFilePath() );
+   }
+   PendingOutput pending;
+
+   CFA2RGBMemoryPlan plan( engine, MemoryBudget() );
+   String lastPlanReport;
+   const bool compress = p_outputCompression != CFA2RGBOutputCompressionParameter::None;
+
+   int succeeded = 0, failed = 0, skipped = 0, unchanged = 0, claimed = 0;
+   double conversionTime = 0, convertedPixels = 0;
+
+   /*
+    * A single queue slot: the frame being converted is stored before the
+    * next one is submitted, so the coverage map and the pyramid are only
+    * written by one conversion at a time.
+    */
+   CFA2RGBFrameQueue queue( engine, 1 );
+   Array<TargetFrame> frames( p_targetFrames.Length() );
+
+   /*
+    * Accounts for a failed target frame. Must be called from a catch
+    * handler: the current exception is reported, unless the user has
+    * requested to abort.
+    */
+   auto fail = [&]( const ImageItem& item )
+   {
+      if ( claims )
+         claims->Release( item.path );
+
+      if ( console.AbortRequested() )
+         throw ProcessAborted();
+
+      ++failed;
+      try
+      {
+         throw;
+      }
+      ERROR_HANDLER
+
+      if ( p_onError == CFA2RGBOnErrorParameter::Abort )
+         throw ProcessAborted();
+
+      console.ResetStatus();
+      console.EnableAbort();
+      console.NoteLn( "<end><cbr><br>* Skipping target frame." );
+   };
+
+   auto collect = [&]()
+   {
+      if ( !CollectOutput( writer, console, succeeded, failed, cache.Pointer(), claims.Pointer(), pending ) )
+         if ( p_onError == CFA2RGBOnErrorParameter::Abort )
+            throw ProcessAborted();
+   };
+
+   /*
+    * Stores the results of a converted frame: adds it to the integration and
+    * starts writing its output file once the previous one has been written.
+    */
+   auto store = [&]( CFA2RGBFrameQueue::Frame& frame )
+   {
+      const ImageItem& item = p_targetFrames[frame.index];
+      TargetFrame& target = frames[frame.index];
+      try
+      {
+         if ( frame.error )
+            std::rethrow_exception( frame.error );
+
+         conversionTime += frame.conversionTime;
+         convertedPixels += target.pixels;
+
+         if ( p_integrateFrames )
+            accumulator.Add( frame.image, &coverage, engine.MaxThreads() );
+
+         if ( p_writeOutputFiles )
+         {
+            collect();
+
+            // Conversion may have taken a good part of the claim timeout.
+            if ( claims && !claims->Refresh( item.path ) )
+            {
+               console.NoteLn( "<end><cbr>* The claim has been taken over by another worker; skipping target frame: "
+                               + item.path );
+               ++claimed;
+            }
+            else
+            {
+               String outputFilePath = OutputFilePath( item.path );
+               console.WriteLn( "<end><cbr>Writing output file: " + outputFilePath );
+
+               target.keywords.Add( FITSHeaderKeyword( "HISTORY", IsoString(), "Converted with " + Meta()->Id() ) );
+               writer.Start( outputFilePath, frame.image, target.options, target.keywords, coverageMaps ? &coverage : 0 );
+
+               // Written while the output thread compresses the converted frame.
+               if ( levels != 0 )
+                  WritePyramid( pyramid, outputFilePath, engine.OutputPeriod(), hints );
+
+               pending.inputPath = item.path;
+               pending.contentHash = target.contentHash;
+               pending.settings = target.settings;
+            }
+         }
+         else
+            ++succeeded;
+      }
+      catch ( ProcessAborted& )
+      {
+         if ( claims )
+            claims->Release( item.path );
+         throw;
+      }
+      catch ( ... )
       {
-      case  8: Apply( static_cast<UInt8Image&>( *source ), p_bayerPattern ); break;
-      case 16: Apply( static_cast<UInt16Image&>( *source ), p_bayerPattern ); break;
-      case 32: Apply( static_cast<UInt32Image&>( *source ), p_bayerPattern ); break;
+         fail( item );
       }
+      target = TargetFrame();
+      progress.FrameDone();
+   };
+
+   auto storeAll = [&]()
+   {
+      CFA2RGBFrameQueue::Frame frame;
+      while ( queue.Receive( frame ) )
+         store( frame );
+   };
+
+   /*
+    * Reads a claimed target frame and submits it for conversion.
+    */
+   auto submit = [&]( size_type i )
+   {
+      const ImageItem& item = p_targetFrames[i];
+
+      try
+      {
+         console.WriteLn( String().Format( "<end><cbr><br>Reading frame %u of %u", unsigned( i+1 ), unsigned( p_targetFrames.Length() ) ) );
+         console.WriteLn( item.path );
+
+         auto skip = [&]()
+         {
+            console.NoteLn( "<end><cbr>* Output file is up to date; skipping target frame." );
+            ++unchanged;
+            progress.FrameDone();
+            frames[i] = TargetFrame();
+         };
+
+         /*
+          * Unchanged files are recognized by their path and time stamp, and
+          * moved, renamed or touched files by the hash of their contents.
+          */
+         TargetFrame& target = frames[i];
+         target.settings = CacheSettings( item.path );
+         if ( cache )
+            if ( cache->IsValid( item.path, target.settings ) )
+            {
+               skip();
+               return;
+            }
+
+         CFA2RGBFrameQueue::Frame frame;
+         frame.index = i;
+         frame.coverage = (p_integrateFrames || coverageMaps) ? &coverage : 0;
+         frame.pyramid = levels;
+
+         if ( IsRawFile( item.path ) )
+         {
+            /*
+             * Packed sensor data are unpacked and expanded in a single pass.
+             */
+            CFA2RGBPackedFrame geometry( 0, p_rawWidth, p_rawHeight, p_rawPacking, size_type( p_rawStride ) );
+            plan.PlanBatch( p_rawWidth, p_rawHeight, 2, geometry.Size(), p_integrateFrames || coverageMaps,
+                            p_pyramidLevels*(levels != 0), p_integrateFrames, p_writeOutputFiles, compress );
+            if ( PlanFrame( plan, item.path, console, lastPlanReport ) )
+            {
+               storeAll();
+               collect();
+            }
+
+            frame.raw = File::ReadFile( item.path );
+            if ( cache )
+            {
+               target.contentHash = CFA2RGBFileCache::Hash( frame.raw.Begin(), frame.raw.Length() );
+               if ( cache->IsValid( item.path, target.contentHash, target.settings ) )
+               {
+                  skip();
+                  return;
+               }
+            }
+            if ( frame.raw.Length() < geometry.Size() )
+               throw Error( item.path + String().Format( ": The file is too small for a %dx%d frame with the specified packing.",
+                                                         p_rawWidth, p_rawHeight ) );
+            frame.packed = geometry;
+            target.pixels = double( p_rawWidth )*p_rawHeight;
+
+            target.options.bitsPerSample = 16;
+            target.options.ieeefpSampleFormat = false;
+         }
+         else
+         {
+            if ( cache )
+            {
+               target.contentHash = CFA2RGBFileCache::HashFile( item.path );
+               if ( cache->IsValid( item.path, target.contentHash, target.settings ) )
+               {
+                  skip();
+                  return;
+               }
+            }
+
+            FileFormat format( File::ExtractExtension( item.path ), true/*read*/, false/*write*/ );
+            FileFormatInstance file( format );
+
+            ImageDescriptionArray images;
+            if ( !file.Open( images, item.path ) )
+               throw CaughtException();
+            if ( images.IsEmpty() )
+               throw Error( item.path + ": Empty image file." );
+            if ( images.Length() > 1 )
+               console.NoteLn( String().Format( "<end><cbr>* Ignoring %u additional image(s) in target frame.", unsigned( images.Length()-1 ) ) );
+
+            if ( format.CanStoreKeywords() )
+               if ( !file.Extract( target.keywords ) )
+                  throw CaughtException();
+
+            target.options = images[0].options;
+
+            // Read directly in the output format.
+            OutputSampleFormat( target.options.bitsPerSample, target.options.ieeefpSampleFormat );
+
+            plan.PlanBatch( images[0].info.width, images[0].info.height, target.options.bitsPerSample >> 3, 0,
+                            p_integrateFrames || coverageMaps, p_pyramidLevels*(levels != 0), p_integrateFrames, p_writeOutputFiles,
+                            compress );
+            if ( PlanFrame( plan, item.path, console, lastPlanReport ) )
+            {
+               storeAll();
+               collect();
+            }
+
+            frame.image.CreateImage( target.options.ieeefpSampleFormat, false/*isComplex*/, target.options.bitsPerSample );
+            if ( !file.ReadImage( frame.image ) )
+               throw CaughtException();
+            file.Close();
+
+            if ( IsColorMatrixFromKeywords() )
+            {
+               frame.hasMatrix = true;
+               frame.matrix = KeywordColorMatrix( target.keywords, item.path );
+            }
+            target.pixels = double( images[0].info.width )*images[0].info.height;
+         }
+
+         // The previous frame has been converted while this one was read.
+         if ( queue.IsFull() )
+            storeAll();
+         queue.Submit( frame );
+      }
+      catch ( ProcessAborted& )
+      {
+         if ( claims )
+            claims->Release( item.path );
+         throw;
+      }
+      catch ( ... )
+      {
+         fail( item );
+         progress.FrameDone();
+      }
+   };
+
+   try
+   {
+      Array<size_type> waiting;
+      for ( size_type i = 0; i < p_targetFrames.Length(); ++i )
+      {
+         const ImageItem& item = p_targetFrames[i];
+         if ( !item.enabled )
+         {
+            ++skipped;
+            continue;
+         }
+
+         if ( claims )
+            if ( !claims->Claim( item.path ) )
+            {
+               if ( claims->IsDone( item.path ) )
+               {
+                  ++claimed;
+                  progress.FrameDone();
+               }
+               else
+                  waiting.Add( i );
+               continue;
+            }
+
+         submit( i );
+      }
+
+      /*
+       * Frames being converted by other workers are either completed by
+       * them or, if a worker dies, taken over once their claims go stale.
+       */
+      while ( !waiting.IsEmpty() )
+      {
+         storeAll();
+         collect();
+
+         for ( unsigned t = 0; t < s_claimRetryInterval; t += CFA2RGBProgress::PollInterval )
+         {
+            Sleep( CFA2RGBProgress::PollInterval );
+            progress.Poll();
+            if ( progress.IsAborted() )
+               throw ProcessAborted();
+         }
+
+         Array<size_type> stillWaiting;
+         for ( Array<size_type>::const_iterator i = waiting.Begin(); i != waiting.End(); ++i )
+         {
+            const ImageItem& item = p_targetFrames[*i];
+            if ( claims->Claim( item.path ) )
+            {
+               console.NoteLn( "<end><cbr><br>* Claimed a frame released or abandoned by another worker: " + item.path );
+               submit( *i );
+            }
+            else if ( claims->IsDone( item.path ) )
+            {
+               ++claimed;
+               progress.FrameDone();
+            }
+            else
+               stillWaiting.Add( *i );
+         }
+         waiting = stillWaiting;
+      }
+
+      storeAll();
+   }
+   catch ( ... )
+   {
+      /*
+       * Frames still in the queue are not converted once the progress object
+       * has been aborted; give their claims back.
+       */
+      progress.Abort();
+      CFA2RGBFrameQueue::Frame frame;
+      while ( queue.Receive( frame ) )
+         if ( claims )
+            claims->Release( p_targetFrames[frame.index].path );
+      throw;
+   }
+
+   collect();
+
+   if ( cache )
+      cache->Compact();
+
+   progress.Complete();
+   SetConversionTiming( conversionTime, convertedPixels );
+
+   if ( claims )
+      console.NoteLn( String().Format( "<end><cbr><br>===== CFA2RGB: %d succeeded, %d failed, %d claimed elsewhere, %d skipped =====",
+                                       succeeded, failed, claimed, skipped ) );
+   else
+      console.NoteLn( String().Format( "<end><cbr><br>===== CFA2RGB: %d succeeded, %d failed, %d unchanged, %d skipped =====",
+                                       succeeded, failed, unchanged, skipped ) );
+
+   if ( p_writeOutputFiles )
+   {
+      const CFA2RGBOutputWriter::Statistics& S = writer.GetStatistics();
+      if ( S.files > 0 )
+         console.WriteLn( String().Format( "Output: %d file(s), %.2f MiB raw, %.2f MiB stored, "
+                                           "compression ratio %.2f, %.2f MiB/s",
+                                           S.files, S.rawBytes/1048576.0, S.storedBytes/1048576.0,
+                                           S.Ratio(), S.Throughput()/1048576.0 ) );
+   }
+
+   if ( p_integrateFrames && accumulator.Count() > 0 )
+   {
+      console.WriteLn( String().Format( "<end><cbr>Generating integration results of %d frame(s)", accumulator.Count() ) );
+
+      ImageWindow meanWindow( 1, 1, 3, 32, true/*float*/, true/*color*/, true/*initialProcessing*/, "CFA2RGB_mean" );
+      ImageWindow sigmaWindow( 1, 1, 3, 32, true/*float*/, true/*color*/, true/*initialProcessing*/, "CFA2RGB_sigma" );
+
+      ImageVariant mean = meanWindow.MainView().Image();
+      ImageVariant sigma = sigmaWindow.MainView().Image();
+      accumulator.GetResults( static_cast<Image&>( *mean ), static_cast<Image&>( *sigma ) );
+
+      meanWindow.Show();
+      sigmaWindow.Show();
+   }
 
    return true;
 }
 
+/*
+ * Open views are converted in the order of their identifiers, which is also
+ * the order in which they are locked, so that concurrent executions cannot
+ * deadlock on each other's views.
+ */
+static bool LessViewId( const View& a, const View& b )
+{
+   return a.FullId() < b.FullId();
+}
+
+/*
+ * Converts the main views of all open images concurrently into new image
+ * windows. Only single-channel CFA images are converted. Source views are
+ * locked and then unlocked for read operations, so other tasks can still read
+ * them while the worker threads do, but nothing can modify them; output
+ * images are allocated here, so that workers never create, resize or
+ * otherwise touch views, and source histories are left unchanged.
+ */
+bool CFA2RGBInstance::ExecuteViews()
+{
+   Console console;
+
+   CFA2RGBEngine engine( *this );
+   const bool coverageMaps = p_generateCoverageMaps && engine.OutputChannels() == 3;
+
+   Array<View> views;
+   Array<ImageWindow> windows = ImageWindow::AllWindows();
+   for ( Array<ImageWindow>::const_iterator i = windows.Begin(); i != windows.End(); ++i )
+   {
+      View view = i->MainView();
+      if ( !view.IsNull() )
+      {
+         ImageVariant image = view.Image();
+         if ( !image.IsComplexSample() && image->NumberOfChannels() == 1 )
+            views.Add( view );
+      }
+   }
+   if ( views.IsEmpty() )
+      throw Error( "CFA2RGB: There are no open single-channel CFA images to convert." );
+   views.Sort( LessViewId );
+
+   Array<ImageWindow> outputWindows;
+   Array<CFA2RGBCoverageMap> coverage( views.Length() );
+   CFA2RGBViewScheduler scheduler( engine );
+
+   size_type locked = 0;
+   double pixels = 0;
+   size_type rows = 0;
+   try
+   {
+      for ( ; locked < views.Length(); ++locked )
+      {
+         views[locked].Lock();
+         views[locked].UnlockForRead();
+      }
+
+      for ( size_type i = 0; i < views.Length(); ++i )
+      {
+         ImageVariant source = views[i].Image();
+         int bitsPerSample = source.BitsPerSample();
+         bool floatSample = source.IsFloatSample();
+         if ( OutputSampleFormat( bitsPerSample, floatSample ) )
+         {
+            // A quantized copy of the single-channel CFA image.
+            ImageVariant cfa;
+            cfa.CreateImage( floatSample, false/*isComplex*/, bitsPerSample );
+            cfa.CopyImage( source );
+            source = cfa;
+         }
+         int width, height;
+         engine.GetOutputDimensions( width, height, source->Width(), source->Height() );
+         rows += height;
+         ImageWindow window( width, height, engine.OutputChannels(), bitsPerSample, floatSample,
+                             engine.OutputChannels() == 3/*color*/, true/*initialProcessing*/,
+                             views[i].Id() + (engine.IsGreenOutput() ? "_G" : (engine.IsCFAOutput() ? "_CFA" : "_RGB")) );
+         outputWindows.Add( window );
+         ImageVariant target = window.MainView().Image();
+         if ( IsColorMatrixFromKeywords() )
+         {
+            FITSKeywordArray keywords;
+            views[i].Window().GetKeywords( keywords );
+            CFA2RGBColorMatrix matrix = KeywordColorMatrix( keywords, views[i].FullId() );
+            scheduler.Add( source, target, coverageMaps ? &coverage[i] : 0, &matrix );
+         }
+         else
+            scheduler.Add( source, target, coverageMaps ? &coverage[i] : 0 );
+         pixels += double( source->NumberOfPixels() );
+      }
+
+      console.WriteLn( String().Format( "<end><cbr>Converting %u open view(s)", unsigned( views.Length() ) ) );
+      CFA2RGBProgress progress;
+      progress.Initialize( "CFA2RGB: Converting open views", rows );
+      engine.SetProgress( &progress );
+      ElapsedTime T;
+      scheduler.Run();
+      engine.SetProgress( 0 );
+      if ( progress.IsAborted() )
+         throw ProcessAborted();
+      progress.Complete();
+      SetConversionTiming( T(), pixels );
+   }
+   catch ( ... )
+   {
+      while ( locked > 0 )
+         views[--locked].Unlock();
+      for ( Array<ImageWindow>::iterator i = outputWindows.Begin(); i != outputWindows.End(); ++i )
+         i->ForceClose();
+      throw;
+   }
+
+   while ( locked > 0 )
+      views[--locked].Unlock();
+
+   console.WriteLn( String().Format( "<end><cbr>%d concurrent conversion(s):", scheduler.Concurrency() ) );
+
+   int failed = 0;
+   for ( size_type i = 0; i < views.Length(); ++i )
+   {
+      ImageWindow& window = outputWindows[i];
+      if ( !scheduler.Succeeded( i ) )
+      {
+         ++failed;
+         console.CriticalLn( "<end><cbr>*** Error: " + views[i].FullId() + ": " + scheduler.ErrorMessage( i ) );
+         window.ForceClose();
+         continue;
+      }
+
+      View output = window.MainView();
+      if ( coverageMaps )
+      {
+         output.SetPropertyValue( "CFA2RGB:CoverageR", coverage[i].Plane( 0 ), false/*notify*/, ViewPropertyAttribute::Storable );
+         output.SetPropertyValue( "CFA2RGB:CoverageG", coverage[i].Plane( 1 ), false/*notify*/, ViewPropertyAttribute::Storable );
+         output.SetPropertyValue( "CFA2RGB:CoverageB", coverage[i].Plane( 2 ), false/*notify*/, ViewPropertyAttribute::Storable );
+      }
+      window.Show();
+
+      int threads = scheduler.Threads( i );
+      console.WriteLn( views[i].FullId() + " -> " + output.FullId()
+                     + ((threads > 0) ? String().Format( " (%d thread(s))", threads ) : String( " (all threads)" )) );
+   }
+
+   console.NoteLn( String().Format( "<end><cbr><br>===== CFA2RGB: %d succeeded, %d failed =====",
+                                    int( views.Length() ) - failed, failed ) );
+
+   return failed < int( views.Length() );
+}
+
+/*
+ * Target frames with a .raw extension are headerless packed sensor data,
+ * described by the rawPacking, rawWidth, rawHeight and rawStride parameters.
+ */
+bool CFA2RGBInstance::IsRawFile( const String& filePath )
+{
+   return File::ExtractExtension( filePath ).Lowercase() == ".raw";
+}
+
+/*
+ * The cache index is stored in the output directory or, if output files are
+ * written next to their target frames, in the directory of the first target
+ * frame. Entries store full paths, so a single index serves all frames.
+ */
+String CFA2RGBInstance::CacheFilePath() const
+{
+   String directory = p_outputDirectory.Trimmed();
+   if ( directory.IsEmpty() )
+      for ( image_list::const_iterator i = p_targetFrames.Begin(); i != p_targetFrames.End(); ++i )
+         if ( i->enabled )
+         {
+            directory = File::ExtractDrive( i->path ) + File::ExtractDirectory( i->path );
+            break;
+         }
+   if ( !directory.EndsWith( '/' ) )
+      directory += '/';
+   return directory + "CFA2RGB.cache";
+}
+
+/*
+ * Signature of everything but the input data that determines an output file.
+ * Bump the leading version when the conversion itself changes.
+ */
+IsoString CFA2RGBInstance::CacheSettings( const String& filePath ) const
+{
+   IsoString settings = IsoString( "v1" )
+      + ";pattern=" + TheCFA2RGBBayerPatternParameter->ElementId( p_bayerPattern )
+      + IsoString().Format( ";binning=%d", int( bool( p_blockBinning ) ) )
+      + ";output=" + TheCFA2RGBOutputModeParameter->ElementId( p_outputMode )
+      + ";interpolation=" + TheCFA2RGBInterpolationParameter->ElementId( p_interpolation )
+      + ";sampleFormat=" + TheCFA2RGBOutputSampleFormatParameter->ElementId( p_outputSampleFormat )
+      + ";compression=" + TheCFA2RGBOutputCompressionParameter->ElementId( p_outputCompression )
+      + IsoString().Format( ";shuffle=%d", int( bool( p_outputByteShuffling ) ) )
+      + ";directory=" + p_outputDirectory.Trimmed().ToUTF8()
+      + ";postfix=" + p_outputPostfix.Trimmed().ToUTF8();
+   if ( p_cellBinning != CFA2RGBCellBinningParameter::None )
+      settings += ";cellBinning=" + TheCFA2RGBCellBinningParameter->ElementId( p_cellBinning )
+               + "," + TheCFA2RGBCellBinningModeParameter->ElementId( p_cellBinningMode )
+               + "," + TheCFA2RGBCellBinningOutputParameter->ElementId( p_cellBinningOutput );
+   if ( p_correctLateralCA )
+      settings += IsoString().Format( ";lateralCA=%.8g,%.8g,%.8g/%.8g,%.8g,%.8g",
+                                      p_lateralCARed[0], p_lateralCARed[1], p_lateralCARed[2],
+                                      p_lateralCABlue[0], p_lateralCABlue[1], p_lateralCABlue[2] );
+   if ( p_applyColorMatrix )
+   {
+      // Keyword matrices are covered by the content hash of the frame.
+      settings += ";colorMatrix=" + TheCFA2RGBColorMatrixSourceParameter->ElementId( p_colorMatrixSource );
+      if ( !IsColorMatrixFromKeywords() )
+         for ( int i = 0; i < 9; ++i )
+            settings += IsoString().Format( ",%.8g", p_colorMatrix[i] );
+   }
+   if ( p_generatePyramid )
+      settings += IsoString().Format( ";pyramid=%d", p_pyramidLevels )
+               + ";format=" + TheCFA2RGBPyramidFormatParameter->ElementId( p_pyramidFormat );
+   if ( IsRawFile( filePath ) )
+      settings += ";packing=" + TheCFA2RGBRawPackingParameter->ElementId( p_rawPacking )
+               + IsoString().Format( ";raw=%dx%d/%d", p_rawWidth, p_rawHeight, p_rawStride );
+   return settings;
+}
+
+bool CFA2RGBInstance::HasRawTargets() const
+{
+   for ( image_list::const_iterator i = p_targetFrames.Begin(); i != p_targetFrames.End(); ++i )
+      if ( i->enabled && IsRawFile( i->path ) )
+         return true;
+   return false;
+}
+
+/*
+ * Output file paths are <directory>/<name><postfix>.xisf, where <directory>
+ * defaults to that of the input file. Unless overwriting is allowed, a
+ * numeric suffix is appended to avoid existing files.
+ */
+String CFA2RGBInstance::OutputFilePath( const String& filePath ) const
+{
+   String directory = p_outputDirectory.Trimmed();
+   if ( directory.IsEmpty() )
+      directory = File::ExtractDrive( filePath ) + File::ExtractDirectory( filePath );
+   if ( !directory.EndsWith( '/' ) )
+      directory += '/';
+
+   String fileName = File::ExtractName( filePath ) + p_outputPostfix.Trimmed();
+
+   String outputFilePath = directory + fileName + ".xisf";
+   if ( !p_overwriteExistingFiles )
+      for ( int u = 1; File::Exists( outputFilePath ); ++u )
+         outputFilePath = directory + fileName + String().Format( "_%d", u ) + ".xisf";
+
+   return outputFilePath;
+}
+
+size_type CFA2RGBInstance::MemoryBudget() const
+{
+   return size_type( p_memoryBudget )*1024*1024;
+}
+
+/*
+ * Converted images take three times the storage of their CFA images. With
+ * 16-bit integer output, floating point and 32-bit frames are quantized while
+ * they still have a single channel, and the expansion runs at 16 bits per
+ * sample: converted 32-bit frames take half the memory and disk space. Returns
+ * true if the output format differs from the specified input format.
+ */
+bool CFA2RGBInstance::OutputSampleFormat( int& bitsPerSample, bool& floatSample ) const
+{
+   if ( p_outputSampleFormat == CFA2RGBOutputSampleFormatParameter::UInt16 )
+      if ( floatSample || bitsPerSample > 16 )
+      {
+         bitsPerSample = 16;
+         floatSample = false;
+         return true;
+      }
+   return false;
+}
+
+/*
+ * Pyramid level files are named after the output file with a _1-<n> suffix,
+ * n being the reduction factor with respect to the converted frame. XISF
+ * levels are 32-bit floating point images; PNG thumbnails are 8-bit.
+ */
+void CFA2RGBInstance::WritePyramid( const CFA2RGBPyramid& pyramid, const String& outputFilePath, int period,
+                                    const IsoString& hints ) const
+{
+   const String extension = CFA2RGBPyramidFormatParameter::FileExtension( p_pyramidFormat );
+   const String basePath = File::ChangeExtension( outputFilePath, String() );
+
+   FileFormat format( extension, false/*read*/, true/*write*/ );
+
+   for ( int i = 0; i < pyramid.NumberOfLevels(); ++i )
+   {
+      const Image& level = pyramid.Level( i );
+      if ( level.IsEmpty() )
+         break;
+
+      String filePath = basePath + String().Format( "_1-%d", period << i ) + extension;
+      Console().WriteLn( "<end><cbr>Writing pyramid level: " + filePath );
+
+      FileFormatInstance file( format );
+      if ( !file.Create( filePath, (p_pyramidFormat == CFA2RGBPyramidFormatParameter::XISF) ? hints : IsoString() ) )
+         throw CaughtException();
+
+      ImageOptions options;
+      if ( p_pyramidFormat == CFA2RGBPyramidFormatParameter::PNG )
+      {
+         options.bitsPerSample = 8;
+         options.ieeefpSampleFormat = false;
+         file.SetOptions( options );
+         if ( !file.WriteImage( UInt8Image( level ) ) )
+            throw CaughtException();
+      }
+      else
+      {
+         options.bitsPerSample = 32;
+         options.ieeefpSampleFormat = true;
+         file.SetOptions( options );
+         if ( !file.WriteImage( level ) )
+            throw CaughtException();
+      }
+
+      file.Close();
+   }
+}
 
 // ----------------------------------------------------------------------------
 
-void* CFA2RGBInstance::LockParameter( const MetaParameter* p, size_type /*tableRow*/ )
+void* CFA2RGBInstance::LockParameter( const MetaParameter* p, size_type tableRow )
 {
    if ( p == TheCFA2RGBBayerPatternParameter )
       return &p_bayerPattern;
- 
+   if ( p == TheCFA2RGBBlockBinningParameter )
+      return &p_blockBinning;
+   if ( p == TheCFA2RGBGenerateCoverageMapsParameter )
+      return &p_generateCoverageMaps;
+   if ( p == TheCFA2RGBOutputModeParameter )
+      return &p_outputMode;
+   if ( p == TheCFA2RGBInterpolationParameter )
+      return &p_interpolation;
+   if ( p == TheCFA2RGBCellBinningParameter )
+      return &p_cellBinning;
+   if ( p == TheCFA2RGBCellBinningModeParameter )
+      return &p_cellBinningMode;
+   if ( p == TheCFA2RGBCellBinningOutputParameter )
+      return &p_cellBinningOutput;
+   if ( p == TheCFA2RGBCorrectLateralCAParameter )
+      return &p_correctLateralCA;
+   if ( p == TheCFA2RGBLateralCARedK0Parameter )
+      return p_lateralCARed + 0;
+   if ( p == TheCFA2RGBLateralCARedK1Parameter )
+      return p_lateralCARed + 1;
+   if ( p == TheCFA2RGBLateralCARedK2Parameter )
+      return p_lateralCARed + 2;
+   if ( p == TheCFA2RGBLateralCABlueK0Parameter )
+      return p_lateralCABlue + 0;
+   if ( p == TheCFA2RGBLateralCABlueK1Parameter )
+      return p_lateralCABlue + 1;
+   if ( p == TheCFA2RGBLateralCABlueK2Parameter )
+      return p_lateralCABlue + 2;
+   if ( p == TheCFA2RGBApplyColorMatrixParameter )
+      return &p_applyColorMatrix;
+   if ( p == TheCFA2RGBColorMatrixSourceParameter )
+      return &p_colorMatrixSource;
+   if ( p == TheCFA2RGBColorMatrix00Parameter )
+      return p_colorMatrix + 0;
+   if ( p == TheCFA2RGBColorMatrix01Parameter )
+      return p_colorMatrix + 1;
+   if ( p == TheCFA2RGBColorMatrix02Parameter )
+      return p_colorMatrix + 2;
+   if ( p == TheCFA2RGBColorMatrix10Parameter )
+      return p_colorMatrix + 3;
+   if ( p == TheCFA2RGBColorMatrix11Parameter )
+      return p_colorMatrix + 4;
+   if ( p == TheCFA2RGBColorMatrix12Parameter )
+      return p_colorMatrix + 5;
+   if ( p == TheCFA2RGBColorMatrix20Parameter )
+      return p_colorMatrix + 6;
+   if ( p == TheCFA2RGBColorMatrix21Parameter )
+      return p_colorMatrix + 7;
+   if ( p == TheCFA2RGBColorMatrix22Parameter )
+      return p_colorMatrix + 8;
+   if ( p == TheCFA2RGBUseROIParameter )
+      return &p_useROI;
+   if ( p == TheCFA2RGBROIX0Parameter )
+      return &p_roi.x0;
+   if ( p == TheCFA2RGBROIY0Parameter )
+      return &p_roi.y0;
+   if ( p == TheCFA2RGBROIX1Parameter )
+      return &p_roi.x1;
+   if ( p == TheCFA2RGBROIY1Parameter )
+      return &p_roi.y1;
+   if ( p == TheCFA2RGBSourceViewParameter )
+      return p_sourceView.Begin();
+   if ( p == TheCFA2RGBDirtyX0Parameter )
+      return &p_dirtyRects[tableRow].x0;
+   if ( p == TheCFA2RGBDirtyY0Parameter )
+      return &p_dirtyRects[tableRow].y0;
+   if ( p == TheCFA2RGBDirtyX1Parameter )
+      return &p_dirtyRects[tableRow].x1;
+   if ( p == TheCFA2RGBDirtyY1Parameter )
+      return &p_dirtyRects[tableRow].y1;
+   if ( p == TheCFA2RGBMemoryBudgetParameter )
+      return &p_memoryBudget;
+   if ( p == TheCFA2RGBConvertOpenViewsParameter )
+      return &p_convertOpenViews;
+   if ( p == TheCFA2RGBOutputSampleFormatParameter )
+      return &p_outputSampleFormat;
+   if ( p == TheCFA2RGBTargetFrameEnabledParameter )
+      return &p_targetFrames[tableRow].enabled;
+   if ( p == TheCFA2RGBTargetFramePathParameter )
+      return p_targetFrames[tableRow].path.Begin();
+   if ( p == TheCFA2RGBRawPackingParameter )
+      return &p_rawPacking;
+   if ( p == TheCFA2RGBRawWidthParameter )
+      return &p_rawWidth;
+   if ( p == TheCFA2RGBRawHeightParameter )
+      return &p_rawHeight;
+   if ( p == TheCFA2RGBRawStrideParameter )
+      return &p_rawStride;
+   if ( p == TheCFA2RGBOutputDirectoryParameter )
+      return p_outputDirectory.Begin();
+   if ( p == TheCFA2RGBOutputPostfixParameter )
+      return p_outputPostfix.Begin();
+   if ( p == TheCFA2RGBOverwriteExistingFilesParameter )
+      return &p_overwriteExistingFiles;
+   if ( p == TheCFA2RGBUseFileCacheParameter )
+      return &p_useFileCache;
+   if ( p == TheCFA2RGBOutputCompressionParameter )
+      return &p_outputCompression;
+   if ( p == TheCFA2RGBOutputByteShufflingParameter )
+      return &p_outputByteShuffling;
+   if ( p == TheCFA2RGBOnErrorParameter )
+      return &p_onError;
+   if ( p == TheCFA2RGBWriteOutputFilesParameter )
+      return &p_writeOutputFiles;
+   if ( p == TheCFA2RGBIntegrateFramesParameter )
+      return &p_integrateFrames;
+   if ( p == TheCFA2RGBGeneratePyramidParameter )
+      return &p_generatePyramid;
+   if ( p == TheCFA2RGBPyramidLevelsParameter )
+      return &p_pyramidLevels;
+   if ( p == TheCFA2RGBPyramidFormatParameter )
+      return &p_pyramidFormat;
+   if ( p == TheCFA2RGBClaimDirectoryParameter )
+      return p_claimDirectory.Begin();
+   if ( p == TheCFA2RGBClaimTimeoutParameter )
+      return &p_claimTimeout;
+   if ( p == TheCFA2RGBConversionTimeParameter )
+      return &o_conversionTime;
+   if ( p == TheCFA2RGBConversionRateParameter )
+      return &o_conversionRate;
+
    return 0;
 }
 
 bool CFA2RGBInstance::AllocateParameter( size_type sizeOrLength, const MetaParameter* p, size_type tableRow )
 {
-   return false;
+   if ( p == TheCFA2RGBTargetFramesParameter )
+   {
+      p_targetFrames.Clear();
+      if ( sizeOrLength > 0 )
+         p_targetFrames.Add( ImageItem(), sizeOrLength );
+   }
+   else if ( p == TheCFA2RGBTargetFramePathParameter )
+   {
+      p_targetFrames[tableRow].path.Clear();
+      if ( sizeOrLength > 0 )
+         p_targetFrames[tableRow].path.SetLength( sizeOrLength );
+   }
+   else if ( p == TheCFA2RGBSourceViewParameter )
+   {
+      p_sourceView.Clear();
+      if ( sizeOrLength > 0 )
+         p_sourceView.SetLength( sizeOrLength );
+   }
+   else if ( p == TheCFA2RGBDirtyRectsParameter )
+   {
+      p_dirtyRects.Clear();
+      if ( sizeOrLength > 0 )
+         p_dirtyRects.Add( Rect( 0 ), sizeOrLength );
+   }
+   else if ( p == TheCFA2RGBOutputDirectoryParameter )
+   {
+      p_outputDirectory.Clear();
+      if ( sizeOrLength > 0 )
+         p_outputDirectory.SetLength( sizeOrLength );
+   }
+   else if ( p == TheCFA2RGBOutputPostfixParameter )
+   {
+      p_outputPostfix.Clear();
+      if ( sizeOrLength > 0 )
+         p_outputPostfix.SetLength( sizeOrLength );
+   }
+   else if ( p == TheCFA2RGBClaimDirectoryParameter )
+   {
+      p_claimDirectory.Clear();
+      if ( sizeOrLength > 0 )
+         p_claimDirectory.SetLength( sizeOrLength );
+   }
+   else
+      return false;
+
+   return true;
 }
 
 size_type CFA2RGBInstance::ParameterLength( const MetaParameter* p, size_type tableRow ) const
 {
+   if ( p == TheCFA2RGBTargetFramesParameter )
+      return p_targetFrames.Length();
+   if ( p == TheCFA2RGBTargetFramePathParameter )
+      return p_targetFrames[tableRow].path.Length();
+   if ( p == TheCFA2RGBSourceViewParameter )
+      return p_sourceView.Length();
+   if ( p == TheCFA2RGBDirtyRectsParameter )
+      return p_dirtyRects.Length();
+   if ( p == TheCFA2RGBOutputDirectoryParameter )
+      return p_outputDirectory.Length();
+   if ( p == TheCFA2RGBOutputPostfixParameter )
+      return p_outputPostfix.Length();
+   if ( p == TheCFA2RGBClaimDirectoryParameter )
+      return p_claimDirectory.Length();
    return 0;
 }
 
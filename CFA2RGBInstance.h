@@ -53,14 +53,21 @@
 #ifndef __CFA2RGBInstance_h
 #define __CFA2RGBInstance_h
 
+#include <pcl/FITSHeaderKeyword.h>
 #include <pcl/MetaParameter.h> // for pcl_bool, pcl_enum
 #include <pcl/ProcessImplementation.h>
+#include <pcl/String.h>
 
 namespace pcl
 {
 
 // ----------------------------------------------------------------------------
 
+struct CFA2RGBColorMatrix;
+class CFA2RGBCoverageMap;
+class CFA2RGBEngine;
+class CFA2RGBPyramid;
+
 class CFA2RGBInstance : public ProcessImplementation
 {
 public:
@@ -69,8 +76,13 @@ public:
    CFA2RGBInstance( const CFA2RGBInstance& );
 
    virtual void Assign( const ProcessImplementation& );
+   virtual UndoFlags UndoMode( const View& ) const;
    virtual bool CanExecuteOn( const View&, String& whyNot ) const;
    virtual bool ExecuteOn( View& );
+   virtual bool CanExecuteOn( const ImageVariant&, String& whyNot ) const;
+   virtual bool ExecuteOn( ImageVariant&, const IsoString& hints );
+   virtual bool CanExecuteGlobal( String& whyNot ) const;
+   virtual bool ExecuteGlobal();
 
    virtual void* LockParameter( const MetaParameter*, size_type tableRow );
    virtual bool AllocateParameter( size_type sizeOrLength, const MetaParameter* p, size_type tableRow );
@@ -78,10 +90,96 @@ public:
 
 private:
 
+   struct ImageItem
+   {
+      pcl_bool enabled;
+      String   path;
+
+      ImageItem( const String& p = String() ) : enabled( true ), path( p )
+      {
+      }
+   };
+
+   typedef Array<ImageItem>  image_list;
+   typedef Array<Rect>       rect_list;
+
    /*
     * Process parameters
     */
-   pcl_enum p_bayerPattern;
+   pcl_enum   p_bayerPattern;
+   pcl_bool   p_blockBinning;
+   pcl_enum   p_cellBinning;
+   pcl_enum   p_cellBinningMode;
+   pcl_enum   p_cellBinningOutput;
+   pcl_bool   p_generateCoverageMaps;
+   pcl_enum   p_outputMode;
+   pcl_enum   p_interpolation;
+   pcl_bool   p_correctLateralCA;
+   double     p_lateralCARed[ 3 ];  // radial scale coefficients k0, k1, k2
+   double     p_lateralCABlue[ 3 ];
+   pcl_bool   p_applyColorMatrix;
+   pcl_enum   p_colorMatrixSource;
+   double     p_colorMatrix[ 9 ];   // camera to working space, row-major
+   pcl_bool   p_useROI;
+   Rect       p_roi;                // region of interest, in target image coordinates
+   String     p_sourceView;         // CFA view of an incremental update of the target view
+   rect_list  p_dirtyRects;         // changed areas of the source view, in CFA coordinates
+   int32      p_memoryBudget; // MiB
+   pcl_bool   p_convertOpenViews;
+   pcl_enum   p_outputSampleFormat;
+
+   /*
+    * Batch mode
+    */
+   image_list p_targetFrames;
+   pcl_enum   p_rawPacking;
+   int32      p_rawWidth;
+   int32      p_rawHeight;
+   int32      p_rawStride;
+   String     p_outputDirectory;
+   String     p_outputPostfix;
+   pcl_bool   p_overwriteExistingFiles;
+   pcl_bool   p_useFileCache;
+   pcl_enum   p_outputCompression;
+   pcl_bool   p_outputByteShuffling;
+   pcl_enum   p_onError;
+   pcl_bool   p_writeOutputFiles;
+   pcl_bool   p_integrateFrames;
+   pcl_bool   p_generatePyramid;
+   int32      p_pyramidLevels;
+   pcl_enum   p_pyramidFormat;
+   String     p_claimDirectory;
+   int32      p_claimTimeout; // s
+
+   /*
+    * Read-only output properties
+    */
+   double     o_conversionTime; // s
+   double     o_conversionRate; // Mpx/s
+
+   size_type MemoryBudget() const;
+   bool OutputSampleFormat( int& bitsPerSample, bool& floatSample ) const;
+
+   bool ExecuteViews();
+   bool UpdateView( View& );
+
+   Rect RegionOfInterest( const ImageVariant& ) const;
+   void ConvertImage( const CFA2RGBEngine&, ImageVariant&, const Rect& roi, const Point& origin,
+                      CFA2RGBCoverageMap* coverage = 0 ) const;
+
+   bool IsColorMatrixFromKeywords() const;
+   CFA2RGBColorMatrix KeywordColorMatrix( const FITSKeywordArray&, const String& imageId ) const;
+
+   void SetConversionTiming( double seconds, double pixels );
+
+   String OutputFilePath( const String& filePath ) const;
+   void WritePyramid( const CFA2RGBPyramid&, const String& outputFilePath, int period, const IsoString& hints ) const;
+
+   String CacheFilePath() const;
+   IsoString CacheSettings( const String& filePath ) const;
+
+   static bool IsRawFile( const String& filePath );
+   bool HasRawTargets() const;
 
    friend class CFA2RGBProcess;
    friend class CFA2RGBInterface;
@@ -54,6 +54,9 @@
 #include "CFA2RGBProcess.h"
 #include "CFA2RGBParameters.h"
 
+#include <pcl/File.h>
+#include <pcl/FileDialog.h>
+
 namespace pcl
 {
 
@@ -85,11 +88,21 @@ MetaProcess* CFA2RGBInterface::Process() const
    return TheCFA2RGBProcess;
 }
 
+InterfaceFeatures CFA2RGBInterface::Features() const
+{
+   return InterfaceFeature::Default | InterfaceFeature::ApplyGlobalButton;
+}
+
 void CFA2RGBInterface::ApplyInstance() const
 {
    instance.LaunchOnCurrentView();
 }
 
+void CFA2RGBInterface::ApplyInstanceGlobal() const
+{
+   instance.LaunchGlobal();
+}
+
 void CFA2RGBInterface::ResetInstance()
 {
    CFA2RGBInstance defaultInstance( TheCFA2RGBProcess );
@@ -144,6 +157,126 @@ bool CFA2RGBInterface::ImportProcess( const ProcessImplementation& p )
 void CFA2RGBInterface::UpdateControls()
 {
    GUI->BayerPatternCombo.SetCurrentItem( instance.p_bayerPattern );
+
+   const bool rgbOutput = instance.p_outputMode == CFA2RGBOutputModeParameter::RGB;
+
+   GUI->OutputModeCombo.SetCurrentItem( instance.p_outputMode );
+   GUI->InterpolationCombo.SetCurrentItem( instance.p_interpolation );
+   GUI->InterpolationCombo.Enable( rgbOutput );
+
+   const bool interpolating = rgbOutput && instance.p_interpolation != CFA2RGBInterpolationParameter::None;
+   GUI->CorrectLateralCA_CheckBox.SetChecked( instance.p_correctLateralCA );
+   GUI->CorrectLateralCA_CheckBox.Enable( interpolating );
+   GUI->LateralCARedK0_NumericEdit.SetValue( instance.p_lateralCARed[0] );
+   GUI->LateralCARedK1_NumericEdit.SetValue( instance.p_lateralCARed[1] );
+   GUI->LateralCARedK2_NumericEdit.SetValue( instance.p_lateralCARed[2] );
+   GUI->LateralCABlueK0_NumericEdit.SetValue( instance.p_lateralCABlue[0] );
+   GUI->LateralCABlueK1_NumericEdit.SetValue( instance.p_lateralCABlue[1] );
+   GUI->LateralCABlueK2_NumericEdit.SetValue( instance.p_lateralCABlue[2] );
+   const bool correctingCA = interpolating && instance.p_correctLateralCA;
+   GUI->LateralCARedK0_NumericEdit.Enable( correctingCA );
+   GUI->LateralCARedK1_NumericEdit.Enable( correctingCA );
+   GUI->LateralCARedK2_NumericEdit.Enable( correctingCA );
+   GUI->LateralCABlueK0_NumericEdit.Enable( correctingCA );
+   GUI->LateralCABlueK1_NumericEdit.Enable( correctingCA );
+   GUI->LateralCABlueK2_NumericEdit.Enable( correctingCA );
+   GUI->ApplyColorMatrix_CheckBox.SetChecked( instance.p_applyColorMatrix );
+   GUI->ApplyColorMatrix_CheckBox.Enable( interpolating );
+   GUI->ColorMatrixSource_ComboBox.SetCurrentItem( instance.p_colorMatrixSource );
+   const bool applyingMatrix = interpolating && instance.p_applyColorMatrix;
+   GUI->ColorMatrixSource_ComboBox.Enable( applyingMatrix );
+   NumericEdit* colorMatrixEdits[] = { &GUI->ColorMatrix00_NumericEdit, &GUI->ColorMatrix01_NumericEdit, &GUI->ColorMatrix02_NumericEdit,
+                                       &GUI->ColorMatrix10_NumericEdit, &GUI->ColorMatrix11_NumericEdit, &GUI->ColorMatrix12_NumericEdit,
+                                       &GUI->ColorMatrix20_NumericEdit, &GUI->ColorMatrix21_NumericEdit, &GUI->ColorMatrix22_NumericEdit };
+   for ( int i = 0; i < 9; ++i )
+   {
+      colorMatrixEdits[i]->SetValue( instance.p_colorMatrix[i] );
+      colorMatrixEdits[i]->Enable( applyingMatrix && !instance.IsColorMatrixFromKeywords() );
+   }
+   GUI->OutputSampleFormatCombo.SetCurrentItem( instance.p_outputSampleFormat );
+
+   GUI->BlockBinning_CheckBox.SetChecked( instance.p_blockBinning );
+   GUI->BlockBinning_CheckBox.Enable( rgbOutput && instance.p_bayerPattern >= CFA2RGBBayerPatternParameter::QuadRGGB );
+
+   const bool blockBinning = instance.p_blockBinning && instance.p_bayerPattern >= CFA2RGBBayerPatternParameter::QuadRGGB;
+   const bool cellBinning = rgbOutput && !blockBinning && instance.p_cellBinning != CFA2RGBCellBinningParameter::None;
+   GUI->CellBinningCombo.SetCurrentItem( instance.p_cellBinning );
+   GUI->CellBinningCombo.Enable( rgbOutput );
+   GUI->CellBinningModeCombo.SetCurrentItem( instance.p_cellBinningMode );
+   GUI->CellBinningModeCombo.Enable( cellBinning );
+   GUI->CellBinningOutputCombo.SetCurrentItem( instance.p_cellBinningOutput );
+   GUI->CellBinningOutputCombo.Enable( cellBinning );
+
+   GUI->GenerateCoverageMaps_CheckBox.SetChecked( instance.p_generateCoverageMaps );
+   GUI->GenerateCoverageMaps_CheckBox.Enable( rgbOutput );
+
+   GUI->UseROI_CheckBox.SetChecked( instance.p_useROI );
+   GUI->ROIX0_SpinBox.SetValue( instance.p_roi.x0 );
+   GUI->ROIY0_SpinBox.SetValue( instance.p_roi.y0 );
+   GUI->ROIX1_SpinBox.SetValue( instance.p_roi.x1 );
+   GUI->ROIY1_SpinBox.SetValue( instance.p_roi.y1 );
+   GUI->ROIX0_SpinBox.Enable( instance.p_useROI );
+   GUI->ROIY0_SpinBox.Enable( instance.p_useROI );
+   GUI->ROIX1_SpinBox.Enable( instance.p_useROI );
+   GUI->ROIY1_SpinBox.Enable( instance.p_useROI );
+
+   GUI->MemoryBudget_SpinBox.SetValue( instance.p_memoryBudget );
+
+   GUI->ConvertOpenViews_CheckBox.SetChecked( instance.p_convertOpenViews );
+
+   UpdateTargetFramesList();
+
+   GUI->RawPacking_ComboBox.SetCurrentItem( instance.p_rawPacking );
+   GUI->RawWidth_SpinBox.SetValue( instance.p_rawWidth );
+   GUI->RawHeight_SpinBox.SetValue( instance.p_rawHeight );
+   GUI->RawStride_SpinBox.SetValue( instance.p_rawStride );
+
+   GUI->OutputDirectory_Edit.SetText( instance.p_outputDirectory );
+   GUI->OutputPostfix_Edit.SetText( instance.p_outputPostfix );
+   GUI->OnError_ComboBox.SetCurrentItem( instance.p_onError );
+   GUI->ClaimDirectory_Edit.SetText( instance.p_claimDirectory );
+   GUI->ClaimTimeout_SpinBox.SetValue( instance.p_claimTimeout );
+   GUI->ClaimTimeout_SpinBox.Enable( !instance.p_claimDirectory.IsEmpty() );
+   GUI->WriteOutputFiles_CheckBox.SetChecked( instance.p_writeOutputFiles );
+   GUI->OverwriteExistingFiles_CheckBox.SetChecked( instance.p_overwriteExistingFiles );
+   GUI->OverwriteExistingFiles_CheckBox.Enable( instance.p_writeOutputFiles );
+   GUI->UseFileCache_CheckBox.SetChecked( instance.p_useFileCache );
+   GUI->UseFileCache_CheckBox.Enable( instance.p_writeOutputFiles && !instance.p_integrateFrames &&
+                                      instance.p_claimDirectory.IsEmpty() );
+   GUI->OutputCompression_ComboBox.SetCurrentItem( instance.p_outputCompression );
+   GUI->OutputCompression_ComboBox.Enable( instance.p_writeOutputFiles );
+   GUI->OutputByteShuffling_CheckBox.SetChecked( instance.p_outputByteShuffling );
+   GUI->OutputByteShuffling_CheckBox.Enable( instance.p_writeOutputFiles &&
+                        instance.p_outputCompression != CFA2RGBOutputCompressionParameter::None );
+   GUI->GeneratePyramid_CheckBox.SetChecked( instance.p_generatePyramid );
+   GUI->GeneratePyramid_CheckBox.Enable( rgbOutput && instance.p_writeOutputFiles );
+   GUI->PyramidLevels_SpinBox.SetValue( instance.p_pyramidLevels );
+   GUI->PyramidLevels_SpinBox.Enable( rgbOutput && instance.p_writeOutputFiles && instance.p_generatePyramid );
+   GUI->PyramidFormat_ComboBox.SetCurrentItem( instance.p_pyramidFormat );
+   GUI->PyramidFormat_ComboBox.Enable( rgbOutput && instance.p_writeOutputFiles && instance.p_generatePyramid );
+   GUI->IntegrateFrames_CheckBox.SetChecked( instance.p_integrateFrames );
+   GUI->IntegrateFrames_CheckBox.Enable( rgbOutput );
+}
+
+void CFA2RGBInterface::UpdateTargetFramesList()
+{
+   GUI->TargetFrames_TreeBox.DisableUpdates();
+   GUI->TargetFrames_TreeBox.Clear();
+
+   for ( size_type i = 0; i < instance.p_targetFrames.Length(); ++i )
+   {
+      const CFA2RGBInstance::ImageItem& item = instance.p_targetFrames[i];
+      TreeBox::Node* node = new TreeBox::Node( GUI->TargetFrames_TreeBox );
+      node->SetText( 0, String( int( i+1 ) ) );
+      node->SetIcon( 1, Bitmap( ScaledResource( item.enabled ? ":/browser/enabled.png" : ":/browser/disabled.png" ) ) );
+      node->SetText( 2, File::ExtractNameAndExtension( item.path ) );
+      node->SetToolTip( 2, item.path );
+   }
+
+   GUI->TargetFrames_TreeBox.AdjustColumnWidthToContents( 0 );
+   GUI->TargetFrames_TreeBox.AdjustColumnWidthToContents( 1 );
+   GUI->TargetFrames_TreeBox.AdjustColumnWidthToContents( 2 );
+   GUI->TargetFrames_TreeBox.EnableUpdates();
 }
 
 // ----------------------------------------------------------------------------
@@ -151,21 +284,259 @@ void CFA2RGBInterface::UpdateControls()
 void CFA2RGBInterface::__ItemSelected( ComboBox& sender, int itemIndex )
 {
    if ( sender == GUI->BayerPatternCombo )
+   {
       instance.p_bayerPattern = itemIndex;
+      UpdateControls();
+   }
+   else if ( sender == GUI->OutputModeCombo )
+   {
+      instance.p_outputMode = itemIndex;
+      UpdateControls();
+   }
+   else if ( sender == GUI->InterpolationCombo )
+   {
+      instance.p_interpolation = itemIndex;
+      UpdateControls();
+   }
+   else if ( sender == GUI->ColorMatrixSource_ComboBox )
+   {
+      instance.p_colorMatrixSource = itemIndex;
+      UpdateControls();
+   }
+   else if ( sender == GUI->OutputSampleFormatCombo )
+      instance.p_outputSampleFormat = itemIndex;
+   else if ( sender == GUI->CellBinningCombo )
+   {
+      instance.p_cellBinning = itemIndex;
+      UpdateControls();
+   }
+   else if ( sender == GUI->CellBinningModeCombo )
+      instance.p_cellBinningMode = itemIndex;
+   else if ( sender == GUI->CellBinningOutputCombo )
+      instance.p_cellBinningOutput = itemIndex;
+   else if ( sender == GUI->OnError_ComboBox )
+      instance.p_onError = itemIndex;
+   else if ( sender == GUI->RawPacking_ComboBox )
+      instance.p_rawPacking = itemIndex;
+   else if ( sender == GUI->OutputCompression_ComboBox )
+   {
+      instance.p_outputCompression = itemIndex;
+      UpdateControls();
+   }
+   else if ( sender == GUI->PyramidFormat_ComboBox )
+      instance.p_pyramidFormat = itemIndex;
+}
+
+void CFA2RGBInterface::__Click( Button& sender, bool checked )
+{
+   if ( sender == GUI->BlockBinning_CheckBox )
+   {
+      instance.p_blockBinning = checked;
+      UpdateControls();
+   }
+   else if ( sender == GUI->GenerateCoverageMaps_CheckBox )
+      instance.p_generateCoverageMaps = checked;
+   else if ( sender == GUI->ConvertOpenViews_CheckBox )
+      instance.p_convertOpenViews = checked;
+   else if ( sender == GUI->UseROI_CheckBox )
+   {
+      instance.p_useROI = checked;
+      UpdateControls();
+   }
+   else if ( sender == GUI->CorrectLateralCA_CheckBox )
+   {
+      instance.p_correctLateralCA = checked;
+      UpdateControls();
+   }
+   else if ( sender == GUI->ApplyColorMatrix_CheckBox )
+   {
+      instance.p_applyColorMatrix = checked;
+      UpdateControls();
+   }
+   else if ( sender == GUI->AddFiles_PushButton )
+   {
+      OpenFileDialog d;
+      d.SetCaption( "CFA2RGB: Select Target Frames" );
+      d.LoadImageFilters();
+      d.EnableMultipleSelections();
+      if ( d.Execute() )
+      {
+         const StringList& fileNames = d.FileNames();
+         for ( StringList::const_iterator i = fileNames.Begin(); i != fileNames.End(); ++i )
+            instance.p_targetFrames.Add( CFA2RGBInstance::ImageItem( *i ) );
+         UpdateTargetFramesList();
+      }
+   }
+   else if ( sender == GUI->ToggleFrame_PushButton )
+   {
+      for ( int i = 0, n = GUI->TargetFrames_TreeBox.NumberOfChildren(); i < n; ++i )
+         if ( GUI->TargetFrames_TreeBox.Child( i )->IsSelected() )
+            instance.p_targetFrames[i].enabled = !instance.p_targetFrames[i].enabled;
+      UpdateTargetFramesList();
+   }
+   else if ( sender == GUI->RemoveFrames_PushButton )
+   {
+      CFA2RGBInstance::image_list frames;
+      for ( int i = 0, n = GUI->TargetFrames_TreeBox.NumberOfChildren(); i < n; ++i )
+         if ( !GUI->TargetFrames_TreeBox.Child( i )->IsSelected() )
+            frames.Add( instance.p_targetFrames[i] );
+      instance.p_targetFrames = frames;
+      UpdateTargetFramesList();
+   }
+   else if ( sender == GUI->ClearFrames_PushButton )
+   {
+      instance.p_targetFrames.Clear();
+      UpdateTargetFramesList();
+   }
+   else if ( sender == GUI->OutputDirectory_ToolButton )
+   {
+      GetDirectoryDialog d;
+      d.SetCaption( "CFA2RGB: Select Output Directory" );
+      if ( d.Execute() )
+         GUI->OutputDirectory_Edit.SetText( instance.p_outputDirectory = d.Directory() );
+   }
+   else if ( sender == GUI->ClaimDirectory_ToolButton )
+   {
+      GetDirectoryDialog d;
+      d.SetCaption( "CFA2RGB: Select Claim Directory" );
+      if ( d.Execute() )
+      {
+         instance.p_claimDirectory = d.Directory();
+         UpdateControls();
+      }
+   }
+   else if ( sender == GUI->WriteOutputFiles_CheckBox )
+   {
+      instance.p_writeOutputFiles = checked;
+      UpdateControls();
+   }
+   else if ( sender == GUI->OverwriteExistingFiles_CheckBox )
+      instance.p_overwriteExistingFiles = checked;
+   else if ( sender == GUI->UseFileCache_CheckBox )
+      instance.p_useFileCache = checked;
+   else if ( sender == GUI->OutputByteShuffling_CheckBox )
+      instance.p_outputByteShuffling = checked;
+   else if ( sender == GUI->GeneratePyramid_CheckBox )
+   {
+      instance.p_generatePyramid = checked;
+      UpdateControls();
+   }
+   else if ( sender == GUI->IntegrateFrames_CheckBox )
+   {
+      instance.p_integrateFrames = checked;
+      UpdateControls();
+   }
+}
+
+void CFA2RGBInterface::__EditCompleted( Edit& sender )
+{
+   String text = sender.Text().Trimmed();
+   if ( sender == GUI->OutputDirectory_Edit )
+      instance.p_outputDirectory = text;
+   else if ( sender == GUI->OutputPostfix_Edit )
+      instance.p_outputPostfix = text;
+   else if ( sender == GUI->ClaimDirectory_Edit )
+   {
+      instance.p_claimDirectory = text;
+      UpdateControls();
+   }
+   sender.SetText( text );
+}
+
+void CFA2RGBInterface::__SpinValueUpdated( SpinBox& sender, int value )
+{
+   if ( sender == GUI->RawWidth_SpinBox )
+      instance.p_rawWidth = value;
+   else if ( sender == GUI->RawHeight_SpinBox )
+      instance.p_rawHeight = value;
+   else if ( sender == GUI->RawStride_SpinBox )
+      instance.p_rawStride = value;
+   else if ( sender == GUI->PyramidLevels_SpinBox )
+      instance.p_pyramidLevels = value;
+   else if ( sender == GUI->ROIX0_SpinBox )
+      instance.p_roi.x0 = value;
+   else if ( sender == GUI->ROIY0_SpinBox )
+      instance.p_roi.y0 = value;
+   else if ( sender == GUI->ROIX1_SpinBox )
+      instance.p_roi.x1 = value;
+   else if ( sender == GUI->ROIY1_SpinBox )
+      instance.p_roi.y1 = value;
+   else if ( sender == GUI->MemoryBudget_SpinBox )
+      instance.p_memoryBudget = value;
+   else if ( sender == GUI->ClaimTimeout_SpinBox )
+      instance.p_claimTimeout = value;
+}
+
+void CFA2RGBInterface::__NumericValueUpdated( NumericEdit& sender, double value )
+{
+   if ( sender == GUI->LateralCARedK0_NumericEdit )
+      instance.p_lateralCARed[0] = value;
+   else if ( sender == GUI->LateralCARedK1_NumericEdit )
+      instance.p_lateralCARed[1] = value;
+   else if ( sender == GUI->LateralCARedK2_NumericEdit )
+      instance.p_lateralCARed[2] = value;
+   else if ( sender == GUI->LateralCABlueK0_NumericEdit )
+      instance.p_lateralCABlue[0] = value;
+   else if ( sender == GUI->LateralCABlueK1_NumericEdit )
+      instance.p_lateralCABlue[1] = value;
+   else if ( sender == GUI->LateralCABlueK2_NumericEdit )
+      instance.p_lateralCABlue[2] = value;
+   else if ( sender == GUI->ColorMatrix00_NumericEdit )
+      instance.p_colorMatrix[0] = value;
+   else if ( sender == GUI->ColorMatrix01_NumericEdit )
+      instance.p_colorMatrix[1] = value;
+   else if ( sender == GUI->ColorMatrix02_NumericEdit )
+      instance.p_colorMatrix[2] = value;
+   else if ( sender == GUI->ColorMatrix10_NumericEdit )
+      instance.p_colorMatrix[3] = value;
+   else if ( sender == GUI->ColorMatrix11_NumericEdit )
+      instance.p_colorMatrix[4] = value;
+   else if ( sender == GUI->ColorMatrix12_NumericEdit )
+      instance.p_colorMatrix[5] = value;
+   else if ( sender == GUI->ColorMatrix20_NumericEdit )
+      instance.p_colorMatrix[6] = value;
+   else if ( sender == GUI->ColorMatrix21_NumericEdit )
+      instance.p_colorMatrix[7] = value;
+   else if ( sender == GUI->ColorMatrix22_NumericEdit )
+      instance.p_colorMatrix[8] = value;
+}
+
+void CFA2RGBInterface::__NodeActivated( TreeBox& sender, TreeBox::Node& node, int col )
+{
+   int index = sender.ChildIndex( &node );
+   if ( index < 0 || size_type( index ) >= instance.p_targetFrames.Length() )
+      return;
+
+   if ( col == 1 )
+   {
+      instance.p_targetFrames[index].enabled = !instance.p_targetFrames[index].enabled;
+      UpdateTargetFramesList();
+   }
 }
 
 // ----------------------------------------------------------------------------
 
 CFA2RGBInterface::GUIData::GUIData( CFA2RGBInterface& w )
 {
+   pcl::Font fnt = w.Font();
+   int labelWidth1 = fnt.Width( String( "Bayer pattern:" ) + 'T' );
+
    PatternLabel.SetText( "Bayer pattern:" );
    PatternLabel.SetTextAlignment( TextAlign::Right|TextAlign::VertCenter );
-   PatternLabel.AdjustToContents();
+   PatternLabel.SetMinWidth( labelWidth1 );
 
    BayerPatternCombo.AddItem( "RGGB" );
    BayerPatternCombo.AddItem( "BGGR" );
    BayerPatternCombo.AddItem( "GBRG" );
    BayerPatternCombo.AddItem( "GRBG" );
+   BayerPatternCombo.AddItem( "Quad-Bayer RGGB" );
+   BayerPatternCombo.AddItem( "Quad-Bayer BGGR" );
+   BayerPatternCombo.AddItem( "Quad-Bayer GBRG" );
+   BayerPatternCombo.AddItem( "Quad-Bayer GRBG" );
+   BayerPatternCombo.AddItem( "Nonacell RGGB" );
+   BayerPatternCombo.AddItem( "Nonacell BGGR" );
+   BayerPatternCombo.AddItem( "Nonacell GBRG" );
+   BayerPatternCombo.AddItem( "Nonacell GRBG" );
    BayerPatternCombo.AdjustToContents();
    BayerPatternCombo.OnItemSelected( (ComboBox::item_event_handler)&CFA2RGBInterface::__ItemSelected, w );
 
@@ -173,13 +544,660 @@ CFA2RGBInterface::GUIData::GUIData( CFA2RGBInterface& w )
    PatternSizer.Add( PatternLabel );
    PatternSizer.Add( BayerPatternCombo );
 
+   OutputModeLabel.SetText( "Output:" );
+   OutputModeLabel.SetTextAlignment( TextAlign::Right|TextAlign::VertCenter );
+   OutputModeLabel.SetMinWidth( labelWidth1 );
+
+   OutputModeCombo.AddItem( "RGB" );
+   OutputModeCombo.AddItem( "Green" );
+   OutputModeCombo.AddItem( "Green superpixel" );
+   OutputModeCombo.AdjustToContents();
+   OutputModeCombo.SetToolTip( "<p><b>RGB</b> expands the CFA into sparse R, G and B planes.</p>"
+      "<p><b>Green</b> generates a single-channel luminance image for star detection and registration: green "
+      "samples are copied and red and blue sites are filled with the mean of their nearest green neighbors.</p>"
+      "<p><b>Green superpixel</b> generates one pixel per pattern cell, the mean of its green samples: half "
+      "resolution for Bayer patterns.</p>" );
+   OutputModeCombo.OnItemSelected( (ComboBox::item_event_handler)&CFA2RGBInterface::__ItemSelected, w );
+
+   OutputModeSizer.SetSpacing( 4 );
+   OutputModeSizer.Add( OutputModeLabel );
+   OutputModeSizer.Add( OutputModeCombo );
+
+   const char* interpolationToolTip = "<p>Interpolation of the missing samples of RGB output.</p>"
+      "<p><b>None</b> leaves missing samples at zero, producing sparse R, G and B planes.</p>"
+      "<p><b>Bilinear</b> fills each missing sample with the mean of the nearest sites of its channel.</p>"
+      "<p><b>Gradient</b> is bilinear interpolation that, where a channel has two horizontal and two vertical "
+      "neighbors, such as green at red and blue sites of a Bayer pattern, averages only the pair along the "
+      "direction of smaller variation, preserving edges.</p>"
+      "<p>8-bit and 16-bit integer images are interpolated with integer arithmetic. Block-binned output is not "
+      "interpolated.</p>";
+
+   InterpolationLabel.SetText( "Interpolation:" );
+   InterpolationLabel.SetTextAlignment( TextAlign::Right|TextAlign::VertCenter );
+   InterpolationLabel.SetMinWidth( labelWidth1 );
+   InterpolationLabel.SetToolTip( interpolationToolTip );
+
+   InterpolationCombo.AddItem( "None" );
+   InterpolationCombo.AddItem( "Bilinear" );
+   InterpolationCombo.AddItem( "Gradient" );
+   InterpolationCombo.AdjustToContents();
+   InterpolationCombo.SetToolTip( interpolationToolTip );
+   InterpolationCombo.OnItemSelected( (ComboBox::item_event_handler)&CFA2RGBInterface::__ItemSelected, w );
+
+   InterpolationSizer.SetSpacing( 4 );
+   InterpolationSizer.Add( InterpolationLabel );
+   InterpolationSizer.Add( InterpolationCombo );
+   InterpolationSizer.AddStretch();
+
+   const char* lateralCAToolTip = "<p>Correct lateral chromatic aberration while interpolating. The red and blue "
+      "channels of each pixel are sampled at a radially scaled position, relative to the center of the image, "
+      "from the original CFA samples, so no separate resampling pass is needed. The scale at a distance r from the "
+      "center, normalized to the half diagonal of the image, is 1 + k0 + k1*r<sup>2</sup> + k2*r<sup>4</sup>; "
+      "a scale greater than one samples the channel farther from the center, shrinking its image.</p>"
+      "<p>Only available with interpolated RGB output.</p>";
+
+   CorrectLateralCA_CheckBox.SetText( "Correct lateral CA" );
+   CorrectLateralCA_CheckBox.SetToolTip( lateralCAToolTip );
+   CorrectLateralCA_CheckBox.OnClick( (Button::click_event_handler)&CFA2RGBInterface::__Click, w );
+
+   CorrectLateralCA_Sizer.AddUnscaledSpacing( labelWidth1 + 4 );
+   CorrectLateralCA_Sizer.Add( CorrectLateralCA_CheckBox );
+   CorrectLateralCA_Sizer.AddStretch();
+
+   LateralCARed_Label.SetText( "Red scale:" );
+   LateralCARed_Label.SetTextAlignment( TextAlign::Right|TextAlign::VertCenter );
+   LateralCARed_Label.SetMinWidth( labelWidth1 );
+   LateralCARed_Label.SetToolTip( lateralCAToolTip );
+
+   LateralCABlue_Label.SetText( "Blue scale:" );
+   LateralCABlue_Label.SetTextAlignment( TextAlign::Right|TextAlign::VertCenter );
+   LateralCABlue_Label.SetMinWidth( labelWidth1 );
+   LateralCABlue_Label.SetToolTip( lateralCAToolTip );
+
+   NumericEdit* lateralCAEdits[] = { &LateralCARedK0_NumericEdit, &LateralCARedK1_NumericEdit, &LateralCARedK2_NumericEdit,
+                                     &LateralCABlueK0_NumericEdit, &LateralCABlueK1_NumericEdit, &LateralCABlueK2_NumericEdit };
+   for ( int i = 0; i < 6; ++i )
+   {
+      NumericEdit& e = *lateralCAEdits[i];
+      e.label.SetText( String().Format( "k%d:", i % 3 ) );
+      e.SetReal();
+      e.SetRange( TheCFA2RGBLateralCARedK0Parameter->MinimumValue(), TheCFA2RGBLateralCARedK0Parameter->MaximumValue() );
+      e.SetPrecision( TheCFA2RGBLateralCARedK0Parameter->Precision() );
+      e.EnableFixedPrecision();
+      e.EnableFixedSign();
+      e.SetToolTip( lateralCAToolTip );
+      e.OnValueUpdated( (NumericEdit::value_event_handler)&CFA2RGBInterface::__NumericValueUpdated, w );
+   }
+
+   LateralCARed_Sizer.SetSpacing( 4 );
+   LateralCARed_Sizer.Add( LateralCARed_Label );
+   LateralCARed_Sizer.Add( LateralCARedK0_NumericEdit );
+   LateralCARed_Sizer.Add( LateralCARedK1_NumericEdit );
+   LateralCARed_Sizer.Add( LateralCARedK2_NumericEdit );
+   LateralCARed_Sizer.AddStretch();
+
+   LateralCABlue_Sizer.SetSpacing( 4 );
+   LateralCABlue_Sizer.Add( LateralCABlue_Label );
+   LateralCABlue_Sizer.Add( LateralCABlueK0_NumericEdit );
+   LateralCABlue_Sizer.Add( LateralCABlueK1_NumericEdit );
+   LateralCABlue_Sizer.Add( LateralCABlueK2_NumericEdit );
+   LateralCABlue_Sizer.AddStretch();
+
+   const char* colorMatrixToolTip = "<p>Apply a 3x3 camera to working space color matrix to the interpolated RGB "
+      "pixels. The matrix is applied to each row as soon as its channels have been interpolated, while the row is "
+      "still in cache, so no separate color conversion pass over the RGB image is needed.</p>"
+      "<p><b>Parameters</b> uses the matrix given below, row-major, mapping camera RGB to working space RGB. "
+      "<b>FITS keywords</b> reads the matrix of each image from its FWDMAT11 ... FWDMAT33 keywords.</p>"
+      "<p>Only available with interpolated RGB output.</p>";
+
+   ApplyColorMatrix_CheckBox.SetText( "Apply color matrix" );
+   ApplyColorMatrix_CheckBox.SetToolTip( colorMatrixToolTip );
+   ApplyColorMatrix_CheckBox.OnClick( (Button::click_event_handler)&CFA2RGBInterface::__Click, w );
+
+   ColorMatrixSource_Label.SetText( "Source:" );
+   ColorMatrixSource_Label.SetTextAlignment( TextAlign::Right|TextAlign::VertCenter );
+   ColorMatrixSource_Label.SetToolTip( colorMatrixToolTip );
+
+   ColorMatrixSource_ComboBox.AddItem( "Parameters" );
+   ColorMatrixSource_ComboBox.AddItem( "FITS keywords" );
+   ColorMatrixSource_ComboBox.AdjustToContents();
+   ColorMatrixSource_ComboBox.SetToolTip( colorMatrixToolTip );
+   ColorMatrixSource_ComboBox.OnItemSelected( (ComboBox::item_event_handler)&CFA2RGBInterface::__ItemSelected, w );
+
+   ApplyColorMatrix_Sizer.SetSpacing( 4 );
+   ApplyColorMatrix_Sizer.AddUnscaledSpacing( labelWidth1 );
+   ApplyColorMatrix_Sizer.Add( ApplyColorMatrix_CheckBox );
+   ApplyColorMatrix_Sizer.AddSpacing( 8 );
+   ApplyColorMatrix_Sizer.Add( ColorMatrixSource_Label );
+   ApplyColorMatrix_Sizer.Add( ColorMatrixSource_ComboBox );
+   ApplyColorMatrix_Sizer.AddStretch();
+
+   Label* colorMatrixLabels[] = { &ColorMatrixRow0_Label, &ColorMatrixRow1_Label, &ColorMatrixRow2_Label };
+   const char* colorMatrixRows[] = { "Red:", "Green:", "Blue:" };
+   for ( int i = 0; i < 3; ++i )
+   {
+      Label& l = *colorMatrixLabels[i];
+      l.SetText( colorMatrixRows[i] );
+      l.SetTextAlignment( TextAlign::Right|TextAlign::VertCenter );
+      l.SetMinWidth( labelWidth1 );
+      l.SetToolTip( colorMatrixToolTip );
+   }
+
+   NumericEdit* colorMatrixEdits[] = { &ColorMatrix00_NumericEdit, &ColorMatrix01_NumericEdit, &ColorMatrix02_NumericEdit,
+                                       &ColorMatrix10_NumericEdit, &ColorMatrix11_NumericEdit, &ColorMatrix12_NumericEdit,
+                                       &ColorMatrix20_NumericEdit, &ColorMatrix21_NumericEdit, &ColorMatrix22_NumericEdit };
+   for ( int i = 0; i < 9; ++i )
+   {
+      NumericEdit& e = *colorMatrixEdits[i];
+      e.label.Hide();
+      e.SetReal();
+      e.SetRange( TheCFA2RGBColorMatrix00Parameter->MinimumValue(), TheCFA2RGBColorMatrix00Parameter->MaximumValue() );
+      e.SetPrecision( TheCFA2RGBColorMatrix00Parameter->Precision() );
+      e.EnableFixedPrecision();
+      e.EnableFixedSign();
+      e.SetToolTip( colorMatrixToolTip );
+      e.OnValueUpdated( (NumericEdit::value_event_handler)&CFA2RGBInterface::__NumericValueUpdated, w );
+   }
+
+   ColorMatrixRow0_Sizer.SetSpacing( 4 );
+   ColorMatrixRow0_Sizer.Add( ColorMatrixRow0_Label );
+   ColorMatrixRow0_Sizer.Add( ColorMatrix00_NumericEdit );
+   ColorMatrixRow0_Sizer.Add( ColorMatrix01_NumericEdit );
+   ColorMatrixRow0_Sizer.Add( ColorMatrix02_NumericEdit );
+   ColorMatrixRow0_Sizer.AddStretch();
+
+   ColorMatrixRow1_Sizer.SetSpacing( 4 );
+   ColorMatrixRow1_Sizer.Add( ColorMatrixRow1_Label );
+   ColorMatrixRow1_Sizer.Add( ColorMatrix10_NumericEdit );
+   ColorMatrixRow1_Sizer.Add( ColorMatrix11_NumericEdit );
+   ColorMatrixRow1_Sizer.Add( ColorMatrix12_NumericEdit );
+   ColorMatrixRow1_Sizer.AddStretch();
+
+   ColorMatrixRow2_Sizer.SetSpacing( 4 );
+   ColorMatrixRow2_Sizer.Add( ColorMatrixRow2_Label );
+   ColorMatrixRow2_Sizer.Add( ColorMatrix20_NumericEdit );
+   ColorMatrixRow2_Sizer.Add( ColorMatrix21_NumericEdit );
+   ColorMatrixRow2_Sizer.Add( ColorMatrix22_NumericEdit );
+   ColorMatrixRow2_Sizer.AddStretch();
+
+   const char* outputSampleFormatToolTip = "<p>Sample format of the converted images.</p>"
+      "<p><b>Same as input</b> keeps the sample format of the CFA images.</p>"
+      "<p><b>16-bit integer</b> quantizes floating point and 32-bit integer CFA images to 16 bits before they are "
+      "expanded, which halves the memory and disk space taken by the converted images of 32-bit frames. Previews "
+      "are always converted in the sample format of their main views.</p>";
+
+   OutputSampleFormatLabel.SetText( "Sample format:" );
+   OutputSampleFormatLabel.SetTextAlignment( TextAlign::Right|TextAlign::VertCenter );
+   OutputSampleFormatLabel.SetMinWidth( labelWidth1 );
+   OutputSampleFormatLabel.SetToolTip( outputSampleFormatToolTip );
+
+   OutputSampleFormatCombo.AddItem( "Same as input" );
+   OutputSampleFormatCombo.AddItem( "16-bit integer" );
+   OutputSampleFormatCombo.AdjustToContents();
+   OutputSampleFormatCombo.SetToolTip( outputSampleFormatToolTip );
+   OutputSampleFormatCombo.OnItemSelected( (ComboBox::item_event_handler)&CFA2RGBInterface::__ItemSelected, w );
+
+   OutputSampleFormatSizer.SetSpacing( 4 );
+   OutputSampleFormatSizer.Add( OutputSampleFormatLabel );
+   OutputSampleFormatSizer.Add( OutputSampleFormatCombo );
+   OutputSampleFormatSizer.AddStretch();
+
+   BlockBinning_CheckBox.SetText( "Bin same-color blocks" );
+   BlockBinning_CheckBox.SetToolTip( "<p>Quad-Bayer and nonacell patterns only: average each 2x2 or 3x3 block "
+      "of same-color pixels, producing a Bayer-sampled RGB image at 1/2 or 1/3 of the original resolution.</p>" );
+   BlockBinning_CheckBox.OnClick( (Button::click_event_handler)&CFA2RGBInterface::__Click, w );
+
+   BlockBinningSizer.AddUnscaledSpacing( labelWidth1 + 4 );
+   BlockBinningSizer.Add( BlockBinning_CheckBox );
+   BlockBinningSizer.AddStretch();
+
+   const char* cellBinningToolTip = "<p>Bin groups of 2x2 or 3x3 CFA pattern cells, such as Bayer RGGB cells, "
+      "combining the samples at each position of the pattern. The result is a mosaic with the same pattern at 1/2 "
+      "or 1/3 of the original resolution, computed in a single pass over the CFA.</p>"
+      "<p><b>Average</b> takes the mean of the binned samples. <b>Sum</b> adds them, saturating at the maximum "
+      "sample value, which increases the signal of faint targets in integer images.</p>"
+      "<p>The binned mosaic is expanded into sparse <b>RGB</b> planes, or kept as a single-channel <b>CFA</b> "
+      "image for further processing. Binned output is not interpolated, and cell binning does not apply when "
+      "same-color blocks are binned.</p>";
+
+   CellBinningLabel.SetText( "Cell binning:" );
+   CellBinningLabel.SetTextAlignment( TextAlign::Right|TextAlign::VertCenter );
+   CellBinningLabel.SetMinWidth( labelWidth1 );
+   CellBinningLabel.SetToolTip( cellBinningToolTip );
+
+   CellBinningCombo.AddItem( "None" );
+   CellBinningCombo.AddItem( "2x2" );
+   CellBinningCombo.AddItem( "3x3" );
+   CellBinningCombo.AdjustToContents();
+   CellBinningCombo.SetToolTip( cellBinningToolTip );
+   CellBinningCombo.OnItemSelected( (ComboBox::item_event_handler)&CFA2RGBInterface::__ItemSelected, w );
+
+   CellBinningModeLabel.SetText( "Mode:" );
+   CellBinningModeLabel.SetTextAlignment( TextAlign::Right|TextAlign::VertCenter );
+
+   CellBinningModeCombo.AddItem( "Average" );
+   CellBinningModeCombo.AddItem( "Sum" );
+   CellBinningModeCombo.AdjustToContents();
+   CellBinningModeCombo.SetToolTip( cellBinningToolTip );
+   CellBinningModeCombo.OnItemSelected( (ComboBox::item_event_handler)&CFA2RGBInterface::__ItemSelected, w );
+
+   CellBinningOutputLabel.SetText( "Output:" );
+   CellBinningOutputLabel.SetTextAlignment( TextAlign::Right|TextAlign::VertCenter );
+
+   CellBinningOutputCombo.AddItem( "RGB" );
+   CellBinningOutputCombo.AddItem( "CFA" );
+   CellBinningOutputCombo.AdjustToContents();
+   CellBinningOutputCombo.SetToolTip( cellBinningToolTip );
+   CellBinningOutputCombo.OnItemSelected( (ComboBox::item_event_handler)&CFA2RGBInterface::__ItemSelected, w );
+
+   CellBinningSizer.SetSpacing( 4 );
+   CellBinningSizer.Add( CellBinningLabel );
+   CellBinningSizer.Add( CellBinningCombo );
+   CellBinningSizer.AddSpacing( 12 );
+   CellBinningSizer.Add( CellBinningModeLabel );
+   CellBinningSizer.Add( CellBinningModeCombo );
+   CellBinningSizer.AddSpacing( 8 );
+   CellBinningSizer.Add( CellBinningOutputLabel );
+   CellBinningSizer.Add( CellBinningOutputCombo );
+   CellBinningSizer.AddStretch();
+
+   GenerateCoverageMaps_CheckBox.SetText( "Generate coverage maps" );
+   GenerateCoverageMaps_CheckBox.SetToolTip( "<p>Generate a bit-packed coverage map for each channel, flagging the pixels "
+      "where the channel has a CFA sample, for Bayer drizzle integration. The maps are stored as the CFA2RGB:CoverageR, "
+      "CFA2RGB:CoverageG and CFA2RGB:CoverageB image properties, one bit per pixel with rows padded to whole bytes.</p>" );
+   GenerateCoverageMaps_CheckBox.OnClick( (Button::click_event_handler)&CFA2RGBInterface::__Click, w );
+
+   GenerateCoverageMapsSizer.AddUnscaledSpacing( labelWidth1 + 4 );
+   GenerateCoverageMapsSizer.Add( GenerateCoverageMaps_CheckBox );
+   GenerateCoverageMapsSizer.AddStretch();
+
+   const char* roiToolTip = "<p>Convert only a rectangular region of the target image, given by its left, top, "
+      "right and bottom pixel coordinates (right and bottom excluded). Only the region is allocated and processed, "
+      "and the target image is replaced with the converted region. The CFA phase is taken from the position of the "
+      "region in the image, and in the main view for previews, so odd offsets keep the correct pattern.</p>"
+      "<p>Applies when CFA2RGB is executed on a view or an image; batch and open view conversions always convert "
+      "whole frames.</p>";
+
+   UseROI_CheckBox.SetText( "Region of interest" );
+   UseROI_CheckBox.SetToolTip( roiToolTip );
+   UseROI_CheckBox.OnClick( (Button::click_event_handler)&CFA2RGBInterface::__Click, w );
+
+   UseROI_Sizer.AddUnscaledSpacing( labelWidth1 + 4 );
+   UseROI_Sizer.Add( UseROI_CheckBox );
+   UseROI_Sizer.AddStretch();
+
+   Label* roiLabels[] = { &ROIX0_Label, &ROIY0_Label, &ROIX1_Label, &ROIY1_Label };
+   SpinBox* roiSpinBoxes[] = { &ROIX0_SpinBox, &ROIY0_SpinBox, &ROIX1_SpinBox, &ROIY1_SpinBox };
+   const char* roiNames[] = { "Left:", "Top:", "Right:", "Bottom:" };
+   ROI_Sizer.SetSpacing( 4 );
+   ROI_Sizer.AddUnscaledSpacing( labelWidth1 );
+   for ( int i = 0; i < 4; ++i )
+   {
+      roiLabels[i]->SetText( roiNames[i] );
+      roiLabels[i]->SetTextAlignment( TextAlign::Right|TextAlign::VertCenter );
+      roiLabels[i]->SetToolTip( roiToolTip );
+      roiSpinBoxes[i]->SetRange( 0, int( TheCFA2RGBROIX0Parameter->MaximumValue() ) );
+      roiSpinBoxes[i]->SetToolTip( roiToolTip );
+      roiSpinBoxes[i]->OnValueUpdated( (SpinBox::value_event_handler)&CFA2RGBInterface::__SpinValueUpdated, w );
+      ROI_Sizer.Add( *roiLabels[i] );
+      ROI_Sizer.Add( *roiSpinBoxes[i] );
+   }
+   ROI_Sizer.AddStretch();
+
+   const char* memoryBudgetToolTip = "<p>Maximum amount of memory, in MiB, that a conversion may allocate. Before "
+      "converting, CFA2RGB estimates the peak allocation for the selected options and selects an execution strategy "
+      "that fits within this budget: in batch conversions, output files are written while the next frame is "
+      "converted only if two frames fit. Conversions that cannot fit are not started.</p>"
+      "<p>Zero selects the physical memory available when the process is executed.</p>";
+
+   MemoryBudget_Label.SetText( "Memory budget:" );
+   MemoryBudget_Label.SetTextAlignment( TextAlign::Right|TextAlign::VertCenter );
+   MemoryBudget_Label.SetMinWidth( labelWidth1 );
+   MemoryBudget_Label.SetToolTip( memoryBudgetToolTip );
+
+   MemoryBudget_SpinBox.SetRange( 0, int( TheCFA2RGBMemoryBudgetParameter->MaximumValue() ) );
+   MemoryBudget_SpinBox.SetStepSize( 256 );
+   MemoryBudget_SpinBox.SetMinimumValueText( "<Available>" );
+   MemoryBudget_SpinBox.SetToolTip( memoryBudgetToolTip );
+   MemoryBudget_SpinBox.OnValueUpdated( (SpinBox::value_event_handler)&CFA2RGBInterface::__SpinValueUpdated, w );
+
+   MemoryBudget_Sizer.SetSpacing( 4 );
+   MemoryBudget_Sizer.Add( MemoryBudget_Label );
+   MemoryBudget_Sizer.Add( MemoryBudget_SpinBox );
+   MemoryBudget_Sizer.AddStretch();
+
+   ConvertOpenViews_CheckBox.SetText( "Convert open views" );
+   ConvertOpenViews_CheckBox.SetToolTip( "<p>On global execution, convert the main views of all open images instead of "
+      "the target frames. Views are converted concurrently, each one using a share of the available processors "
+      "proportional to its size, and the results are created as new image windows with _RGB (or _G for green output) "
+      "appended to the source identifiers. Source images are not modified.</p>" );
+   ConvertOpenViews_CheckBox.OnClick( (Button::click_event_handler)&CFA2RGBInterface::__Click, w );
+
+   ConvertOpenViews_Sizer.AddUnscaledSpacing( labelWidth1 + 4 );
+   ConvertOpenViews_Sizer.Add( ConvertOpenViews_CheckBox );
+   ConvertOpenViews_Sizer.AddStretch();
+
+   //
+
+   Batch_SectionBar.SetTitle( "Batch Conversion" );
+   Batch_SectionBar.SetSection( Batch_Control );
+
+   TargetFrames_TreeBox.SetMinHeight( 8*fnt.Height() );
+   TargetFrames_TreeBox.SetScaledMinWidth( 320 );
+   TargetFrames_TreeBox.SetNumberOfColumns( 3 );
+   TargetFrames_TreeBox.HideHeader();
+   TargetFrames_TreeBox.EnableMultipleSelections();
+   TargetFrames_TreeBox.DisableRootDecoration();
+   TargetFrames_TreeBox.EnableAlternateRowColor();
+   TargetFrames_TreeBox.SetToolTip( "<p>Target frames for batch conversion. Applying the process globally converts "
+      "each enabled frame, one at a time, and writes and/or integrates the result.</p>"
+      "<p>Double-click the second column to enable or disable a frame.</p>" );
+   TargetFrames_TreeBox.OnNodeActivated( (TreeBox::node_event_handler)&CFA2RGBInterface::__NodeActivated, w );
+
+   AddFiles_PushButton.SetText( "Add Files" );
+   AddFiles_PushButton.SetToolTip( "<p>Add existing image files to the list of target frames.</p>" );
+   AddFiles_PushButton.OnClick( (Button::click_event_handler)&CFA2RGBInterface::__Click, w );
+
+   ToggleFrame_PushButton.SetText( "Toggle" );
+   ToggleFrame_PushButton.SetToolTip( "<p>Enable or disable the selected target frames.</p>" );
+   ToggleFrame_PushButton.OnClick( (Button::click_event_handler)&CFA2RGBInterface::__Click, w );
+
+   RemoveFrames_PushButton.SetText( "Remove" );
+   RemoveFrames_PushButton.SetToolTip( "<p>Remove the selected target frames from the list.</p>" );
+   RemoveFrames_PushButton.OnClick( (Button::click_event_handler)&CFA2RGBInterface::__Click, w );
+
+   ClearFrames_PushButton.SetText( "Clear" );
+   ClearFrames_PushButton.SetToolTip( "<p>Clear the list of target frames.</p>" );
+   ClearFrames_PushButton.OnClick( (Button::click_event_handler)&CFA2RGBInterface::__Click, w );
+
+   TargetButtons_Sizer.SetSpacing( 4 );
+   TargetButtons_Sizer.Add( AddFiles_PushButton );
+   TargetButtons_Sizer.Add( ToggleFrame_PushButton );
+   TargetButtons_Sizer.Add( RemoveFrames_PushButton );
+   TargetButtons_Sizer.Add( ClearFrames_PushButton );
+   TargetButtons_Sizer.AddStretch();
+
+   TargetFrames_Sizer.SetSpacing( 4 );
+   TargetFrames_Sizer.Add( TargetFrames_TreeBox, 100 );
+   TargetFrames_Sizer.Add( TargetButtons_Sizer );
+
+   const char* rawToolTip = "<p>Geometry of the target frames with a .raw extension, which are read as headerless "
+      "packed sensor data. The stride is the distance in bytes between the starts of consecutive rows; zero stands "
+      "for tightly packed rows.</p>";
+
+   RawPacking_Label.SetText( "Raw packing:" );
+   RawPacking_Label.SetTextAlignment( TextAlign::Right|TextAlign::VertCenter );
+   RawPacking_Label.SetMinWidth( labelWidth1 );
+
+   RawPacking_ComboBox.AddItem( "MIPI RAW10" );
+   RawPacking_ComboBox.AddItem( "MIPI RAW12" );
+   RawPacking_ComboBox.AddItem( "MIPI RAW14" );
+   RawPacking_ComboBox.AddItem( "12-bit packed (LSB first)" );
+   RawPacking_ComboBox.SetToolTip( "<p>Packing scheme of .raw target frames. Packed samples are unpacked while "
+      "they are converted, and written as 16-bit images.</p>" );
+   RawPacking_ComboBox.OnItemSelected( (ComboBox::item_event_handler)&CFA2RGBInterface::__ItemSelected, w );
+
+   RawPacking_Sizer.SetSpacing( 4 );
+   RawPacking_Sizer.Add( RawPacking_Label );
+   RawPacking_Sizer.Add( RawPacking_ComboBox );
+   RawPacking_Sizer.AddStretch();
+
+   RawWidth_Label.SetText( "Width:" );
+   RawWidth_Label.SetTextAlignment( TextAlign::Right|TextAlign::VertCenter );
+   RawWidth_Label.SetMinWidth( labelWidth1 );
+
+   RawWidth_SpinBox.SetRange( 0, 65535 );
+   RawWidth_SpinBox.SetToolTip( rawToolTip );
+   RawWidth_SpinBox.OnValueUpdated( (SpinBox::value_event_handler)&CFA2RGBInterface::__SpinValueUpdated, w );
+
+   RawHeight_Label.SetText( "Height:" );
+   RawHeight_Label.SetTextAlignment( TextAlign::Right|TextAlign::VertCenter );
+
+   RawHeight_SpinBox.SetRange( 0, 65535 );
+   RawHeight_SpinBox.SetToolTip( rawToolTip );
+   RawHeight_SpinBox.OnValueUpdated( (SpinBox::value_event_handler)&CFA2RGBInterface::__SpinValueUpdated, w );
+
+   RawStride_Label.SetText( "Stride:" );
+   RawStride_Label.SetTextAlignment( TextAlign::Right|TextAlign::VertCenter );
+
+   RawStride_SpinBox.SetRange( 0, 1048575 );
+   RawStride_SpinBox.SetToolTip( rawToolTip );
+   RawStride_SpinBox.OnValueUpdated( (SpinBox::value_event_handler)&CFA2RGBInterface::__SpinValueUpdated, w );
+
+   RawGeometry_Sizer.SetSpacing( 4 );
+   RawGeometry_Sizer.Add( RawWidth_Label );
+   RawGeometry_Sizer.Add( RawWidth_SpinBox );
+   RawGeometry_Sizer.AddSpacing( 8 );
+   RawGeometry_Sizer.Add( RawHeight_Label );
+   RawGeometry_Sizer.Add( RawHeight_SpinBox );
+   RawGeometry_Sizer.AddSpacing( 8 );
+   RawGeometry_Sizer.Add( RawStride_Label );
+   RawGeometry_Sizer.Add( RawStride_SpinBox );
+   RawGeometry_Sizer.AddStretch();
+
+   OutputDirectory_Label.SetText( "Output dir:" );
+   OutputDirectory_Label.SetTextAlignment( TextAlign::Right|TextAlign::VertCenter );
+   OutputDirectory_Label.SetMinWidth( labelWidth1 );
+
+   OutputDirectory_Edit.SetToolTip( "<p>Directory of the converted frames. If empty, each output file is written "
+      "to the directory of its target frame.</p>" );
+   OutputDirectory_Edit.OnEditCompleted( (Edit::edit_event_handler)&CFA2RGBInterface::__EditCompleted, w );
+
+   OutputDirectory_ToolButton.SetIcon( Bitmap( w.ScaledResource( ":/browser/select-file.png" ) ) );
+   OutputDirectory_ToolButton.SetToolTip( "<p>Select the output directory.</p>" );
+   OutputDirectory_ToolButton.OnClick( (Button::click_event_handler)&CFA2RGBInterface::__Click, w );
+
+   OutputDirectory_Sizer.SetSpacing( 4 );
+   OutputDirectory_Sizer.Add( OutputDirectory_Label );
+   OutputDirectory_Sizer.Add( OutputDirectory_Edit, 100 );
+   OutputDirectory_Sizer.Add( OutputDirectory_ToolButton );
+
+   OutputPostfix_Label.SetText( "Postfix:" );
+   OutputPostfix_Label.SetTextAlignment( TextAlign::Right|TextAlign::VertCenter );
+   OutputPostfix_Label.SetMinWidth( labelWidth1 );
+
+   OutputPostfix_Edit.SetToolTip( "<p>Appended to the file name of each target frame to build the name of its "
+      "output file.</p>" );
+   OutputPostfix_Edit.OnEditCompleted( (Edit::edit_event_handler)&CFA2RGBInterface::__EditCompleted, w );
+
+   OnError_Label.SetText( "On error:" );
+   OnError_Label.SetTextAlignment( TextAlign::Right|TextAlign::VertCenter );
+
+   OnError_ComboBox.AddItem( "Continue" );
+   OnError_ComboBox.AddItem( "Abort" );
+   OnError_ComboBox.SetToolTip( "<p>Whether to skip a target frame that cannot be read, converted or written, "
+      "or to stop the batch.</p>" );
+   OnError_ComboBox.OnItemSelected( (ComboBox::item_event_handler)&CFA2RGBInterface::__ItemSelected, w );
+
+   OutputPostfix_Sizer.SetSpacing( 4 );
+   OutputPostfix_Sizer.Add( OutputPostfix_Label );
+   OutputPostfix_Sizer.Add( OutputPostfix_Edit );
+   OutputPostfix_Sizer.AddSpacing( 12 );
+   OutputPostfix_Sizer.Add( OnError_Label );
+   OutputPostfix_Sizer.Add( OnError_ComboBox );
+   OutputPostfix_Sizer.AddStretch();
+
+   WriteOutputFiles_CheckBox.SetText( "Write output files" );
+   WriteOutputFiles_CheckBox.SetToolTip( "<p>Write each converted frame to an XISF file.</p>" );
+   WriteOutputFiles_CheckBox.OnClick( (Button::click_event_handler)&CFA2RGBInterface::__Click, w );
+
+   WriteOutputFiles_Sizer.AddUnscaledSpacing( labelWidth1 + 4 );
+   WriteOutputFiles_Sizer.Add( WriteOutputFiles_CheckBox );
+   WriteOutputFiles_Sizer.AddStretch();
+
+   OverwriteExistingFiles_CheckBox.SetText( "Overwrite existing files" );
+   OverwriteExistingFiles_CheckBox.SetToolTip( "<p>Replace existing output files. If disabled, a numeric suffix "
+      "is appended to output file names as necessary.</p>" );
+   OverwriteExistingFiles_CheckBox.OnClick( (Button::click_event_handler)&CFA2RGBInterface::__Click, w );
+
+   OverwriteExistingFiles_Sizer.AddUnscaledSpacing( labelWidth1 + 4 );
+   OverwriteExistingFiles_Sizer.Add( OverwriteExistingFiles_CheckBox );
+   OverwriteExistingFiles_Sizer.AddStretch();
+
+   UseFileCache_CheckBox.SetText( "Skip unchanged frames" );
+   UseFileCache_CheckBox.SetToolTip( "<p>Keep an index of converted frames, keyed by a hash of the contents of each "
+      "target frame and the conversion settings, in a CFA2RGB.cache file. When the batch is run again, frames whose "
+      "output files are still valid are skipped.</p>"
+      "<p>Not available when frames are being integrated, since integration needs every frame.</p>" );
+   UseFileCache_CheckBox.OnClick( (Button::click_event_handler)&CFA2RGBInterface::__Click, w );
+
+   UseFileCache_Sizer.AddUnscaledSpacing( labelWidth1 + 4 );
+   UseFileCache_Sizer.Add( UseFileCache_CheckBox );
+   UseFileCache_Sizer.AddStretch();
+
+   OutputCompression_Label.SetText( "Compression:" );
+   OutputCompression_Label.SetTextAlignment( TextAlign::Right|TextAlign::VertCenter );
+   OutputCompression_Label.SetMinWidth( labelWidth1 );
+
+   OutputCompression_ComboBox.AddItem( "None" );
+   OutputCompression_ComboBox.AddItem( "Zlib" );
+   OutputCompression_ComboBox.AddItem( "LZ4" );
+   OutputCompression_ComboBox.AddItem( "LZ4-HC" );
+   OutputCompression_ComboBox.SetToolTip( "<p>XISF block compression codec for output files. Compression is "
+      "performed on a background thread while the next frame is converted. LZ4 is the fastest codec; Zlib and "
+      "LZ4-HC compress better at a higher cost.</p>" );
+   OutputCompression_ComboBox.OnItemSelected( (ComboBox::item_event_handler)&CFA2RGBInterface::__ItemSelected, w );
+
+   OutputByteShuffling_CheckBox.SetText( "Byte shuffling" );
+   OutputByteShuffling_CheckBox.SetToolTip( "<p>Group the bytes of each sample by significance before compression. "
+      "This greatly improves compression of the sparse RGB planes, especially for floating point images.</p>" );
+   OutputByteShuffling_CheckBox.OnClick( (Button::click_event_handler)&CFA2RGBInterface::__Click, w );
+
+   OutputCompression_Sizer.SetSpacing( 4 );
+   OutputCompression_Sizer.Add( OutputCompression_Label );
+   OutputCompression_Sizer.Add( OutputCompression_ComboBox );
+   OutputCompression_Sizer.AddSpacing( 12 );
+   OutputCompression_Sizer.Add( OutputByteShuffling_CheckBox );
+   OutputCompression_Sizer.AddStretch();
+
+   const char* pyramidToolTip = "<p>Generate reduced-scale previews of each output file during conversion. The first "
+      "level has one pixel per CFA cell (1:2 for Bayer patterns); each additional level halves its size. Levels are "
+      "written next to the output file with _1-2, _1-4, ... suffixes, as 32-bit XISF images or 8-bit PNG thumbnails.</p>";
+
+   GeneratePyramid_CheckBox.SetText( "Generate pyramid" );
+   GeneratePyramid_CheckBox.SetToolTip( pyramidToolTip );
+   GeneratePyramid_CheckBox.OnClick( (Button::click_event_handler)&CFA2RGBInterface::__Click, w );
+
+   PyramidLevels_Label.SetText( "Levels:" );
+   PyramidLevels_Label.SetTextAlignment( TextAlign::Right|TextAlign::VertCenter );
+
+   PyramidLevels_SpinBox.SetRange( int( TheCFA2RGBPyramidLevelsParameter->MinimumValue() ),
+                                   int( TheCFA2RGBPyramidLevelsParameter->MaximumValue() ) );
+   PyramidLevels_SpinBox.SetToolTip( pyramidToolTip );
+   PyramidLevels_SpinBox.OnValueUpdated( (SpinBox::value_event_handler)&CFA2RGBInterface::__SpinValueUpdated, w );
+
+   PyramidFormat_Label.SetText( "Format:" );
+   PyramidFormat_Label.SetTextAlignment( TextAlign::Right|TextAlign::VertCenter );
+
+   PyramidFormat_ComboBox.AddItem( "XISF" );
+   PyramidFormat_ComboBox.AddItem( "PNG" );
+   PyramidFormat_ComboBox.SetToolTip( pyramidToolTip );
+   PyramidFormat_ComboBox.OnItemSelected( (ComboBox::item_event_handler)&CFA2RGBInterface::__ItemSelected, w );
+
+   GeneratePyramid_Sizer.SetSpacing( 4 );
+   GeneratePyramid_Sizer.AddUnscaledSpacing( labelWidth1 );
+   GeneratePyramid_Sizer.Add( GeneratePyramid_CheckBox );
+   GeneratePyramid_Sizer.AddSpacing( 12 );
+   GeneratePyramid_Sizer.Add( PyramidLevels_Label );
+   GeneratePyramid_Sizer.Add( PyramidLevels_SpinBox );
+   GeneratePyramid_Sizer.AddSpacing( 8 );
+   GeneratePyramid_Sizer.Add( PyramidFormat_Label );
+   GeneratePyramid_Sizer.Add( PyramidFormat_ComboBox );
+   GeneratePyramid_Sizer.AddStretch();
+
+   IntegrateFrames_CheckBox.SetText( "Integrate frames" );
+   IntegrateFrames_CheckBox.SetToolTip( "<p>Accumulate the per-pixel mean and standard deviation of the converted "
+      "frames while they are generated, without storing any intermediate data. Only the pixels covered by each "
+      "channel are accumulated. The results are shown as the CFA2RGB_mean and CFA2RGB_sigma images.</p>" );
+   IntegrateFrames_CheckBox.OnClick( (Button::click_event_handler)&CFA2RGBInterface::__Click, w );
+
+   IntegrateFrames_Sizer.AddUnscaledSpacing( labelWidth1 + 4 );
+   IntegrateFrames_Sizer.Add( IntegrateFrames_CheckBox );
+   IntegrateFrames_Sizer.AddStretch();
+
+   const char* claimToolTip = "<p>Shared directory through which several PixInsight instances, possibly on "
+      "different machines, split the batch. Each instance converts only the target frames it manages to claim, "
+      "recording its claims and completed frames in this directory, so all instances can be started with the "
+      "same list of target frames. Frame paths must be identical on all machines. Leave empty to convert every "
+      "frame in this instance.</p>"
+      "<p>A claim older than the timeout is assumed to belong to an instance that stopped, and its frame is "
+      "converted again. The timeout must exceed the time needed to convert and write one frame.</p>";
+
+   ClaimDirectory_Label.SetText( "Claim dir:" );
+   ClaimDirectory_Label.SetTextAlignment( TextAlign::Right|TextAlign::VertCenter );
+   ClaimDirectory_Label.SetMinWidth( labelWidth1 );
+
+   ClaimDirectory_Edit.SetToolTip( claimToolTip );
+   ClaimDirectory_Edit.OnEditCompleted( (Edit::edit_event_handler)&CFA2RGBInterface::__EditCompleted, w );
+
+   ClaimDirectory_ToolButton.SetIcon( Bitmap( w.ScaledResource( ":/browser/select-file.png" ) ) );
+   ClaimDirectory_ToolButton.SetToolTip( "<p>Select the claim directory.</p>" );
+   ClaimDirectory_ToolButton.OnClick( (Button::click_event_handler)&CFA2RGBInterface::__Click, w );
+
+   ClaimDirectory_Sizer.SetSpacing( 4 );
+   ClaimDirectory_Sizer.Add( ClaimDirectory_Label );
+   ClaimDirectory_Sizer.Add( ClaimDirectory_Edit, 100 );
+   ClaimDirectory_Sizer.Add( ClaimDirectory_ToolButton );
+
+   ClaimTimeout_Label.SetText( "Timeout (s):" );
+   ClaimTimeout_Label.SetTextAlignment( TextAlign::Right|TextAlign::VertCenter );
+   ClaimTimeout_Label.SetMinWidth( labelWidth1 );
+
+   ClaimTimeout_SpinBox.SetRange( int( TheCFA2RGBClaimTimeoutParameter->MinimumValue() ),
+                                  int( TheCFA2RGBClaimTimeoutParameter->MaximumValue() ) );
+   ClaimTimeout_SpinBox.SetToolTip( claimToolTip );
+   ClaimTimeout_SpinBox.OnValueUpdated( (SpinBox::value_event_handler)&CFA2RGBInterface::__SpinValueUpdated, w );
+
+   ClaimTimeout_Sizer.SetSpacing( 4 );
+   ClaimTimeout_Sizer.Add( ClaimTimeout_Label );
+   ClaimTimeout_Sizer.Add( ClaimTimeout_SpinBox );
+   ClaimTimeout_Sizer.AddStretch();
+
+   Batch_Sizer.SetSpacing( 4 );
+   Batch_Sizer.Add( TargetFrames_Sizer, 100 );
+   Batch_Sizer.Add( RawPacking_Sizer );
+   Batch_Sizer.Add( RawGeometry_Sizer );
+   Batch_Sizer.Add( OutputDirectory_Sizer );
+   Batch_Sizer.Add( OutputPostfix_Sizer );
+   Batch_Sizer.Add( WriteOutputFiles_Sizer );
+   Batch_Sizer.Add( OverwriteExistingFiles_Sizer );
+   Batch_Sizer.Add( UseFileCache_Sizer );
+   Batch_Sizer.Add( OutputCompression_Sizer );
+   Batch_Sizer.Add( GeneratePyramid_Sizer );
+   Batch_Sizer.Add( IntegrateFrames_Sizer );
+   Batch_Sizer.Add( ClaimDirectory_Sizer );
+   Batch_Sizer.Add( ClaimTimeout_Sizer );
+
+   Batch_Control.SetSizer( Batch_Sizer );
+
+   //
+
    Global_Sizer.SetMargin( 8 );
    Global_Sizer.SetSpacing( 6 );
    Global_Sizer.Add( PatternSizer );
+   Global_Sizer.Add( OutputModeSizer );
+   Global_Sizer.Add( InterpolationSizer );
+   Global_Sizer.Add( CorrectLateralCA_Sizer );
+   Global_Sizer.Add( LateralCARed_Sizer );
+   Global_Sizer.Add( LateralCABlue_Sizer );
+   Global_Sizer.Add( ApplyColorMatrix_Sizer );
+   Global_Sizer.Add( ColorMatrixRow0_Sizer );
+   Global_Sizer.Add( ColorMatrixRow1_Sizer );
+   Global_Sizer.Add( ColorMatrixRow2_Sizer );
+   Global_Sizer.Add( OutputSampleFormatSizer );
+   Global_Sizer.Add( BlockBinningSizer );
+   Global_Sizer.Add( CellBinningSizer );
+   Global_Sizer.Add( GenerateCoverageMapsSizer );
+   Global_Sizer.Add( UseROI_Sizer );
+   Global_Sizer.Add( ROI_Sizer );
+   Global_Sizer.Add( MemoryBudget_Sizer );
+   Global_Sizer.Add( ConvertOpenViews_Sizer );
+   Global_Sizer.Add( Batch_SectionBar );
+   Global_Sizer.Add( Batch_Control );
 
    w.SetSizer( Global_Sizer );
    w.AdjustToContents();
-   w.SetFixedSize();
+   w.SetMinSize();
 }
 
 // ----------------------------------------------------------------------------
@@ -53,11 +53,19 @@
 #ifndef __CFA2RGBInterface_h
 #define __CFA2RGBInterface_h
 
+#include <pcl/CheckBox.h>
 #include <pcl/ComboBox.h>
 #include <pcl/Dialog.h>
+#include <pcl/Edit.h>
 #include <pcl/Label.h>
+#include <pcl/NumericControl.h>
 #include <pcl/ProcessInterface.h>
+#include <pcl/PushButton.h>
+#include <pcl/SectionBar.h>
 #include <pcl/Sizer.h>
+#include <pcl/SpinBox.h>
+#include <pcl/ToolButton.h>
+#include <pcl/TreeBox.h>
 
 #include "CFA2RGBInstance.h"
 
@@ -77,7 +85,10 @@ public:
    virtual MetaProcess* Process() const;
    //virtual const char** IconImageXPM() const;
 
+   virtual InterfaceFeatures Features() const;
+
    virtual void ApplyInstance() const;
+   virtual void ApplyInstanceGlobal() const;
    virtual void ResetInstance();
 
    virtual bool Launch( const MetaProcess&, const ProcessImplementation*, bool& dynamic, unsigned& /*flags*/ );
@@ -101,14 +112,141 @@ private:
          HorizontalSizer   PatternSizer;
             Label             PatternLabel;
             ComboBox          BayerPatternCombo;
+         HorizontalSizer   OutputModeSizer;
+            Label             OutputModeLabel;
+            ComboBox          OutputModeCombo;
+         HorizontalSizer   InterpolationSizer;
+            Label             InterpolationLabel;
+            ComboBox          InterpolationCombo;
+         HorizontalSizer   CorrectLateralCA_Sizer;
+            CheckBox          CorrectLateralCA_CheckBox;
+         HorizontalSizer   LateralCARed_Sizer;
+            Label             LateralCARed_Label;
+            NumericEdit       LateralCARedK0_NumericEdit;
+            NumericEdit       LateralCARedK1_NumericEdit;
+            NumericEdit       LateralCARedK2_NumericEdit;
+         HorizontalSizer   LateralCABlue_Sizer;
+            Label             LateralCABlue_Label;
+            NumericEdit       LateralCABlueK0_NumericEdit;
+            NumericEdit       LateralCABlueK1_NumericEdit;
+            NumericEdit       LateralCABlueK2_NumericEdit;
+         HorizontalSizer   ApplyColorMatrix_Sizer;
+            CheckBox          ApplyColorMatrix_CheckBox;
+            Label             ColorMatrixSource_Label;
+            ComboBox          ColorMatrixSource_ComboBox;
+         HorizontalSizer   ColorMatrixRow0_Sizer;
+            Label             ColorMatrixRow0_Label;
+            NumericEdit       ColorMatrix00_NumericEdit;
+            NumericEdit       ColorMatrix01_NumericEdit;
+            NumericEdit       ColorMatrix02_NumericEdit;
+         HorizontalSizer   ColorMatrixRow1_Sizer;
+            Label             ColorMatrixRow1_Label;
+            NumericEdit       ColorMatrix10_NumericEdit;
+            NumericEdit       ColorMatrix11_NumericEdit;
+            NumericEdit       ColorMatrix12_NumericEdit;
+         HorizontalSizer   ColorMatrixRow2_Sizer;
+            Label             ColorMatrixRow2_Label;
+            NumericEdit       ColorMatrix20_NumericEdit;
+            NumericEdit       ColorMatrix21_NumericEdit;
+            NumericEdit       ColorMatrix22_NumericEdit;
+         HorizontalSizer   OutputSampleFormatSizer;
+            Label             OutputSampleFormatLabel;
+            ComboBox          OutputSampleFormatCombo;
+         HorizontalSizer   BlockBinningSizer;
+            CheckBox          BlockBinning_CheckBox;
+         HorizontalSizer   CellBinningSizer;
+            Label             CellBinningLabel;
+            ComboBox          CellBinningCombo;
+            Label             CellBinningModeLabel;
+            ComboBox          CellBinningModeCombo;
+            Label             CellBinningOutputLabel;
+            ComboBox          CellBinningOutputCombo;
+         HorizontalSizer   GenerateCoverageMapsSizer;
+            CheckBox          GenerateCoverageMaps_CheckBox;
+         HorizontalSizer   UseROI_Sizer;
+            CheckBox          UseROI_CheckBox;
+         HorizontalSizer   ROI_Sizer;
+            Label             ROIX0_Label;
+            SpinBox           ROIX0_SpinBox;
+            Label             ROIY0_Label;
+            SpinBox           ROIY0_SpinBox;
+            Label             ROIX1_Label;
+            SpinBox           ROIX1_SpinBox;
+            Label             ROIY1_Label;
+            SpinBox           ROIY1_SpinBox;
+         HorizontalSizer   MemoryBudget_Sizer;
+            Label             MemoryBudget_Label;
+            SpinBox           MemoryBudget_SpinBox;
+         HorizontalSizer   ConvertOpenViews_Sizer;
+            CheckBox          ConvertOpenViews_CheckBox;
+         SectionBar        Batch_SectionBar;
+         Control           Batch_Control;
+         VerticalSizer     Batch_Sizer;
+            HorizontalSizer   TargetFrames_Sizer;
+               TreeBox           TargetFrames_TreeBox;
+               VerticalSizer     TargetButtons_Sizer;
+                  PushButton        AddFiles_PushButton;
+                  PushButton        ToggleFrame_PushButton;
+                  PushButton        RemoveFrames_PushButton;
+                  PushButton        ClearFrames_PushButton;
+            HorizontalSizer   RawPacking_Sizer;
+               Label             RawPacking_Label;
+               ComboBox          RawPacking_ComboBox;
+            HorizontalSizer   RawGeometry_Sizer;
+               Label             RawWidth_Label;
+               SpinBox           RawWidth_SpinBox;
+               Label             RawHeight_Label;
+               SpinBox           RawHeight_SpinBox;
+               Label             RawStride_Label;
+               SpinBox           RawStride_SpinBox;
+            HorizontalSizer   OutputDirectory_Sizer;
+               Label             OutputDirectory_Label;
+               Edit              OutputDirectory_Edit;
+               ToolButton        OutputDirectory_ToolButton;
+            HorizontalSizer   OutputPostfix_Sizer;
+               Label             OutputPostfix_Label;
+               Edit              OutputPostfix_Edit;
+               Label             OnError_Label;
+               ComboBox          OnError_ComboBox;
+            HorizontalSizer   WriteOutputFiles_Sizer;
+               CheckBox          WriteOutputFiles_CheckBox;
+            HorizontalSizer   UseFileCache_Sizer;
+               CheckBox          UseFileCache_CheckBox;
+            HorizontalSizer   OutputCompression_Sizer;
+               Label             OutputCompression_Label;
+               ComboBox          OutputCompression_ComboBox;
+               CheckBox          OutputByteShuffling_CheckBox;
+            HorizontalSizer   GeneratePyramid_Sizer;
+               CheckBox          GeneratePyramid_CheckBox;
+               Label             PyramidLevels_Label;
+               SpinBox           PyramidLevels_SpinBox;
+               Label             PyramidFormat_Label;
+               ComboBox          PyramidFormat_ComboBox;
+            HorizontalSizer   OverwriteExistingFiles_Sizer;
+               CheckBox          OverwriteExistingFiles_CheckBox;
+            HorizontalSizer   IntegrateFrames_Sizer;
+               CheckBox          IntegrateFrames_CheckBox;
+            HorizontalSizer   ClaimDirectory_Sizer;
+               Label             ClaimDirectory_Label;
+               Edit              ClaimDirectory_Edit;
+               ToolButton        ClaimDirectory_ToolButton;
+            HorizontalSizer   ClaimTimeout_Sizer;
+               Label             ClaimTimeout_Label;
+               SpinBox           ClaimTimeout_SpinBox;
    };
 
    GUIData* GUI;
 
    void UpdateControls();
+   void UpdateTargetFramesList();
 
    // Event Handlers
    void __ItemSelected( ComboBox& sender, int itemIndex );
+   void __Click( Button& sender, bool checked );
+   void __EditCompleted( Edit& sender );
+   void __SpinValueUpdated( SpinBox& sender, int value );
+   void __NumericValueUpdated( NumericEdit& sender, double value );
+   void __NodeActivated( TreeBox& sender, TreeBox::Node& node, int col );
 
    friend struct GUIData;
 };
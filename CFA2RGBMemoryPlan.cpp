@@ -0,0 +1,244 @@
+//     ____   ______ __
+//    / __ \ / ____// /
+//   / /_/ // /    / /
+//  / ____// /___ / /___   PixInsight Class Library
+// /_/     \____//_____/   PCL 02.01.00.0779
+// ----------------------------------------------------------------------------
+// Standard CFA2RGB Process Module Version 01.01.01.0010
+// ----------------------------------------------------------------------------
+// CFA2RGBMemoryPlan.cpp - Released 2016/02/03 00:00:00 UTC
+// ----------------------------------------------------------------------------
+// This file is part of the standard CFA2RGB PixInsight module.
+//
+// Copyright (c) 2003-2016 Pleiades Astrophoto S.L. All Rights Reserved.
+//
+// Redistribution and use in both source and binary forms, with or without
+// modification, is permitted provided that the following conditions are met:
+//
+// 1. All redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. All redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the names "PixInsight" and "Pleiades Astrophoto", nor the names
+//    of their contributors, may be used to endorse or promote products derived
+//    from this software without specific prior written permission. For written
+//    permission, please contact info@pixinsight.com.
+//
+// 4. All products derived from this software, in any form whatsoever, must
+//    reproduce the following acknowledgment in the end-user documentation
+//    and/or other materials provided with the product:
+//
+//    "This product is based on software from the PixInsight project, developed
+//    by Pleiades Astrophoto and its contributors (http://pixinsight.com/)."
+//
+//    Alternatively, if that is where third-party acknowledgments normally
+//    appear, this acknowledgment must be reproduced in the product itself.
+//
+// THIS SOFTWARE IS PROVIDED BY PLEIADES ASTROPHOTO AND ITS CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL PLEIADES ASTROPHOTO OR ITS
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, BUSINESS
+// INTERRUPTION; PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; AND LOSS OF USE,
+// DATA OR PROFITS) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// ----------------------------------------------------------------------------
+
+
+#include "CFA2RGBMemoryPlan.h"
+#include "CFA2RGBEngine.h"
+
+#include <pcl/File.h>
+#include <pcl/Thread.h>
+
+#ifdef __PCL_WINDOWS
+#  include <windows.h>
+#else
+#  include <unistd.h>
+#endif
+
+namespace pcl
+{
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBMemoryPlan::CFA2RGBMemoryPlan( const CFA2RGBEngine& engine, size_type budget ) :
+m_engine( engine ), m_budget( (budget > 0) ? budget : AvailablePhysicalMemory() ), m_peak( 0 ), m_strategy( InPlace )
+{
+}
+
+/*
+ * In-place conversion keeps the CFA plane as the first channel and adds two
+ * planes. Interpolation reads from a full copy of the CFA plane and
+ * allocates three new planes. Binning and green output allocate a new image
+ * that is then copied into the converted one. A region of interest is
+ * converted out of place into a new image, which is then copied into the
+ * converted one, while the source image remains allocated. Each estimate
+ * assumes that released planes are not reused, so that it is an upper bound.
+ */
+void CFA2RGBMemoryPlan::PlanView( int width, int height, int bytesPerSample, bool coverage, bool outOfPlace,
+                                  size_type retainedBytes )
+{
+   int w, h;
+   m_engine.GetOutputDimensions( w, h, width, height );
+   const size_type plane = size_type( w )*size_type( h )*bytesPerSample;
+   const size_type mosaic = size_type( width )*size_type( height )*bytesPerSample;
+   const size_type output = m_engine.OutputChannels()*plane;
+
+   if ( outOfPlace || m_engine.IsBinning() || m_engine.IsCellBinning() || m_engine.IsGreenOutput() )
+      m_peak = 2*output;
+   else if ( m_engine.IsInterpolating() )
+      m_peak = mosaic + 3*plane;
+   else
+      m_peak = 2*plane;
+   m_peak += ThreadBuffers( width, height, bytesPerSample ) + retainedBytes;
+   if ( coverage )
+      m_peak += 3*size_type( (w + 7) >> 3 )*size_type( h );
+
+   if ( Fits( m_peak ) )
+   {
+      m_strategy = InPlace;
+      m_reason = outOfPlace ? "out-of-place conversion of the region of interest" :
+                 (m_engine.IsGreenOutput() ? "single-channel green image" :
+                 (m_engine.IsBinning() ? "block-binned output image" :
+                 (m_engine.IsCellBinning() ? "cell-binned output image" :
+                 (m_engine.IsInterpolating() ? "interpolation from a copy of the CFA plane" :
+                                               "channel expansion of the CFA plane"))));
+   }
+   else
+   {
+      m_strategy = Unfeasible;
+      m_reason = "the expanded image does not fit within the budget";
+   }
+}
+
+/*
+ * Batch frames are read as a single-channel mosaic (or kept packed) and
+ * converted in place. While a compressed output file is being written, the
+ * XISF codecs hold a byte-shuffled copy and a compressed copy of the frame.
+ * The overlapped strategy also reads the next frame during the conversion,
+ * and keeps the previous frame until its output file has been written.
+ */
+void CFA2RGBMemoryPlan::PlanBatch( int width, int height, int bytesPerSample, size_type inputBytes,
+                                   bool coverage, int pyramidLevels, bool integrate, bool write, bool compress )
+{
+   int w, h;
+   m_engine.GetOutputDimensions( w, h, width, height );
+   const size_type pixels = size_type( w )*size_type( h );
+   const size_type frame = m_engine.OutputChannels()*pixels*bytesPerSample;
+   const size_type mosaic = size_type( width )*size_type( height )*bytesPerSample;
+
+   size_type convert = frame + inputBytes + ThreadBuffers( width, height, bytesPerSample );
+   if ( m_engine.IsBinning() || m_engine.IsCellBinning() || m_engine.IsGreenOutput() || m_engine.IsInterpolating() )
+      convert += mosaic;
+   const size_type coverageBytes = coverage ? 3*size_type( (w + 7) >> 3 )*size_type( h ) : 0;
+   convert += coverageBytes;
+   if ( pyramidLevels > 0 )
+   {
+      const int period = m_engine.OutputPeriod();
+      for ( int i = 0; i < pyramidLevels; ++i )
+         convert += 3*sizeof( float )*size_type( (w/period) >> i )*size_type( (h/period) >> i );
+   }
+   if ( integrate )
+      convert += 3*(2*sizeof( double ) + sizeof( uint32 ))*pixels;
+
+   const size_type next = (inputBytes > 0) ? inputBytes : mosaic;
+   // The output writer keeps its own copy of the coverage planes.
+   const size_type output = write ? frame + coverageBytes : 0;
+   const size_type encode = (write && compress) ? 2*frame : 0;
+   const size_type sequential = convert + encode + (write ? coverageBytes : 0);
+   const size_type overlapped = convert + next + output + encode;
+
+   if ( Fits( overlapped ) )
+   {
+      m_peak = overlapped;
+      m_strategy = Overlapped;
+      m_reason = write ? "three frames fit within the budget" : "two frames fit within the budget";
+   }
+   else if ( Fits( sequential ) )
+   {
+      m_peak = sequential;
+      m_strategy = Sequential;
+      m_reason = String().Format( "overlapping consecutive frames would need %.1f MiB", overlapped/1048576.0 );
+   }
+   else
+   {
+      m_peak = sequential;
+      m_strategy = Unfeasible;
+      m_reason = "a single frame does not fit within the budget";
+   }
+}
+
+String CFA2RGBMemoryPlan::Report() const
+{
+   static const char* names[] = { "in-place", "overlapped output", "sequential output", "unfeasible" };
+   String budget = (m_budget > 0) ? String().Format( "%.1f MiB", m_budget/1048576.0 ) : String( "unknown" );
+   return String().Format( "Memory: estimated peak %.1f MiB, budget ", m_peak/1048576.0 ) + budget
+        + ". Strategy: " + names[m_strategy] + " (" + m_reason + ").";
+}
+
+size_type CFA2RGBMemoryPlan::AvailablePhysicalMemory()
+{
+#ifdef __PCL_WINDOWS
+   MEMORYSTATUSEX status;
+   status.dwLength = sizeof( status );
+   if ( GlobalMemoryStatusEx( &status ) )
+      return size_type( status.ullAvailPhys );
+   return 0;
+#else
+# ifdef __PCL_LINUX
+   /*
+    * MemAvailable includes reclaimable page cache, which free pages do not.
+    */
+   try
+   {
+      IsoStringList lines;
+      File::ReadTextFile( "/proc/meminfo" ).Break( lines, '\n' );
+      for ( IsoStringList::const_iterator i = lines.Begin(); i != lines.End(); ++i )
+         if ( i->StartsWith( "MemAvailable:" ) )
+         {
+            IsoString value = i->Substring( 13 ).Trimmed(); // "<n> kB"
+            uint64 kB;
+            if ( value.Left( value.FindFirst( ' ' ) ).TryToUInt64( kB ) )
+               return size_type( kB*1024 );
+         }
+   }
+   catch ( ... )
+   {
+   }
+# endif
+# ifdef _SC_AVPHYS_PAGES
+   long pages = sysconf( _SC_AVPHYS_PAGES );
+   long pageSize = sysconf( _SC_PAGESIZE );
+   if ( pages > 0 && pageSize > 0 )
+      return size_type( pages )*size_type( pageSize );
+# endif
+   return 0;
+#endif
+}
+
+/*
+ * Per-thread row buffers of the binning and packed raw kernels.
+ */
+size_type CFA2RGBMemoryPlan::ThreadBuffers( int width, int height, int bytesPerSample ) const
+{
+   return size_type( Thread::NumberOfThreads( height, 16 ) )*size_type( width )*Max( bytesPerSample, 2 );
+}
+
+bool CFA2RGBMemoryPlan::Fits( size_type bytes ) const
+{
+   return m_budget == 0 || bytes <= m_budget;
+}
+
+// ----------------------------------------------------------------------------
+
+} // pcl
+
+// ****************************************************************************
+// EOF CFA2RGBMemoryPlan.cpp - Released 2016/02/03 00:00:00 UTC
@@ -0,0 +1,163 @@
+//     ____   ______ __
+//    / __ \ / ____// /
+//   / /_/ // /    / /
+//  / ____// /___ / /___   PixInsight Class Library
+// /_/     \____//_____/   PCL 02.01.00.0779
+// ----------------------------------------------------------------------------
+// Standard CFA2RGB Process Module Version 01.01.01.0010
+// ----------------------------------------------------------------------------
+// CFA2RGBMemoryPlan.h - Released 2016/02/03 00:00:00 UTC
+// ----------------------------------------------------------------------------
+// This file is part of the standard CFA2RGB PixInsight module.
+//
+// Copyright (c) 2003-2016 Pleiades Astrophoto S.L. All Rights Reserved.
+//
+// Redistribution and use in both source and binary forms, with or without
+// modification, is permitted provided that the following conditions are met:
+//
+// 1. All redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. All redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the names "PixInsight" and "Pleiades Astrophoto", nor the names
+//    of their contributors, may be used to endorse or promote products derived
+//    from this software without specific prior written permission. For written
+//    permission, please contact info@pixinsight.com.
+//
+// 4. All products derived from this software, in any form whatsoever, must
+//    reproduce the following acknowledgment in the end-user documentation
+//    and/or other materials provided with the product:
+//
+//    "This product is based on software from the PixInsight project, developed
+//    by Pleiades Astrophoto and its contributors (http://pixinsight.com/)."
+//
+//    Alternatively, if that is where third-party acknowledgments normally
+//    appear, this acknowledgment must be reproduced in the product itself.
+//
+// THIS SOFTWARE IS PROVIDED BY PLEIADES ASTROPHOTO AND ITS CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL PLEIADES ASTROPHOTO OR ITS
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, BUSINESS
+// INTERRUPTION; PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; AND LOSS OF USE,
+// DATA OR PROFITS) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// ----------------------------------------------------------------------------
+
+
+#ifndef __CFA2RGBMemoryPlan_h
+#define __CFA2RGBMemoryPlan_h
+
+#include <pcl/String.h>
+
+namespace pcl
+{
+
+class CFA2RGBEngine;
+
+// ----------------------------------------------------------------------------
+
+/*
+ * Pre-flight memory estimation.
+ *
+ * Estimates the peak amount of memory that a conversion will allocate, given
+ * the frame geometry, sample type, engine mode, optional outputs and thread
+ * count, and selects the cheapest execution strategy that fits within the
+ * memory budget. The budget defaults to the available physical memory.
+ */
+class CFA2RGBMemoryPlan
+{
+public:
+
+   enum strategy
+   {
+      InPlace,    // Single frame converted in place (view execution)
+      Overlapped, // Next frame read while one is converted and the previous one written
+      Sequential, // Each frame converted and written before the next one is read
+      Unfeasible  // Not even a single frame fits within the budget
+   };
+
+   /*
+    * budget is the maximum number of bytes that a conversion may allocate;
+    * zero selects the available physical memory.
+    */
+   CFA2RGBMemoryPlan( const CFA2RGBEngine& engine, size_type budget = 0 );
+
+   /*
+    * Plans the conversion of a view or image, in place or, for a region of
+    * interest, out of place. retainedBytes is the size of data that remain
+    * allocated during conversion, such as the copy of the source image kept
+    * by the view history.
+    */
+   void PlanView( int width, int height, int bytesPerSample, bool coverage, bool outOfPlace,
+                  size_type retainedBytes = 0 );
+
+   /*
+    * Plans the conversion of a batch frame. inputBytes is the size of input
+    * data that remain allocated during conversion (packed raw frames).
+    * pyramidLevels is zero if no pyramid is generated. Accumulator storage
+    * is allocated once, but is included in the peak of every frame.
+    */
+   void PlanBatch( int width, int height, int bytesPerSample, size_type inputBytes,
+                   bool coverage, int pyramidLevels, bool integrate, bool write, bool compress );
+
+   strategy Strategy() const
+   {
+      return m_strategy;
+   }
+
+   bool IsFeasible() const
+   {
+      return m_strategy != Unfeasible;
+   }
+
+   /*
+    * Estimated peak allocation of the selected strategy, in bytes.
+    */
+   size_type PeakBytes() const
+   {
+      return m_peak;
+   }
+
+   size_type Budget() const
+   {
+      return m_budget;
+   }
+
+   /*
+    * A console line describing the estimate and the selected strategy.
+    */
+   String Report() const;
+
+   /*
+    * Physical memory currently available to the process, in bytes, or zero
+    * if it cannot be determined on this platform.
+    */
+   static size_type AvailablePhysicalMemory();
+
+private:
+
+   const CFA2RGBEngine& m_engine;
+   size_type            m_budget;    // 0 = unknown, no limit
+   size_type            m_peak;
+   strategy             m_strategy;
+   String               m_reason;
+
+   size_type ThreadBuffers( int width, int height, int bytesPerSample ) const;
+   bool Fits( size_type bytes ) const;
+};
+
+// ----------------------------------------------------------------------------
+
+} // pcl
+
+#endif   // __CFA2RGBMemoryPlan_h
+
+// ****************************************************************************
+// EOF CFA2RGBMemoryPlan.h - Released 2016/02/03 00:00:00 UTC
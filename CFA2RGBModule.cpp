@@ -64,6 +64,7 @@
 #include "CFA2RGBModule.h"
 #include "CFA2RGBProcess.h"
 #include "CFA2RGBInterface.h"
+#include "CFA2RGBWorkerPool.h"
 
 namespace pcl
 {
@@ -136,6 +137,15 @@ void CFA2RGBModule::GetReleaseDate( int& year, int& month, int& day ) const
    day   = MODULE_RELEASE_DAY;
 }
 
+/*
+ * The worker pool is started by the first parallel conversion; its threads
+ * must be stopped before the module code is unloaded.
+ */
+void CFA2RGBModule::OnUnload()
+{
+   CFA2RGBWorkerPool::Shutdown();
+}
+
 // ----------------------------------------------------------------------------
 
 } // pcl
@@ -77,6 +77,7 @@ public:
    virtual String TradeMarks() const;
    virtual String OriginalFileName() const;
    virtual void GetReleaseDate( int& year, int& month, int& day ) const;
+   virtual void OnUnload();
 };
 
 // ----------------------------------------------------------------------------
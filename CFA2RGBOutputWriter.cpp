@@ -0,0 +1,207 @@
+//     ____   ______ __
+//    / __ \ / ____// /
+//   / /_/ // /    / /
+//  / ____// /___ / /___   PixInsight Class Library
+// /_/     \____//_____/   PCL 02.01.00.0779
+// ----------------------------------------------------------------------------
+// Standard CFA2RGB Process Module Version 01.01.01.0010
+// ----------------------------------------------------------------------------
+// CFA2RGBOutputWriter.cpp - Released 2016/02/03 00:00:00 UTC
+// ----------------------------------------------------------------------------
+// This file is part of the standard CFA2RGB PixInsight module.
+//
+// Copyright (c) 2003-2016 Pleiades Astrophoto S.L. All Rights Reserved.
+//
+// Redistribution and use in both source and binary forms, with or without
+// modification, is permitted provided that the following conditions are met:
+//
+// 1. All redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. All redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the names "PixInsight" and "Pleiades Astrophoto", nor the names
+//    of their contributors, may be used to endorse or promote products derived
+//    from this software without specific prior written permission. For written
+//    permission, please contact info@pixinsight.com.
+//
+// 4. All products derived from this software, in any form whatsoever, must
+//    reproduce the following acknowledgment in the end-user documentation
+//    and/or other materials provided with the product:
+//
+//    "This product is based on software from the PixInsight project, developed
+//    by Pleiades Astrophoto and its contributors (http://pixinsight.com/)."
+//
+//    Alternatively, if that is where third-party acknowledgments normally
+//    appear, this acknowledgment must be reproduced in the product itself.
+//
+// THIS SOFTWARE IS PROVIDED BY PLEIADES ASTROPHOTO AND ITS CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL PLEIADES ASTROPHOTO OR ITS
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, BUSINESS
+// INTERRUPTION; PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; AND LOSS OF USE,
+// DATA OR PROFITS) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// ----------------------------------------------------------------------------
+
+
+#include "CFA2RGBEngine.h"
+#include "CFA2RGBOutputWriter.h"
+
+#include <pcl/ElapsedTime.h>
+#include <pcl/Exception.h>
+#include <pcl/File.h>
+#include <pcl/FileFormat.h>
+#include <pcl/FileFormatInstance.h>
+#include <pcl/FileInfo.h>
+#include <pcl/Thread.h>
+
+namespace pcl
+{
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBOutputThread : public Thread
+{
+public:
+
+   CFA2RGBOutputThread( CFA2RGBOutputWriter& writer ) : Thread(), m_writer( writer )
+   {
+   }
+
+   virtual void Run()
+   {
+      m_writer.Write();
+   }
+
+private:
+
+   CFA2RGBOutputWriter& m_writer;
+};
+
+// ----------------------------------------------------------------------------
+
+IsoString CFA2RGBOutputWriter::Hints( const IsoString& codec, bool shuffle )
+{
+   if ( codec.IsEmpty() )
+      return "no-compression";
+   IsoString hints = "compression-codec " + codec;
+   if ( shuffle )
+      hints += "+sh";
+   return hints;
+}
+
+CFA2RGBOutputWriter::CFA2RGBOutputWriter( const IsoString& hints ) : m_hints( hints ), m_thread( 0 ), m_succeeded( true )
+{
+}
+
+CFA2RGBOutputWriter::~CFA2RGBOutputWriter()
+{
+   Wait();
+}
+
+void CFA2RGBOutputWriter::Start( const String& filePath, const ImageVariant& image,
+                                 const ImageOptions& options, const FITSKeywordArray& keywords,
+                                 const CFA2RGBCoverageMap* coverage )
+{
+   if ( IsBusy() )
+      throw Error( "CFA2RGBOutputWriter::Start(): Internal error: a previous write is still pending." );
+
+   m_filePath = filePath;
+   m_image = image;
+   m_options = options;
+   m_keywords = keywords;
+   for ( int c = 0; c < 3; ++c )
+      if ( coverage != 0 )
+         m_coverage[c] = ByteArray( coverage->Plane( c ).Begin(), coverage->Plane( c ).End() );
+      else
+         m_coverage[c].Clear();
+   m_succeeded = false;
+   m_errorMessage.Clear();
+
+   m_thread = new CFA2RGBOutputThread( *this );
+   m_thread->Start( ThreadPriority::DefaultMax );
+}
+
+bool CFA2RGBOutputWriter::IsBusy() const
+{
+   return m_thread != 0;
+}
+
+bool CFA2RGBOutputWriter::Wait()
+{
+   if ( m_thread == 0 )
+      return false;
+
+   m_thread->Wait();
+   delete m_thread, m_thread = 0;
+
+   // Release the image as soon as it has been written.
+   m_image = ImageVariant();
+   for ( int c = 0; c < 3; ++c )
+      m_coverage[c].Clear();
+   return true;
+}
+
+/*
+ * Runs on the background thread. Exceptions cannot cross thread boundaries,
+ * so errors are caught here and reported by Wait().
+ */
+void CFA2RGBOutputWriter::Write()
+{
+   try
+   {
+      ElapsedTime T;
+
+      FileFormat format( ".xisf", false/*read*/, true/*write*/ );
+      FileFormatInstance file( format );
+      if ( !file.Create( m_filePath, m_hints ) )
+         throw CaughtException();
+
+      file.SetOptions( m_options );
+      file.Embed( m_keywords );
+
+      if ( !m_coverage[0].IsEmpty() )
+      {
+         static const char* properties[] = { "CFA2RGB:CoverageR", "CFA2RGB:CoverageG", "CFA2RGB:CoverageB" };
+         for ( int c = 0; c < 3; ++c )
+            if ( !file.WriteProperty( properties[c], m_coverage[c] ) )
+               throw CaughtException();
+      }
+
+      if ( !file.WriteImage( m_image ) )
+         throw CaughtException();
+      file.Close();
+
+      ++m_statistics.files;
+      m_statistics.rawBytes += uint64( m_image.ImageSize() );
+      m_statistics.storedBytes += FileInfo( m_filePath ).Size();
+      m_statistics.seconds += T();
+
+      m_succeeded = true;
+   }
+   catch ( Exception& x )
+   {
+      m_errorMessage = x.Message();
+   }
+   catch ( ... )
+   {
+      m_errorMessage = "Unknown error";
+   }
+
+   if ( !m_succeeded )
+      m_errorMessage = m_filePath + ": " + (m_errorMessage.IsEmpty() ? String( "Error writing output file" ) : m_errorMessage);
+}
+
+// ----------------------------------------------------------------------------
+
+} // pcl
+
+// ****************************************************************************
+// EOF CFA2RGBOutputWriter.cpp - Released 2016/02/03 00:00:00 UTC
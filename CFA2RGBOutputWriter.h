@@ -0,0 +1,188 @@
+//     ____   ______ __
+//    / __ \ / ____// /
+//   / /_/ // /    / /
+//  / ____// /___ / /___   PixInsight Class Library
+// /_/     \____//_____/   PCL 02.01.00.0779
+// ----------------------------------------------------------------------------
+// Standard CFA2RGB Process Module Version 01.01.01.0010
+// ----------------------------------------------------------------------------
+// CFA2RGBOutputWriter.h - Released 2016/02/03 00:00:00 UTC
+// ----------------------------------------------------------------------------
+// This file is part of the standard CFA2RGB PixInsight module.
+//
+// Copyright (c) 2003-2016 Pleiades Astrophoto S.L. All Rights Reserved.
+//
+// Redistribution and use in both source and binary forms, with or without
+// modification, is permitted provided that the following conditions are met:
+//
+// 1. All redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. All redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the names "PixInsight" and "Pleiades Astrophoto", nor the names
+//    of their contributors, may be used to endorse or promote products derived
+//    from this software without specific prior written permission. For written
+//    permission, please contact info@pixinsight.com.
+//
+// 4. All products derived from this software, in any form whatsoever, must
+//    reproduce the following acknowledgment in the end-user documentation
+//    and/or other materials provided with the product:
+//
+//    "This product is based on software from the PixInsight project, developed
+//    by Pleiades Astrophoto and its contributors (http://pixinsight.com/)."
+//
+//    Alternatively, if that is where third-party acknowledgments normally
+//    appear, this acknowledgment must be reproduced in the product itself.
+//
+// THIS SOFTWARE IS PROVIDED BY PLEIADES ASTROPHOTO AND ITS CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL PLEIADES ASTROPHOTO OR ITS
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, BUSINESS
+// INTERRUPTION; PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; AND LOSS OF USE,
+// DATA OR PROFITS) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// ----------------------------------------------------------------------------
+
+
+#ifndef __CFA2RGBOutputWriter_h
+#define __CFA2RGBOutputWriter_h
+
+#include <pcl/ByteArray.h>
+#include <pcl/FITSHeaderKeyword.h>
+#include <pcl/ImageOptions.h>
+#include <pcl/ImageVariant.h>
+#include <pcl/String.h>
+
+namespace pcl
+{
+
+class CFA2RGBCoverageMap;
+class CFA2RGBOutputThread;
+
+// ----------------------------------------------------------------------------
+
+/*
+ * Writes converted frames to compressed XISF files on a background thread.
+ *
+ * Compression is performed by the XISF format with the codec and byte
+ * shuffling selected by the output hints. Since the sparse RGB planes are
+ * mostly zeros, shuffled LZ4 blocks typically take a fraction of the raw
+ * size. While a frame is being compressed and written, the caller can read
+ * and convert the next one.
+ */
+class CFA2RGBOutputWriter
+{
+public:
+
+   struct Statistics
+   {
+      int    files;        // number of files written
+      uint64 rawBytes;     // uncompressed pixel data
+      uint64 storedBytes;  // file sizes on disk
+      double seconds;      // accumulated write time
+
+      Statistics() : files( 0 ), rawBytes( 0 ), storedBytes( 0 ), seconds( 0 )
+      {
+      }
+
+      double Ratio() const
+      {
+         return (storedBytes > 0) ? double( rawBytes )/storedBytes : 0.0;
+      }
+
+      /*
+       * Uncompressed throughput in bytes per second.
+       */
+      double Throughput() const
+      {
+         return (seconds > 0) ? rawBytes/seconds : 0.0;
+      }
+   };
+
+   /*
+    * Output hints for an XISF codec name (zlib, lz4, lz4hc; empty for no
+    * compression), optionally with byte shuffling.
+    */
+   static IsoString Hints( const IsoString& codec, bool shuffle );
+
+   CFA2RGBOutputWriter( const IsoString& hints );
+
+   /*
+    * Waits for the pending write, if any.
+    */
+   ~CFA2RGBOutputWriter();
+
+   /*
+    * Starts writing an image on the background thread. The image is shared,
+    * not copied: the caller must not modify it until Wait() returns. The
+    * planes of a coverage map are copied, so the map can be reused by the
+    * next conversion; they are stored as CFA2RGB:CoverageR, CFA2RGB:CoverageG
+    * and CFA2RGB:CoverageB image properties, as on views. Throws an Error if
+    * a previous write is still pending.
+    */
+   void Start( const String& filePath, const ImageVariant& image,
+               const ImageOptions& options, const FITSKeywordArray& keywords,
+               const CFA2RGBCoverageMap* coverage = 0 );
+
+   bool IsBusy() const;
+
+   /*
+    * Waits for the pending write. Returns false if there is none; otherwise
+    * returns true and reports the result through Succeeded() and
+    * ErrorMessage().
+    */
+   bool Wait();
+
+   bool Succeeded() const
+   {
+      return m_succeeded;
+   }
+
+   const String& ErrorMessage() const
+   {
+      return m_errorMessage;
+   }
+
+   const String& FilePath() const
+   {
+      return m_filePath;
+   }
+
+   const Statistics& GetStatistics() const
+   {
+      return m_statistics;
+   }
+
+private:
+
+   IsoString            m_hints;
+   CFA2RGBOutputThread* m_thread;
+   String               m_filePath;
+   ImageVariant         m_image;
+   ImageOptions         m_options;
+   FITSKeywordArray     m_keywords;
+   ByteArray            m_coverage[ 3 ];
+   bool                 m_succeeded;
+   String               m_errorMessage;
+   Statistics           m_statistics;
+
+   void Write();
+
+   friend class CFA2RGBOutputThread;
+};
+
+// ----------------------------------------------------------------------------
+
+} // pcl
+
+#endif   // __CFA2RGBOutputWriter_h
+
+// ****************************************************************************
+// EOF CFA2RGBOutputWriter.h - Released 2016/02/03 00:00:00 UTC
@@ -51,6 +51,7 @@
 // ----------------------------------------------------------------------------
 
 #include "CFA2RGBParameters.h"
+#include "CFA2RGBEngine.h"
 
 namespace pcl
 {
@@ -58,6 +59,68 @@ namespace pcl
 // ----------------------------------------------------------------------------
 
 CFA2RGBBayerPatternParameter*	   TheCFA2RGBBayerPatternParameter = 0;
+CFA2RGBBlockBinningParameter*	   TheCFA2RGBBlockBinningParameter = 0;
+CFA2RGBGenerateCoverageMapsParameter* TheCFA2RGBGenerateCoverageMapsParameter = 0;
+CFA2RGBTargetFramesParameter*      TheCFA2RGBTargetFramesParameter = 0;
+CFA2RGBTargetFrameEnabledParameter* TheCFA2RGBTargetFrameEnabledParameter = 0;
+CFA2RGBTargetFramePathParameter*   TheCFA2RGBTargetFramePathParameter = 0;
+CFA2RGBOutputDirectoryParameter*   TheCFA2RGBOutputDirectoryParameter = 0;
+CFA2RGBOutputPostfixParameter*     TheCFA2RGBOutputPostfixParameter = 0;
+CFA2RGBRawPackingParameter*        TheCFA2RGBRawPackingParameter = 0;
+CFA2RGBRawWidthParameter*          TheCFA2RGBRawWidthParameter = 0;
+CFA2RGBRawHeightParameter*         TheCFA2RGBRawHeightParameter = 0;
+CFA2RGBRawStrideParameter*         TheCFA2RGBRawStrideParameter = 0;
+CFA2RGBOverwriteExistingFilesParameter* TheCFA2RGBOverwriteExistingFilesParameter = 0;
+CFA2RGBUseFileCacheParameter*      TheCFA2RGBUseFileCacheParameter = 0;
+CFA2RGBOutputCompressionParameter* TheCFA2RGBOutputCompressionParameter = 0;
+CFA2RGBOutputByteShufflingParameter* TheCFA2RGBOutputByteShufflingParameter = 0;
+CFA2RGBOnErrorParameter*           TheCFA2RGBOnErrorParameter = 0;
+CFA2RGBWriteOutputFilesParameter*  TheCFA2RGBWriteOutputFilesParameter = 0;
+CFA2RGBIntegrateFramesParameter*   TheCFA2RGBIntegrateFramesParameter = 0;
+CFA2RGBGeneratePyramidParameter*   TheCFA2RGBGeneratePyramidParameter = 0;
+CFA2RGBPyramidLevelsParameter*     TheCFA2RGBPyramidLevelsParameter = 0;
+CFA2RGBPyramidFormatParameter*     TheCFA2RGBPyramidFormatParameter = 0;
+CFA2RGBMemoryBudgetParameter*      TheCFA2RGBMemoryBudgetParameter = 0;
+CFA2RGBOutputModeParameter*        TheCFA2RGBOutputModeParameter = 0;
+CFA2RGBConvertOpenViewsParameter*  TheCFA2RGBConvertOpenViewsParameter = 0;
+CFA2RGBOutputSampleFormatParameter* TheCFA2RGBOutputSampleFormatParameter = 0;
+CFA2RGBInterpolationParameter*     TheCFA2RGBInterpolationParameter = 0;
+CFA2RGBClaimDirectoryParameter*    TheCFA2RGBClaimDirectoryParameter = 0;
+CFA2RGBClaimTimeoutParameter*      TheCFA2RGBClaimTimeoutParameter = 0;
+CFA2RGBConversionTimeParameter*    TheCFA2RGBConversionTimeParameter = 0;
+CFA2RGBConversionRateParameter*    TheCFA2RGBConversionRateParameter = 0;
+CFA2RGBCorrectLateralCAParameter*   TheCFA2RGBCorrectLateralCAParameter = 0;
+CFA2RGBLateralCARedK0Parameter*     TheCFA2RGBLateralCARedK0Parameter = 0;
+CFA2RGBLateralCARedK1Parameter*     TheCFA2RGBLateralCARedK1Parameter = 0;
+CFA2RGBLateralCARedK2Parameter*     TheCFA2RGBLateralCARedK2Parameter = 0;
+CFA2RGBLateralCABlueK0Parameter*    TheCFA2RGBLateralCABlueK0Parameter = 0;
+CFA2RGBLateralCABlueK1Parameter*    TheCFA2RGBLateralCABlueK1Parameter = 0;
+CFA2RGBLateralCABlueK2Parameter*    TheCFA2RGBLateralCABlueK2Parameter = 0;
+CFA2RGBCellBinningParameter*        TheCFA2RGBCellBinningParameter = 0;
+CFA2RGBCellBinningModeParameter*    TheCFA2RGBCellBinningModeParameter = 0;
+CFA2RGBCellBinningOutputParameter*  TheCFA2RGBCellBinningOutputParameter = 0;
+CFA2RGBApplyColorMatrixParameter*   TheCFA2RGBApplyColorMatrixParameter = 0;
+CFA2RGBColorMatrixSourceParameter*  TheCFA2RGBColorMatrixSourceParameter = 0;
+CFA2RGBColorMatrix00Parameter*      TheCFA2RGBColorMatrix00Parameter = 0;
+CFA2RGBColorMatrix01Parameter*      TheCFA2RGBColorMatrix01Parameter = 0;
+CFA2RGBColorMatrix02Parameter*      TheCFA2RGBColorMatrix02Parameter = 0;
+CFA2RGBColorMatrix10Parameter*      TheCFA2RGBColorMatrix10Parameter = 0;
+CFA2RGBColorMatrix11Parameter*      TheCFA2RGBColorMatrix11Parameter = 0;
+CFA2RGBColorMatrix12Parameter*      TheCFA2RGBColorMatrix12Parameter = 0;
+CFA2RGBColorMatrix20Parameter*      TheCFA2RGBColorMatrix20Parameter = 0;
+CFA2RGBColorMatrix21Parameter*      TheCFA2RGBColorMatrix21Parameter = 0;
+CFA2RGBColorMatrix22Parameter*      TheCFA2RGBColorMatrix22Parameter = 0;
+CFA2RGBUseROIParameter*             TheCFA2RGBUseROIParameter = 0;
+CFA2RGBROIX0Parameter*              TheCFA2RGBROIX0Parameter = 0;
+CFA2RGBROIY0Parameter*              TheCFA2RGBROIY0Parameter = 0;
+CFA2RGBROIX1Parameter*              TheCFA2RGBROIX1Parameter = 0;
+CFA2RGBROIY1Parameter*              TheCFA2RGBROIY1Parameter = 0;
+CFA2RGBSourceViewParameter*         TheCFA2RGBSourceViewParameter = 0;
+CFA2RGBDirtyRectsParameter*         TheCFA2RGBDirtyRectsParameter = 0;
+CFA2RGBDirtyX0Parameter*            TheCFA2RGBDirtyX0Parameter = 0;
+CFA2RGBDirtyY0Parameter*            TheCFA2RGBDirtyY0Parameter = 0;
+CFA2RGBDirtyX1Parameter*            TheCFA2RGBDirtyX1Parameter = 0;
+CFA2RGBDirtyY1Parameter*            TheCFA2RGBDirtyY1Parameter = 0;
 
 // ----------------------------------------------------------------------------
 
@@ -90,6 +153,14 @@ IsoString CFA2RGBBayerPatternParameter::ElementId( size_type i ) const
    case BGGR: return "BGGR";
    case GBRG: return "GBRG";
    case GRBG: return "GRBG";
+   case QuadRGGB: return "QuadRGGB";
+   case QuadBGGR: return "QuadBGGR";
+   case QuadGBRG: return "QuadGBRG";
+   case QuadGRBG: return "QuadGRBG";
+   case NonaRGGB: return "NonaRGGB";
+   case NonaBGGR: return "NonaBGGR";
+   case NonaGBRG: return "NonaGBRG";
+   case NonaGRBG: return "NonaGRBG";
    }
 }
 
@@ -103,6 +174,1692 @@ size_type CFA2RGBBayerPatternParameter::DefaultValueIndex() const
    return Default;
 }
 
+// ----------------------------------------------------------------------------
+
+CFA2RGBBlockBinningParameter::CFA2RGBBlockBinningParameter( MetaProcess* P ) : MetaBoolean( P )
+{
+   TheCFA2RGBBlockBinningParameter = this;
+}
+
+IsoString CFA2RGBBlockBinningParameter::Id() const
+{
+   return "blockBinning";
+}
+
+bool CFA2RGBBlockBinningParameter::DefaultValue() const
+{
+   return false;
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBGenerateCoverageMapsParameter::CFA2RGBGenerateCoverageMapsParameter( MetaProcess* P ) : MetaBoolean( P )
+{
+   TheCFA2RGBGenerateCoverageMapsParameter = this;
+}
+
+IsoString CFA2RGBGenerateCoverageMapsParameter::Id() const
+{
+   return "generateCoverageMaps";
+}
+
+bool CFA2RGBGenerateCoverageMapsParameter::DefaultValue() const
+{
+   return false;
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBTargetFramesParameter::CFA2RGBTargetFramesParameter( MetaProcess* P ) : MetaTable( P )
+{
+   TheCFA2RGBTargetFramesParameter = this;
+}
+
+IsoString CFA2RGBTargetFramesParameter::Id() const
+{
+   return "targetFrames";
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBTargetFrameEnabledParameter::CFA2RGBTargetFrameEnabledParameter( MetaTable* T ) : MetaBoolean( T )
+{
+   TheCFA2RGBTargetFrameEnabledParameter = this;
+}
+
+IsoString CFA2RGBTargetFrameEnabledParameter::Id() const
+{
+   return "enabled";
+}
+
+bool CFA2RGBTargetFrameEnabledParameter::DefaultValue() const
+{
+   return true;
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBTargetFramePathParameter::CFA2RGBTargetFramePathParameter( MetaTable* T ) : MetaString( T )
+{
+   TheCFA2RGBTargetFramePathParameter = this;
+}
+
+IsoString CFA2RGBTargetFramePathParameter::Id() const
+{
+   return "path";
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBOutputDirectoryParameter::CFA2RGBOutputDirectoryParameter( MetaProcess* P ) : MetaString( P )
+{
+   TheCFA2RGBOutputDirectoryParameter = this;
+}
+
+IsoString CFA2RGBOutputDirectoryParameter::Id() const
+{
+   return "outputDirectory";
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBRawPackingParameter::CFA2RGBRawPackingParameter( MetaProcess* P ) : MetaEnumeration( P )
+{
+   TheCFA2RGBRawPackingParameter = this;
+}
+
+IsoString CFA2RGBRawPackingParameter::Id() const
+{
+   return "rawPacking";
+}
+
+size_type CFA2RGBRawPackingParameter::NumberOfElements() const
+{
+   return NumberOfItems;
+}
+
+IsoString CFA2RGBRawPackingParameter::ElementId( size_type i ) const
+{
+   switch ( i )
+   {
+   case MIPIRAW10: return "MIPIRAW10";
+   default:
+   case MIPIRAW12: return "MIPIRAW12";
+   case MIPIRAW14: return "MIPIRAW14";
+   case Packed12:  return "Packed12";
+   }
+}
+
+int CFA2RGBRawPackingParameter::ElementValue( size_type i ) const
+{
+   return int( i );
+}
+
+size_type CFA2RGBRawPackingParameter::DefaultValueIndex() const
+{
+   return Default;
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBRawWidthParameter::CFA2RGBRawWidthParameter( MetaProcess* P ) : MetaInt32( P )
+{
+   TheCFA2RGBRawWidthParameter = this;
+}
+
+IsoString CFA2RGBRawWidthParameter::Id() const
+{
+   return "rawWidth";
+}
+
+double CFA2RGBRawWidthParameter::DefaultValue() const
+{
+   return 0;
+}
+
+double CFA2RGBRawWidthParameter::MinimumValue() const
+{
+   return 0;
+}
+
+double CFA2RGBRawWidthParameter::MaximumValue() const
+{
+   return int32_max;
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBRawHeightParameter::CFA2RGBRawHeightParameter( MetaProcess* P ) : MetaInt32( P )
+{
+   TheCFA2RGBRawHeightParameter = this;
+}
+
+IsoString CFA2RGBRawHeightParameter::Id() const
+{
+   return "rawHeight";
+}
+
+double CFA2RGBRawHeightParameter::DefaultValue() const
+{
+   return 0;
+}
+
+double CFA2RGBRawHeightParameter::MinimumValue() const
+{
+   return 0;
+}
+
+double CFA2RGBRawHeightParameter::MaximumValue() const
+{
+   return int32_max;
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBRawStrideParameter::CFA2RGBRawStrideParameter( MetaProcess* P ) : MetaInt32( P )
+{
+   TheCFA2RGBRawStrideParameter = this;
+}
+
+IsoString CFA2RGBRawStrideParameter::Id() const
+{
+   return "rawStride";
+}
+
+double CFA2RGBRawStrideParameter::DefaultValue() const
+{
+   return 0;
+}
+
+double CFA2RGBRawStrideParameter::MinimumValue() const
+{
+   return 0;
+}
+
+double CFA2RGBRawStrideParameter::MaximumValue() const
+{
+   return int32_max;
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBOutputPostfixParameter::CFA2RGBOutputPostfixParameter( MetaProcess* P ) : MetaString( P )
+{
+   TheCFA2RGBOutputPostfixParameter = this;
+}
+
+IsoString CFA2RGBOutputPostfixParameter::Id() const
+{
+   return "outputPostfix";
+}
+
+String CFA2RGBOutputPostfixParameter::DefaultValue() const
+{
+   return "_rgb";
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBOverwriteExistingFilesParameter::CFA2RGBOverwriteExistingFilesParameter( MetaProcess* P ) : MetaBoolean( P )
+{
+   TheCFA2RGBOverwriteExistingFilesParameter = this;
+}
+
+IsoString CFA2RGBOverwriteExistingFilesParameter::Id() const
+{
+   return "overwriteExistingFiles";
+}
+
+bool CFA2RGBOverwriteExistingFilesParameter::DefaultValue() const
+{
+   return false;
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBUseFileCacheParameter::CFA2RGBUseFileCacheParameter( MetaProcess* P ) : MetaBoolean( P )
+{
+   TheCFA2RGBUseFileCacheParameter = this;
+}
+
+IsoString CFA2RGBUseFileCacheParameter::Id() const
+{
+   return "useFileCache";
+}
+
+bool CFA2RGBUseFileCacheParameter::DefaultValue() const
+{
+   return true;
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBOutputCompressionParameter::CFA2RGBOutputCompressionParameter( MetaProcess* P ) : MetaEnumeration( P )
+{
+   TheCFA2RGBOutputCompressionParameter = this;
+}
+
+IsoString CFA2RGBOutputCompressionParameter::Id() const
+{
+   return "outputCompression";
+}
+
+size_type CFA2RGBOutputCompressionParameter::NumberOfElements() const
+{
+   return NumberOfItems;
+}
+
+IsoString CFA2RGBOutputCompressionParameter::ElementId( size_type i ) const
+{
+   switch ( i )
+   {
+   case None:  return "Compression_None";
+   case Zlib:  return "Compression_Zlib";
+   default:
+   case LZ4:   return "Compression_LZ4";
+   case LZ4HC: return "Compression_LZ4HC";
+   }
+}
+
+int CFA2RGBOutputCompressionParameter::ElementValue( size_type i ) const
+{
+   return int( i );
+}
+
+size_type CFA2RGBOutputCompressionParameter::DefaultValueIndex() const
+{
+   return Default;
+}
+
+IsoString CFA2RGBOutputCompressionParameter::CodecName( pcl_enum i )
+{
+   switch ( i )
+   {
+   case None:  return IsoString();
+   case Zlib:  return "zlib";
+   default:
+   case LZ4:   return "lz4";
+   case LZ4HC: return "lz4hc";
+   }
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBOutputByteShufflingParameter::CFA2RGBOutputByteShufflingParameter( MetaProcess* P ) : MetaBoolean( P )
+{
+   TheCFA2RGBOutputByteShufflingParameter = this;
+}
+
+IsoString CFA2RGBOutputByteShufflingParameter::Id() const
+{
+   return "outputByteShuffling";
+}
+
+bool CFA2RGBOutputByteShufflingParameter::DefaultValue() const
+{
+   return true;
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBOnErrorParameter::CFA2RGBOnErrorParameter( MetaProcess* P ) : MetaEnumeration( P )
+{
+   TheCFA2RGBOnErrorParameter = this;
+}
+
+IsoString CFA2RGBOnErrorParameter::Id() const
+{
+   return "onError";
+}
+
+size_type CFA2RGBOnErrorParameter::NumberOfElements() const
+{
+   return NumberOfItems;
+}
+
+IsoString CFA2RGBOnErrorParameter::ElementId( size_type i ) const
+{
+   switch ( i )
+   {
+   default:
+   case Continue: return "OnError_Continue";
+   case Abort:    return "OnError_Abort";
+   }
+}
+
+int CFA2RGBOnErrorParameter::ElementValue( size_type i ) const
+{
+   return int( i );
+}
+
+size_type CFA2RGBOnErrorParameter::DefaultValueIndex() const
+{
+   return Default;
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBWriteOutputFilesParameter::CFA2RGBWriteOutputFilesParameter( MetaProcess* P ) : MetaBoolean( P )
+{
+   TheCFA2RGBWriteOutputFilesParameter = this;
+}
+
+IsoString CFA2RGBWriteOutputFilesParameter::Id() const
+{
+   return "writeOutputFiles";
+}
+
+bool CFA2RGBWriteOutputFilesParameter::DefaultValue() const
+{
+   return true;
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBIntegrateFramesParameter::CFA2RGBIntegrateFramesParameter( MetaProcess* P ) : MetaBoolean( P )
+{
+   TheCFA2RGBIntegrateFramesParameter = this;
+}
+
+IsoString CFA2RGBIntegrateFramesParameter::Id() const
+{
+   return "integrateFrames";
+}
+
+bool CFA2RGBIntegrateFramesParameter::DefaultValue() const
+{
+   return false;
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBGeneratePyramidParameter::CFA2RGBGeneratePyramidParameter( MetaProcess* P ) : MetaBoolean( P )
+{
+   TheCFA2RGBGeneratePyramidParameter = this;
+}
+
+IsoString CFA2RGBGeneratePyramidParameter::Id() const
+{
+   return "generatePyramid";
+}
+
+bool CFA2RGBGeneratePyramidParameter::DefaultValue() const
+{
+   return false;
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBPyramidLevelsParameter::CFA2RGBPyramidLevelsParameter( MetaProcess* P ) : MetaInt32( P )
+{
+   TheCFA2RGBPyramidLevelsParameter = this;
+}
+
+IsoString CFA2RGBPyramidLevelsParameter::Id() const
+{
+   return "pyramidLevels";
+}
+
+double CFA2RGBPyramidLevelsParameter::DefaultValue() const
+{
+   return 3;
+}
+
+double CFA2RGBPyramidLevelsParameter::MinimumValue() const
+{
+   return 1;
+}
+
+double CFA2RGBPyramidLevelsParameter::MaximumValue() const
+{
+   return CFA2RGBPyramid::MaxLevels;
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBPyramidFormatParameter::CFA2RGBPyramidFormatParameter( MetaProcess* P ) : MetaEnumeration( P )
+{
+   TheCFA2RGBPyramidFormatParameter = this;
+}
+
+IsoString CFA2RGBPyramidFormatParameter::Id() const
+{
+   return "pyramidFormat";
+}
+
+size_type CFA2RGBPyramidFormatParameter::NumberOfElements() const
+{
+   return NumberOfItems;
+}
+
+IsoString CFA2RGBPyramidFormatParameter::ElementId( size_type i ) const
+{
+   switch ( i )
+   {
+   default:
+   case XISF: return "PyramidFormat_XISF";
+   case PNG:  return "PyramidFormat_PNG";
+   }
+}
+
+int CFA2RGBPyramidFormatParameter::ElementValue( size_type i ) const
+{
+   return int( i );
+}
+
+size_type CFA2RGBPyramidFormatParameter::DefaultValueIndex() const
+{
+   return Default;
+}
+
+String CFA2RGBPyramidFormatParameter::FileExtension( pcl_enum format )
+{
+   switch ( format )
+   {
+   default:
+   case XISF: return ".xisf";
+   case PNG:  return ".png";
+   }
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBMemoryBudgetParameter::CFA2RGBMemoryBudgetParameter( MetaProcess* P ) : MetaInt32( P )
+{
+   TheCFA2RGBMemoryBudgetParameter = this;
+}
+
+IsoString CFA2RGBMemoryBudgetParameter::Id() const
+{
+   return "memoryBudget";
+}
+
+/*
+ * In MiB. Zero selects the available physical memory.
+ */
+double CFA2RGBMemoryBudgetParameter::DefaultValue() const
+{
+   return 0;
+}
+
+double CFA2RGBMemoryBudgetParameter::MinimumValue() const
+{
+   return 0;
+}
+
+double CFA2RGBMemoryBudgetParameter::MaximumValue() const
+{
+   return int32_max;
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBOutputModeParameter::CFA2RGBOutputModeParameter( MetaProcess* P ) : MetaEnumeration( P )
+{
+   TheCFA2RGBOutputModeParameter = this;
+}
+
+IsoString CFA2RGBOutputModeParameter::Id() const
+{
+   return "outputMode";
+}
+
+size_type CFA2RGBOutputModeParameter::NumberOfElements() const
+{
+   return NumberOfItems;
+}
+
+IsoString CFA2RGBOutputModeParameter::ElementId( size_type i ) const
+{
+   switch ( i )
+   {
+   default:
+   case RGB:             return "OutputMode_RGB";
+   case Green:           return "OutputMode_Green";
+   case GreenSuperpixel: return "OutputMode_GreenSuperpixel";
+   }
+}
+
+int CFA2RGBOutputModeParameter::ElementValue( size_type i ) const
+{
+   return int( i );
+}
+
+size_type CFA2RGBOutputModeParameter::DefaultValueIndex() const
+{
+   return Default;
+}
+
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBConvertOpenViewsParameter::CFA2RGBConvertOpenViewsParameter( MetaProcess* P ) : MetaBoolean( P )
+{
+   TheCFA2RGBConvertOpenViewsParameter = this;
+}
+
+IsoString CFA2RGBConvertOpenViewsParameter::Id() const
+{
+   return "convertOpenViews";
+}
+
+bool CFA2RGBConvertOpenViewsParameter::DefaultValue() const
+{
+   return false;
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBOutputSampleFormatParameter::CFA2RGBOutputSampleFormatParameter( MetaProcess* P ) : MetaEnumeration( P )
+{
+   TheCFA2RGBOutputSampleFormatParameter = this;
+}
+
+IsoString CFA2RGBOutputSampleFormatParameter::Id() const
+{
+   return "outputSampleFormat";
+}
+
+size_type CFA2RGBOutputSampleFormatParameter::NumberOfElements() const
+{
+   return NumberOfItems;
+}
+
+IsoString CFA2RGBOutputSampleFormatParameter::ElementId( size_type i ) const
+{
+   switch ( i )
+   {
+   default:
+   case SameAsInput: return "OutputSampleFormat_SameAsInput";
+   case UInt16:      return "OutputSampleFormat_UInt16";
+   }
+}
+
+int CFA2RGBOutputSampleFormatParameter::ElementValue( size_type i ) const
+{
+   return int( i );
+}
+
+size_type CFA2RGBOutputSampleFormatParameter::DefaultValueIndex() const
+{
+   return Default;
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBInterpolationParameter::CFA2RGBInterpolationParameter( MetaProcess* P ) : MetaEnumeration( P )
+{
+   TheCFA2RGBInterpolationParameter = this;
+}
+
+IsoString CFA2RGBInterpolationParameter::Id() const
+{
+   return "interpolation";
+}
+
+size_type CFA2RGBInterpolationParameter::NumberOfElements() const
+{
+   return NumberOfItems;
+}
+
+IsoString CFA2RGBInterpolationParameter::ElementId( size_type i ) const
+{
+   switch ( i )
+   {
+   default:
+   case None:     return "Interpolation_None";
+   case Bilinear: return "Interpolation_Bilinear";
+   case Gradient: return "Interpolation_Gradient";
+   }
+}
+
+int CFA2RGBInterpolationParameter::ElementValue( size_type i ) const
+{
+   return int( i );
+}
+
+size_type CFA2RGBInterpolationParameter::DefaultValueIndex() const
+{
+   return Default;
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBClaimDirectoryParameter::CFA2RGBClaimDirectoryParameter( MetaProcess* P ) : MetaString( P )
+{
+   TheCFA2RGBClaimDirectoryParameter = this;
+}
+
+IsoString CFA2RGBClaimDirectoryParameter::Id() const
+{
+   return "claimDirectory";
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBClaimTimeoutParameter::CFA2RGBClaimTimeoutParameter( MetaProcess* P ) : MetaInt32( P )
+{
+   TheCFA2RGBClaimTimeoutParameter = this;
+}
+
+IsoString CFA2RGBClaimTimeoutParameter::Id() const
+{
+   return "claimTimeout";
+}
+
+/*
+ * In seconds.
+ */
+double CFA2RGBClaimTimeoutParameter::DefaultValue() const
+{
+   return 600;
+}
+
+double CFA2RGBClaimTimeoutParameter::MinimumValue() const
+{
+   return 10;
+}
+
+double CFA2RGBClaimTimeoutParameter::MaximumValue() const
+{
+   return 86400;
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBConversionTimeParameter::CFA2RGBConversionTimeParameter( MetaProcess* P ) : MetaDouble( P )
+{
+   TheCFA2RGBConversionTimeParameter = this;
+}
+
+IsoString CFA2RGBConversionTimeParameter::Id() const
+{
+   return "conversionTime";
+}
+
+/*
+ * Seconds spent converting pixels in the last execution.
+ */
+int CFA2RGBConversionTimeParameter::Precision() const
+{
+   return 6;
+}
+
+bool CFA2RGBConversionTimeParameter::IsReadOnly() const
+{
+   return true;
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBConversionRateParameter::CFA2RGBConversionRateParameter( MetaProcess* P ) : MetaDouble( P )
+{
+   TheCFA2RGBConversionRateParameter = this;
+}
+
+IsoString CFA2RGBConversionRateParameter::Id() const
+{
+   return "conversionRate";
+}
+
+/*
+ * Input megapixels converted per second in the last execution.
+ */
+int CFA2RGBConversionRateParameter::Precision() const
+{
+   return 3;
+}
+
+bool CFA2RGBConversionRateParameter::IsReadOnly() const
+{
+   return true;
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBCorrectLateralCAParameter::CFA2RGBCorrectLateralCAParameter( MetaProcess* P ) : MetaBoolean( P )
+{
+   TheCFA2RGBCorrectLateralCAParameter = this;
+}
+
+IsoString CFA2RGBCorrectLateralCAParameter::Id() const
+{
+   return "correctLateralCA";
+}
+
+bool CFA2RGBCorrectLateralCAParameter::DefaultValue() const
+{
+   return false;
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBLateralCARedK0Parameter::CFA2RGBLateralCARedK0Parameter( MetaProcess* P ) : MetaDouble( P )
+{
+   TheCFA2RGBLateralCARedK0Parameter = this;
+}
+
+IsoString CFA2RGBLateralCARedK0Parameter::Id() const
+{
+   return "lateralCARedK0";
+}
+
+/*
+ * Coefficients of the radial magnification of the red and blue channels
+ * relative to green: 1 + k0 + k1*r^2 + k2*r^4, with r normalized to the
+ * half diagonal of the mosaic.
+ */
+int CFA2RGBLateralCARedK0Parameter::Precision() const
+{
+   return 6;
+}
+
+double CFA2RGBLateralCARedK0Parameter::DefaultValue() const
+{
+   return 0;
+}
+
+double CFA2RGBLateralCARedK0Parameter::MinimumValue() const
+{
+   return -0.1;
+}
+
+double CFA2RGBLateralCARedK0Parameter::MaximumValue() const
+{
+   return +0.1;
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBLateralCARedK1Parameter::CFA2RGBLateralCARedK1Parameter( MetaProcess* P ) : MetaDouble( P )
+{
+   TheCFA2RGBLateralCARedK1Parameter = this;
+}
+
+IsoString CFA2RGBLateralCARedK1Parameter::Id() const
+{
+   return "lateralCARedK1";
+}
+
+int CFA2RGBLateralCARedK1Parameter::Precision() const
+{
+   return 6;
+}
+
+double CFA2RGBLateralCARedK1Parameter::DefaultValue() const
+{
+   return 0;
+}
+
+double CFA2RGBLateralCARedK1Parameter::MinimumValue() const
+{
+   return -0.1;
+}
+
+double CFA2RGBLateralCARedK1Parameter::MaximumValue() const
+{
+   return +0.1;
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBLateralCARedK2Parameter::CFA2RGBLateralCARedK2Parameter( MetaProcess* P ) : MetaDouble( P )
+{
+   TheCFA2RGBLateralCARedK2Parameter = this;
+}
+
+IsoString CFA2RGBLateralCARedK2Parameter::Id() const
+{
+   return "lateralCARedK2";
+}
+
+int CFA2RGBLateralCARedK2Parameter::Precision() const
+{
+   return 6;
+}
+
+double CFA2RGBLateralCARedK2Parameter::DefaultValue() const
+{
+   return 0;
+}
+
+double CFA2RGBLateralCARedK2Parameter::MinimumValue() const
+{
+   return -0.1;
+}
+
+double CFA2RGBLateralCARedK2Parameter::MaximumValue() const
+{
+   return +0.1;
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBLateralCABlueK0Parameter::CFA2RGBLateralCABlueK0Parameter( MetaProcess* P ) : MetaDouble( P )
+{
+   TheCFA2RGBLateralCABlueK0Parameter = this;
+}
+
+IsoString CFA2RGBLateralCABlueK0Parameter::Id() const
+{
+   return "lateralCABlueK0";
+}
+
+int CFA2RGBLateralCABlueK0Parameter::Precision() const
+{
+   return 6;
+}
+
+double CFA2RGBLateralCABlueK0Parameter::DefaultValue() const
+{
+   return 0;
+}
+
+double CFA2RGBLateralCABlueK0Parameter::MinimumValue() const
+{
+   return -0.1;
+}
+
+double CFA2RGBLateralCABlueK0Parameter::MaximumValue() const
+{
+   return +0.1;
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBLateralCABlueK1Parameter::CFA2RGBLateralCABlueK1Parameter( MetaProcess* P ) : MetaDouble( P )
+{
+   TheCFA2RGBLateralCABlueK1Parameter = this;
+}
+
+IsoString CFA2RGBLateralCABlueK1Parameter::Id() const
+{
+   return "lateralCABlueK1";
+}
+
+int CFA2RGBLateralCABlueK1Parameter::Precision() const
+{
+   return 6;
+}
+
+double CFA2RGBLateralCABlueK1Parameter::DefaultValue() const
+{
+   return 0;
+}
+
+double CFA2RGBLateralCABlueK1Parameter::MinimumValue() const
+{
+   return -0.1;
+}
+
+double CFA2RGBLateralCABlueK1Parameter::MaximumValue() const
+{
+   return +0.1;
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBLateralCABlueK2Parameter::CFA2RGBLateralCABlueK2Parameter( MetaProcess* P ) : MetaDouble( P )
+{
+   TheCFA2RGBLateralCABlueK2Parameter = this;
+}
+
+IsoString CFA2RGBLateralCABlueK2Parameter::Id() const
+{
+   return "lateralCABlueK2";
+}
+
+int CFA2RGBLateralCABlueK2Parameter::Precision() const
+{
+   return 6;
+}
+
+double CFA2RGBLateralCABlueK2Parameter::DefaultValue() const
+{
+   return 0;
+}
+
+double CFA2RGBLateralCABlueK2Parameter::MinimumValue() const
+{
+   return -0.1;
+}
+
+double CFA2RGBLateralCABlueK2Parameter::MaximumValue() const
+{
+   return +0.1;
+}
+
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBCellBinningParameter::CFA2RGBCellBinningParameter( MetaProcess* P ) : MetaEnumeration( P )
+{
+   TheCFA2RGBCellBinningParameter = this;
+}
+
+IsoString CFA2RGBCellBinningParameter::Id() const
+{
+   return "cellBinning";
+}
+
+size_type CFA2RGBCellBinningParameter::NumberOfElements() const
+{
+   return NumberOfItems;
+}
+
+IsoString CFA2RGBCellBinningParameter::ElementId( size_type i ) const
+{
+   switch ( i )
+   {
+   default:
+   case None:   return "CellBinning_None";
+   case Bin2x2: return "CellBinning_2x2";
+   case Bin3x3: return "CellBinning_3x3";
+   }
+}
+
+int CFA2RGBCellBinningParameter::ElementValue( size_type i ) const
+{
+   return int( i );
+}
+
+size_type CFA2RGBCellBinningParameter::DefaultValueIndex() const
+{
+   return Default;
+}
+
+int CFA2RGBCellBinningParameter::Factor( pcl_enum binning )
+{
+   switch ( binning )
+   {
+   default:
+   case None:   return 1;
+   case Bin2x2: return 2;
+   case Bin3x3: return 3;
+   }
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBCellBinningModeParameter::CFA2RGBCellBinningModeParameter( MetaProcess* P ) : MetaEnumeration( P )
+{
+   TheCFA2RGBCellBinningModeParameter = this;
+}
+
+IsoString CFA2RGBCellBinningModeParameter::Id() const
+{
+   return "cellBinningMode";
+}
+
+size_type CFA2RGBCellBinningModeParameter::NumberOfElements() const
+{
+   return NumberOfItems;
+}
+
+IsoString CFA2RGBCellBinningModeParameter::ElementId( size_type i ) const
+{
+   switch ( i )
+   {
+   default:
+   case Average: return "CellBinningMode_Average";
+   case Sum:     return "CellBinningMode_Sum";
+   }
+}
+
+int CFA2RGBCellBinningModeParameter::ElementValue( size_type i ) const
+{
+   return int( i );
+}
+
+size_type CFA2RGBCellBinningModeParameter::DefaultValueIndex() const
+{
+   return Default;
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBCellBinningOutputParameter::CFA2RGBCellBinningOutputParameter( MetaProcess* P ) : MetaEnumeration( P )
+{
+   TheCFA2RGBCellBinningOutputParameter = this;
+}
+
+IsoString CFA2RGBCellBinningOutputParameter::Id() const
+{
+   return "cellBinningOutput";
+}
+
+size_type CFA2RGBCellBinningOutputParameter::NumberOfElements() const
+{
+   return NumberOfItems;
+}
+
+IsoString CFA2RGBCellBinningOutputParameter::ElementId( size_type i ) const
+{
+   switch ( i )
+   {
+   default:
+   case RGB: return "CellBinningOutput_RGB";
+   case CFA: return "CellBinningOutput_CFA";
+   }
+}
+
+int CFA2RGBCellBinningOutputParameter::ElementValue( size_type i ) const
+{
+   return int( i );
+}
+
+size_type CFA2RGBCellBinningOutputParameter::DefaultValueIndex() const
+{
+   return Default;
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBApplyColorMatrixParameter::CFA2RGBApplyColorMatrixParameter( MetaProcess* P ) : MetaBoolean( P )
+{
+   TheCFA2RGBApplyColorMatrixParameter = this;
+}
+
+IsoString CFA2RGBApplyColorMatrixParameter::Id() const
+{
+   return "applyColorMatrix";
+}
+
+bool CFA2RGBApplyColorMatrixParameter::DefaultValue() const
+{
+   return false;
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBColorMatrixSourceParameter::CFA2RGBColorMatrixSourceParameter( MetaProcess* P ) : MetaEnumeration( P )
+{
+   TheCFA2RGBColorMatrixSourceParameter = this;
+}
+
+IsoString CFA2RGBColorMatrixSourceParameter::Id() const
+{
+   return "colorMatrixSource";
+}
+
+size_type CFA2RGBColorMatrixSourceParameter::NumberOfElements() const
+{
+   return NumberOfItems;
+}
+
+/*
+ * Keywords: the FWDMAT11 ... FWDMAT33 keywords of each image, after the
+ * ForwardMatrix tags of DNG files, in row-major order.
+ */
+IsoString CFA2RGBColorMatrixSourceParameter::ElementId( size_type i ) const
+{
+   switch ( i )
+   {
+   default:
+   case Parameters: return "ColorMatrixSource_Parameters";
+   case Keywords:   return "ColorMatrixSource_Keywords";
+   }
+}
+
+int CFA2RGBColorMatrixSourceParameter::ElementValue( size_type i ) const
+{
+   return int( i );
+}
+
+size_type CFA2RGBColorMatrixSourceParameter::DefaultValueIndex() const
+{
+   return Default;
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBColorMatrix00Parameter::CFA2RGBColorMatrix00Parameter( MetaProcess* P ) : MetaDouble( P )
+{
+   TheCFA2RGBColorMatrix00Parameter = this;
+}
+
+IsoString CFA2RGBColorMatrix00Parameter::Id() const
+{
+   return "colorMatrix00";
+}
+
+/*
+ * Elements of the matrix transforming camera RGB into the working color
+ * space, in row-major order: colorMatrixIJ is the weight of camera channel J
+ * in output channel I.
+ */
+int CFA2RGBColorMatrix00Parameter::Precision() const
+{
+   return 6;
+}
+
+double CFA2RGBColorMatrix00Parameter::DefaultValue() const
+{
+   return 1;
+}
+
+double CFA2RGBColorMatrix00Parameter::MinimumValue() const
+{
+   return -16;
+}
+
+double CFA2RGBColorMatrix00Parameter::MaximumValue() const
+{
+   return +16;
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBColorMatrix01Parameter::CFA2RGBColorMatrix01Parameter( MetaProcess* P ) : MetaDouble( P )
+{
+   TheCFA2RGBColorMatrix01Parameter = this;
+}
+
+IsoString CFA2RGBColorMatrix01Parameter::Id() const
+{
+   return "colorMatrix01";
+}
+
+int CFA2RGBColorMatrix01Parameter::Precision() const
+{
+   return 6;
+}
+
+double CFA2RGBColorMatrix01Parameter::DefaultValue() const
+{
+   return 0;
+}
+
+double CFA2RGBColorMatrix01Parameter::MinimumValue() const
+{
+   return -16;
+}
+
+double CFA2RGBColorMatrix01Parameter::MaximumValue() const
+{
+   return +16;
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBColorMatrix02Parameter::CFA2RGBColorMatrix02Parameter( MetaProcess* P ) : MetaDouble( P )
+{
+   TheCFA2RGBColorMatrix02Parameter = this;
+}
+
+IsoString CFA2RGBColorMatrix02Parameter::Id() const
+{
+   return "colorMatrix02";
+}
+
+int CFA2RGBColorMatrix02Parameter::Precision() const
+{
+   return 6;
+}
+
+double CFA2RGBColorMatrix02Parameter::DefaultValue() const
+{
+   return 0;
+}
+
+double CFA2RGBColorMatrix02Parameter::MinimumValue() const
+{
+   return -16;
+}
+
+double CFA2RGBColorMatrix02Parameter::MaximumValue() const
+{
+   return +16;
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBColorMatrix10Parameter::CFA2RGBColorMatrix10Parameter( MetaProcess* P ) : MetaDouble( P )
+{
+   TheCFA2RGBColorMatrix10Parameter = this;
+}
+
+IsoString CFA2RGBColorMatrix10Parameter::Id() const
+{
+   return "colorMatrix10";
+}
+
+int CFA2RGBColorMatrix10Parameter::Precision() const
+{
+   return 6;
+}
+
+double CFA2RGBColorMatrix10Parameter::DefaultValue() const
+{
+   return 0;
+}
+
+double CFA2RGBColorMatrix10Parameter::MinimumValue() const
+{
+   return -16;
+}
+
+double CFA2RGBColorMatrix10Parameter::MaximumValue() const
+{
+   return +16;
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBColorMatrix11Parameter::CFA2RGBColorMatrix11Parameter( MetaProcess* P ) : MetaDouble( P )
+{
+   TheCFA2RGBColorMatrix11Parameter = this;
+}
+
+IsoString CFA2RGBColorMatrix11Parameter::Id() const
+{
+   return "colorMatrix11";
+}
+
+int CFA2RGBColorMatrix11Parameter::Precision() const
+{
+   return 6;
+}
+
+double CFA2RGBColorMatrix11Parameter::DefaultValue() const
+{
+   return 1;
+}
+
+double CFA2RGBColorMatrix11Parameter::MinimumValue() const
+{
+   return -16;
+}
+
+double CFA2RGBColorMatrix11Parameter::MaximumValue() const
+{
+   return +16;
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBColorMatrix12Parameter::CFA2RGBColorMatrix12Parameter( MetaProcess* P ) : MetaDouble( P )
+{
+   TheCFA2RGBColorMatrix12Parameter = this;
+}
+
+IsoString CFA2RGBColorMatrix12Parameter::Id() const
+{
+   return "colorMatrix12";
+}
+
+int CFA2RGBColorMatrix12Parameter::Precision() const
+{
+   return 6;
+}
+
+double CFA2RGBColorMatrix12Parameter::DefaultValue() const
+{
+   return 0;
+}
+
+double CFA2RGBColorMatrix12Parameter::MinimumValue() const
+{
+   return -16;
+}
+
+double CFA2RGBColorMatrix12Parameter::MaximumValue() const
+{
+   return +16;
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBColorMatrix20Parameter::CFA2RGBColorMatrix20Parameter( MetaProcess* P ) : MetaDouble( P )
+{
+   TheCFA2RGBColorMatrix20Parameter = this;
+}
+
+IsoString CFA2RGBColorMatrix20Parameter::Id() const
+{
+   return "colorMatrix20";
+}
+
+int CFA2RGBColorMatrix20Parameter::Precision() const
+{
+   return 6;
+}
+
+double CFA2RGBColorMatrix20Parameter::DefaultValue() const
+{
+   return 0;
+}
+
+double CFA2RGBColorMatrix20Parameter::MinimumValue() const
+{
+   return -16;
+}
+
+double CFA2RGBColorMatrix20Parameter::MaximumValue() const
+{
+   return +16;
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBColorMatrix21Parameter::CFA2RGBColorMatrix21Parameter( MetaProcess* P ) : MetaDouble( P )
+{
+   TheCFA2RGBColorMatrix21Parameter = this;
+}
+
+IsoString CFA2RGBColorMatrix21Parameter::Id() const
+{
+   return "colorMatrix21";
+}
+
+int CFA2RGBColorMatrix21Parameter::Precision() const
+{
+   return 6;
+}
+
+double CFA2RGBColorMatrix21Parameter::DefaultValue() const
+{
+   return 0;
+}
+
+double CFA2RGBColorMatrix21Parameter::MinimumValue() const
+{
+   return -16;
+}
+
+double CFA2RGBColorMatrix21Parameter::MaximumValue() const
+{
+   return +16;
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBColorMatrix22Parameter::CFA2RGBColorMatrix22Parameter( MetaProcess* P ) : MetaDouble( P )
+{
+   TheCFA2RGBColorMatrix22Parameter = this;
+}
+
+IsoString CFA2RGBColorMatrix22Parameter::Id() const
+{
+   return "colorMatrix22";
+}
+
+int CFA2RGBColorMatrix22Parameter::Precision() const
+{
+   return 6;
+}
+
+double CFA2RGBColorMatrix22Parameter::DefaultValue() const
+{
+   return 1;
+}
+
+double CFA2RGBColorMatrix22Parameter::MinimumValue() const
+{
+   return -16;
+}
+
+double CFA2RGBColorMatrix22Parameter::MaximumValue() const
+{
+   return +16;
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBUseROIParameter::CFA2RGBUseROIParameter( MetaProcess* P ) : MetaBoolean( P )
+{
+   TheCFA2RGBUseROIParameter = this;
+}
+
+IsoString CFA2RGBUseROIParameter::Id() const
+{
+   return "useROI";
+}
+
+bool CFA2RGBUseROIParameter::DefaultValue() const
+{
+   return false;
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBROIX0Parameter::CFA2RGBROIX0Parameter( MetaProcess* P ) : MetaInt32( P )
+{
+   TheCFA2RGBROIX0Parameter = this;
+}
+
+IsoString CFA2RGBROIX0Parameter::Id() const
+{
+   return "roiX0";
+}
+
+double CFA2RGBROIX0Parameter::DefaultValue() const
+{
+   return 0;
+}
+
+double CFA2RGBROIX0Parameter::MinimumValue() const
+{
+   return 0;
+}
+
+double CFA2RGBROIX0Parameter::MaximumValue() const
+{
+   return int32_max;
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBROIY0Parameter::CFA2RGBROIY0Parameter( MetaProcess* P ) : MetaInt32( P )
+{
+   TheCFA2RGBROIY0Parameter = this;
+}
+
+IsoString CFA2RGBROIY0Parameter::Id() const
+{
+   return "roiY0";
+}
+
+double CFA2RGBROIY0Parameter::DefaultValue() const
+{
+   return 0;
+}
+
+double CFA2RGBROIY0Parameter::MinimumValue() const
+{
+   return 0;
+}
+
+double CFA2RGBROIY0Parameter::MaximumValue() const
+{
+   return int32_max;
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBROIX1Parameter::CFA2RGBROIX1Parameter( MetaProcess* P ) : MetaInt32( P )
+{
+   TheCFA2RGBROIX1Parameter = this;
+}
+
+IsoString CFA2RGBROIX1Parameter::Id() const
+{
+   return "roiX1";
+}
+
+double CFA2RGBROIX1Parameter::DefaultValue() const
+{
+   return 0;
+}
+
+double CFA2RGBROIX1Parameter::MinimumValue() const
+{
+   return 0;
+}
+
+double CFA2RGBROIX1Parameter::MaximumValue() const
+{
+   return int32_max;
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBROIY1Parameter::CFA2RGBROIY1Parameter( MetaProcess* P ) : MetaInt32( P )
+{
+   TheCFA2RGBROIY1Parameter = this;
+}
+
+IsoString CFA2RGBROIY1Parameter::Id() const
+{
+   return "roiY1";
+}
+
+double CFA2RGBROIY1Parameter::DefaultValue() const
+{
+   return 0;
+}
+
+double CFA2RGBROIY1Parameter::MinimumValue() const
+{
+   return 0;
+}
+
+double CFA2RGBROIY1Parameter::MaximumValue() const
+{
+   return int32_max;
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBSourceViewParameter::CFA2RGBSourceViewParameter( MetaProcess* P ) : MetaString( P )
+{
+   TheCFA2RGBSourceViewParameter = this;
+}
+
+IsoString CFA2RGBSourceViewParameter::Id() const
+{
+   return "sourceView";
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBDirtyRectsParameter::CFA2RGBDirtyRectsParameter( MetaProcess* P ) : MetaTable( P )
+{
+   TheCFA2RGBDirtyRectsParameter = this;
+}
+
+IsoString CFA2RGBDirtyRectsParameter::Id() const
+{
+   return "dirtyRects";
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBDirtyX0Parameter::CFA2RGBDirtyX0Parameter( MetaTable* T ) : MetaInt32( T )
+{
+   TheCFA2RGBDirtyX0Parameter = this;
+}
+
+IsoString CFA2RGBDirtyX0Parameter::Id() const
+{
+   return "dirtyX0";
+}
+
+double CFA2RGBDirtyX0Parameter::DefaultValue() const
+{
+   return 0;
+}
+
+double CFA2RGBDirtyX0Parameter::MinimumValue() const
+{
+   return 0;
+}
+
+double CFA2RGBDirtyX0Parameter::MaximumValue() const
+{
+   return int32_max;
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBDirtyY0Parameter::CFA2RGBDirtyY0Parameter( MetaTable* T ) : MetaInt32( T )
+{
+   TheCFA2RGBDirtyY0Parameter = this;
+}
+
+IsoString CFA2RGBDirtyY0Parameter::Id() const
+{
+   return "dirtyY0";
+}
+
+double CFA2RGBDirtyY0Parameter::DefaultValue() const
+{
+   return 0;
+}
+
+double CFA2RGBDirtyY0Parameter::MinimumValue() const
+{
+   return 0;
+}
+
+double CFA2RGBDirtyY0Parameter::MaximumValue() const
+{
+   return int32_max;
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBDirtyX1Parameter::CFA2RGBDirtyX1Parameter( MetaTable* T ) : MetaInt32( T )
+{
+   TheCFA2RGBDirtyX1Parameter = this;
+}
+
+IsoString CFA2RGBDirtyX1Parameter::Id() const
+{
+   return "dirtyX1";
+}
+
+double CFA2RGBDirtyX1Parameter::DefaultValue() const
+{
+   return 0;
+}
+
+double CFA2RGBDirtyX1Parameter::MinimumValue() const
+{
+   return 0;
+}
+
+double CFA2RGBDirtyX1Parameter::MaximumValue() const
+{
+   return int32_max;
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBDirtyY1Parameter::CFA2RGBDirtyY1Parameter( MetaTable* T ) : MetaInt32( T )
+{
+   TheCFA2RGBDirtyY1Parameter = this;
+}
+
+IsoString CFA2RGBDirtyY1Parameter::Id() const
+{
+   return "dirtyY1";
+}
+
+double CFA2RGBDirtyY1Parameter::DefaultValue() const
+{
+   return 0;
+}
+
+double CFA2RGBDirtyY1Parameter::MinimumValue() const
+{
+   return 0;
+}
+
+double CFA2RGBDirtyY1Parameter::MaximumValue() const
+{
+   return int32_max;
+}
 
 // ----------------------------------------------------------------------------
 
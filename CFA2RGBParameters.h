@@ -70,6 +70,14 @@ public:
           BGGR,
           GBRG,
           GRBG,
+          QuadRGGB,
+          QuadBGGR,
+          QuadGBRG,
+          QuadGRBG,
+          NonaRGGB,
+          NonaBGGR,
+          NonaGBRG,
+          NonaGRBG,
           NumberOfItems,
           Default = RGGB };
 
@@ -88,6 +96,1051 @@ extern CFA2RGBBayerPatternParameter* TheCFA2RGBBayerPatternParameter;
 
 // ----------------------------------------------------------------------------
 
+class CFA2RGBBlockBinningParameter : public MetaBoolean
+{
+public:
+
+   CFA2RGBBlockBinningParameter( MetaProcess* );
+
+   virtual IsoString Id() const;
+   virtual bool DefaultValue() const;
+};
+
+extern CFA2RGBBlockBinningParameter* TheCFA2RGBBlockBinningParameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBGenerateCoverageMapsParameter : public MetaBoolean
+{
+public:
+
+   CFA2RGBGenerateCoverageMapsParameter( MetaProcess* );
+
+   virtual IsoString Id() const;
+   virtual bool DefaultValue() const;
+};
+
+extern CFA2RGBGenerateCoverageMapsParameter* TheCFA2RGBGenerateCoverageMapsParameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBTargetFramesParameter : public MetaTable
+{
+public:
+
+   CFA2RGBTargetFramesParameter( MetaProcess* );
+
+   virtual IsoString Id() const;
+};
+
+extern CFA2RGBTargetFramesParameter* TheCFA2RGBTargetFramesParameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBTargetFrameEnabledParameter : public MetaBoolean
+{
+public:
+
+   CFA2RGBTargetFrameEnabledParameter( MetaTable* );
+
+   virtual IsoString Id() const;
+   virtual bool DefaultValue() const;
+};
+
+extern CFA2RGBTargetFrameEnabledParameter* TheCFA2RGBTargetFrameEnabledParameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBTargetFramePathParameter : public MetaString
+{
+public:
+
+   CFA2RGBTargetFramePathParameter( MetaTable* );
+
+   virtual IsoString Id() const;
+};
+
+extern CFA2RGBTargetFramePathParameter* TheCFA2RGBTargetFramePathParameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBOutputDirectoryParameter : public MetaString
+{
+public:
+
+   CFA2RGBOutputDirectoryParameter( MetaProcess* );
+
+   virtual IsoString Id() const;
+};
+
+extern CFA2RGBOutputDirectoryParameter* TheCFA2RGBOutputDirectoryParameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBRawPackingParameter : public MetaEnumeration
+{
+public:
+
+   enum { MIPIRAW10,   // 4 pixels in 5 bytes, MSBs first
+          MIPIRAW12,   // 2 pixels in 3 bytes, MSBs first
+          MIPIRAW14,   // 4 pixels in 7 bytes, MSBs first
+          Packed12,    // 2 pixels in 3 bytes, little-endian bitstream
+          NumberOfItems,
+          Default = MIPIRAW12 };
+
+   CFA2RGBRawPackingParameter( MetaProcess* );
+
+   virtual IsoString Id() const;
+   virtual size_type NumberOfElements() const;
+   virtual IsoString ElementId( size_type ) const;
+   virtual int ElementValue( size_type ) const;
+   virtual size_type DefaultValueIndex() const;
+};
+
+extern CFA2RGBRawPackingParameter* TheCFA2RGBRawPackingParameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBRawWidthParameter : public MetaInt32
+{
+public:
+
+   CFA2RGBRawWidthParameter( MetaProcess* );
+
+   virtual IsoString Id() const;
+   virtual double DefaultValue() const;
+   virtual double MinimumValue() const;
+   virtual double MaximumValue() const;
+};
+
+extern CFA2RGBRawWidthParameter* TheCFA2RGBRawWidthParameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBRawHeightParameter : public MetaInt32
+{
+public:
+
+   CFA2RGBRawHeightParameter( MetaProcess* );
+
+   virtual IsoString Id() const;
+   virtual double DefaultValue() const;
+   virtual double MinimumValue() const;
+   virtual double MaximumValue() const;
+};
+
+extern CFA2RGBRawHeightParameter* TheCFA2RGBRawHeightParameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBRawStrideParameter : public MetaInt32
+{
+public:
+
+   CFA2RGBRawStrideParameter( MetaProcess* );
+
+   virtual IsoString Id() const;
+   virtual double DefaultValue() const;
+   virtual double MinimumValue() const;
+   virtual double MaximumValue() const;
+};
+
+extern CFA2RGBRawStrideParameter* TheCFA2RGBRawStrideParameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBOutputPostfixParameter : public MetaString
+{
+public:
+
+   CFA2RGBOutputPostfixParameter( MetaProcess* );
+
+   virtual IsoString Id() const;
+   virtual String DefaultValue() const;
+};
+
+extern CFA2RGBOutputPostfixParameter* TheCFA2RGBOutputPostfixParameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBOverwriteExistingFilesParameter : public MetaBoolean
+{
+public:
+
+   CFA2RGBOverwriteExistingFilesParameter( MetaProcess* );
+
+   virtual IsoString Id() const;
+   virtual bool DefaultValue() const;
+};
+
+extern CFA2RGBOverwriteExistingFilesParameter* TheCFA2RGBOverwriteExistingFilesParameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBUseFileCacheParameter : public MetaBoolean
+{
+public:
+
+   CFA2RGBUseFileCacheParameter( MetaProcess* );
+
+   virtual IsoString Id() const;
+   virtual bool DefaultValue() const;
+};
+
+extern CFA2RGBUseFileCacheParameter* TheCFA2RGBUseFileCacheParameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBOutputCompressionParameter : public MetaEnumeration
+{
+public:
+
+   enum { None,
+          Zlib,
+          LZ4,
+          LZ4HC,
+          NumberOfItems,
+          Default = LZ4 };
+
+   CFA2RGBOutputCompressionParameter( MetaProcess* );
+
+   virtual IsoString Id() const;
+   virtual size_type NumberOfElements() const;
+   virtual IsoString ElementId( size_type ) const;
+   virtual int ElementValue( size_type ) const;
+   virtual size_type DefaultValueIndex() const;
+
+   /*
+    * XISF compression codec name for an item, without the byte shuffling
+    * suffix. Returns an empty string for uncompressed output.
+    */
+   static IsoString CodecName( pcl_enum );
+};
+
+extern CFA2RGBOutputCompressionParameter* TheCFA2RGBOutputCompressionParameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBOutputByteShufflingParameter : public MetaBoolean
+{
+public:
+
+   CFA2RGBOutputByteShufflingParameter( MetaProcess* );
+
+   virtual IsoString Id() const;
+   virtual bool DefaultValue() const;
+};
+
+extern CFA2RGBOutputByteShufflingParameter* TheCFA2RGBOutputByteShufflingParameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBOnErrorParameter : public MetaEnumeration
+{
+public:
+
+   enum { Continue,
+          Abort,
+          NumberOfItems,
+          Default = Continue };
+
+   CFA2RGBOnErrorParameter( MetaProcess* );
+
+   virtual IsoString Id() const;
+   virtual size_type NumberOfElements() const;
+   virtual IsoString ElementId( size_type ) const;
+   virtual int ElementValue( size_type ) const;
+   virtual size_type DefaultValueIndex() const;
+};
+
+extern CFA2RGBOnErrorParameter* TheCFA2RGBOnErrorParameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBWriteOutputFilesParameter : public MetaBoolean
+{
+public:
+
+   CFA2RGBWriteOutputFilesParameter( MetaProcess* );
+
+   virtual IsoString Id() const;
+   virtual bool DefaultValue() const;
+};
+
+extern CFA2RGBWriteOutputFilesParameter* TheCFA2RGBWriteOutputFilesParameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBIntegrateFramesParameter : public MetaBoolean
+{
+public:
+
+   CFA2RGBIntegrateFramesParameter( MetaProcess* );
+
+   virtual IsoString Id() const;
+   virtual bool DefaultValue() const;
+};
+
+extern CFA2RGBIntegrateFramesParameter* TheCFA2RGBIntegrateFramesParameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBGeneratePyramidParameter : public MetaBoolean
+{
+public:
+
+   CFA2RGBGeneratePyramidParameter( MetaProcess* );
+
+   virtual IsoString Id() const;
+   virtual bool DefaultValue() const;
+};
+
+extern CFA2RGBGeneratePyramidParameter* TheCFA2RGBGeneratePyramidParameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBPyramidLevelsParameter : public MetaInt32
+{
+public:
+
+   CFA2RGBPyramidLevelsParameter( MetaProcess* );
+
+   virtual IsoString Id() const;
+   virtual double DefaultValue() const;
+   virtual double MinimumValue() const;
+   virtual double MaximumValue() const;
+};
+
+extern CFA2RGBPyramidLevelsParameter* TheCFA2RGBPyramidLevelsParameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBPyramidFormatParameter : public MetaEnumeration
+{
+public:
+
+   enum { XISF,
+          PNG,
+          NumberOfItems,
+          Default = XISF };
+
+   CFA2RGBPyramidFormatParameter( MetaProcess* );
+
+   virtual IsoString Id() const;
+   virtual size_type NumberOfElements() const;
+   virtual IsoString ElementId( size_type ) const;
+   virtual int ElementValue( size_type ) const;
+   virtual size_type DefaultValueIndex() const;
+
+   static String FileExtension( pcl_enum );
+};
+
+extern CFA2RGBPyramidFormatParameter* TheCFA2RGBPyramidFormatParameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBMemoryBudgetParameter : public MetaInt32
+{
+public:
+
+   CFA2RGBMemoryBudgetParameter( MetaProcess* );
+
+   virtual IsoString Id() const;
+   virtual double DefaultValue() const;
+   virtual double MinimumValue() const;
+   virtual double MaximumValue() const;
+};
+
+extern CFA2RGBMemoryBudgetParameter* TheCFA2RGBMemoryBudgetParameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBOutputModeParameter : public MetaEnumeration
+{
+public:
+
+   enum { RGB,
+          Green,
+          GreenSuperpixel,
+          NumberOfItems,
+          Default = RGB };
+
+   CFA2RGBOutputModeParameter( MetaProcess* );
+
+   virtual IsoString Id() const;
+   virtual size_type NumberOfElements() const;
+   virtual IsoString ElementId( size_type ) const;
+   virtual int ElementValue( size_type ) const;
+   virtual size_type DefaultValueIndex() const;
+};
+
+extern CFA2RGBOutputModeParameter* TheCFA2RGBOutputModeParameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBConvertOpenViewsParameter : public MetaBoolean
+{
+public:
+
+   CFA2RGBConvertOpenViewsParameter( MetaProcess* );
+
+   virtual IsoString Id() const;
+   virtual bool DefaultValue() const;
+};
+
+extern CFA2RGBConvertOpenViewsParameter* TheCFA2RGBConvertOpenViewsParameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBOutputSampleFormatParameter : public MetaEnumeration
+{
+public:
+
+   enum { SameAsInput,
+          UInt16,
+          NumberOfItems,
+          Default = SameAsInput };
+
+   CFA2RGBOutputSampleFormatParameter( MetaProcess* );
+
+   virtual IsoString Id() const;
+   virtual size_type NumberOfElements() const;
+   virtual IsoString ElementId( size_type ) const;
+   virtual int ElementValue( size_type ) const;
+   virtual size_type DefaultValueIndex() const;
+};
+
+extern CFA2RGBOutputSampleFormatParameter* TheCFA2RGBOutputSampleFormatParameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBInterpolationParameter : public MetaEnumeration
+{
+public:
+
+   enum { None,
+          Bilinear,
+          Gradient,
+          NumberOfItems,
+          Default = None };
+
+   CFA2RGBInterpolationParameter( MetaProcess* );
+
+   virtual IsoString Id() const;
+   virtual size_type NumberOfElements() const;
+   virtual IsoString ElementId( size_type ) const;
+   virtual int ElementValue( size_type ) const;
+   virtual size_type DefaultValueIndex() const;
+};
+
+extern CFA2RGBInterpolationParameter* TheCFA2RGBInterpolationParameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBClaimDirectoryParameter : public MetaString
+{
+public:
+
+   CFA2RGBClaimDirectoryParameter( MetaProcess* );
+
+   virtual IsoString Id() const;
+};
+
+extern CFA2RGBClaimDirectoryParameter* TheCFA2RGBClaimDirectoryParameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBClaimTimeoutParameter : public MetaInt32
+{
+public:
+
+   CFA2RGBClaimTimeoutParameter( MetaProcess* );
+
+   virtual IsoString Id() const;
+   virtual double DefaultValue() const;
+   virtual double MinimumValue() const;
+   virtual double MaximumValue() const;
+};
+
+extern CFA2RGBClaimTimeoutParameter* TheCFA2RGBClaimTimeoutParameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBConversionTimeParameter : public MetaDouble
+{
+public:
+
+   CFA2RGBConversionTimeParameter( MetaProcess* );
+
+   virtual IsoString Id() const;
+   virtual int Precision() const;
+   virtual bool IsReadOnly() const;
+};
+
+extern CFA2RGBConversionTimeParameter* TheCFA2RGBConversionTimeParameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBConversionRateParameter : public MetaDouble
+{
+public:
+
+   CFA2RGBConversionRateParameter( MetaProcess* );
+
+   virtual IsoString Id() const;
+   virtual int Precision() const;
+   virtual bool IsReadOnly() const;
+};
+
+extern CFA2RGBConversionRateParameter* TheCFA2RGBConversionRateParameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBCorrectLateralCAParameter : public MetaBoolean
+{
+public:
+
+   CFA2RGBCorrectLateralCAParameter( MetaProcess* );
+
+   virtual IsoString Id() const;
+   virtual bool DefaultValue() const;
+};
+
+extern CFA2RGBCorrectLateralCAParameter* TheCFA2RGBCorrectLateralCAParameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBLateralCARedK0Parameter : public MetaDouble
+{
+public:
+
+   CFA2RGBLateralCARedK0Parameter( MetaProcess* );
+
+   virtual IsoString Id() const;
+   virtual int Precision() const;
+   virtual double DefaultValue() const;
+   virtual double MinimumValue() const;
+   virtual double MaximumValue() const;
+};
+
+extern CFA2RGBLateralCARedK0Parameter* TheCFA2RGBLateralCARedK0Parameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBLateralCARedK1Parameter : public MetaDouble
+{
+public:
+
+   CFA2RGBLateralCARedK1Parameter( MetaProcess* );
+
+   virtual IsoString Id() const;
+   virtual int Precision() const;
+   virtual double DefaultValue() const;
+   virtual double MinimumValue() const;
+   virtual double MaximumValue() const;
+};
+
+extern CFA2RGBLateralCARedK1Parameter* TheCFA2RGBLateralCARedK1Parameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBLateralCARedK2Parameter : public MetaDouble
+{
+public:
+
+   CFA2RGBLateralCARedK2Parameter( MetaProcess* );
+
+   virtual IsoString Id() const;
+   virtual int Precision() const;
+   virtual double DefaultValue() const;
+   virtual double MinimumValue() const;
+   virtual double MaximumValue() const;
+};
+
+extern CFA2RGBLateralCARedK2Parameter* TheCFA2RGBLateralCARedK2Parameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBLateralCABlueK0Parameter : public MetaDouble
+{
+public:
+
+   CFA2RGBLateralCABlueK0Parameter( MetaProcess* );
+
+   virtual IsoString Id() const;
+   virtual int Precision() const;
+   virtual double DefaultValue() const;
+   virtual double MinimumValue() const;
+   virtual double MaximumValue() const;
+};
+
+extern CFA2RGBLateralCABlueK0Parameter* TheCFA2RGBLateralCABlueK0Parameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBLateralCABlueK1Parameter : public MetaDouble
+{
+public:
+
+   CFA2RGBLateralCABlueK1Parameter( MetaProcess* );
+
+   virtual IsoString Id() const;
+   virtual int Precision() const;
+   virtual double DefaultValue() const;
+   virtual double MinimumValue() const;
+   virtual double MaximumValue() const;
+};
+
+extern CFA2RGBLateralCABlueK1Parameter* TheCFA2RGBLateralCABlueK1Parameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBLateralCABlueK2Parameter : public MetaDouble
+{
+public:
+
+   CFA2RGBLateralCABlueK2Parameter( MetaProcess* );
+
+   virtual IsoString Id() const;
+   virtual int Precision() const;
+   virtual double DefaultValue() const;
+   virtual double MinimumValue() const;
+   virtual double MaximumValue() const;
+};
+
+extern CFA2RGBLateralCABlueK2Parameter* TheCFA2RGBLateralCABlueK2Parameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBCellBinningParameter : public MetaEnumeration
+{
+public:
+
+   enum { None,
+          Bin2x2,
+          Bin3x3,
+          NumberOfItems,
+          Default = None };
+
+   CFA2RGBCellBinningParameter( MetaProcess* );
+
+   virtual IsoString Id() const;
+   virtual size_type NumberOfElements() const;
+   virtual IsoString ElementId( size_type ) const;
+   virtual int ElementValue( size_type ) const;
+   virtual size_type DefaultValueIndex() const;
+
+   /*
+    * Number of pattern cells binned along each axis.
+    */
+   static int Factor( pcl_enum );
+};
+
+extern CFA2RGBCellBinningParameter* TheCFA2RGBCellBinningParameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBCellBinningModeParameter : public MetaEnumeration
+{
+public:
+
+   enum { Average,
+          Sum,
+          NumberOfItems,
+          Default = Average };
+
+   CFA2RGBCellBinningModeParameter( MetaProcess* );
+
+   virtual IsoString Id() const;
+   virtual size_type NumberOfElements() const;
+   virtual IsoString ElementId( size_type ) const;
+   virtual int ElementValue( size_type ) const;
+   virtual size_type DefaultValueIndex() const;
+};
+
+extern CFA2RGBCellBinningModeParameter* TheCFA2RGBCellBinningModeParameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBCellBinningOutputParameter : public MetaEnumeration
+{
+public:
+
+   enum { RGB,
+          CFA,
+          NumberOfItems,
+          Default = RGB };
+
+   CFA2RGBCellBinningOutputParameter( MetaProcess* );
+
+   virtual IsoString Id() const;
+   virtual size_type NumberOfElements() const;
+   virtual IsoString ElementId( size_type ) const;
+   virtual int ElementValue( size_type ) const;
+   virtual size_type DefaultValueIndex() const;
+};
+
+extern CFA2RGBCellBinningOutputParameter* TheCFA2RGBCellBinningOutputParameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBApplyColorMatrixParameter : public MetaBoolean
+{
+public:
+
+   CFA2RGBApplyColorMatrixParameter( MetaProcess* );
+
+   virtual IsoString Id() const;
+   virtual bool DefaultValue() const;
+};
+
+extern CFA2RGBApplyColorMatrixParameter* TheCFA2RGBApplyColorMatrixParameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBColorMatrixSourceParameter : public MetaEnumeration
+{
+public:
+
+   enum { Parameters,
+          Keywords,
+          NumberOfItems,
+          Default = Parameters };
+
+   CFA2RGBColorMatrixSourceParameter( MetaProcess* );
+
+   virtual IsoString Id() const;
+   virtual size_type NumberOfElements() const;
+   virtual IsoString ElementId( size_type ) const;
+   virtual int ElementValue( size_type ) const;
+   virtual size_type DefaultValueIndex() const;
+};
+
+extern CFA2RGBColorMatrixSourceParameter* TheCFA2RGBColorMatrixSourceParameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBColorMatrix00Parameter : public MetaDouble
+{
+public:
+
+   CFA2RGBColorMatrix00Parameter( MetaProcess* );
+
+   virtual IsoString Id() const;
+   virtual int Precision() const;
+   virtual double DefaultValue() const;
+   virtual double MinimumValue() const;
+   virtual double MaximumValue() const;
+};
+
+extern CFA2RGBColorMatrix00Parameter* TheCFA2RGBColorMatrix00Parameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBColorMatrix01Parameter : public MetaDouble
+{
+public:
+
+   CFA2RGBColorMatrix01Parameter( MetaProcess* );
+
+   virtual IsoString Id() const;
+   virtual int Precision() const;
+   virtual double DefaultValue() const;
+   virtual double MinimumValue() const;
+   virtual double MaximumValue() const;
+};
+
+extern CFA2RGBColorMatrix01Parameter* TheCFA2RGBColorMatrix01Parameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBColorMatrix02Parameter : public MetaDouble
+{
+public:
+
+   CFA2RGBColorMatrix02Parameter( MetaProcess* );
+
+   virtual IsoString Id() const;
+   virtual int Precision() const;
+   virtual double DefaultValue() const;
+   virtual double MinimumValue() const;
+   virtual double MaximumValue() const;
+};
+
+extern CFA2RGBColorMatrix02Parameter* TheCFA2RGBColorMatrix02Parameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBColorMatrix10Parameter : public MetaDouble
+{
+public:
+
+   CFA2RGBColorMatrix10Parameter( MetaProcess* );
+
+   virtual IsoString Id() const;
+   virtual int Precision() const;
+   virtual double DefaultValue() const;
+   virtual double MinimumValue() const;
+   virtual double MaximumValue() const;
+};
+
+extern CFA2RGBColorMatrix10Parameter* TheCFA2RGBColorMatrix10Parameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBColorMatrix11Parameter : public MetaDouble
+{
+public:
+
+   CFA2RGBColorMatrix11Parameter( MetaProcess* );
+
+   virtual IsoString Id() const;
+   virtual int Precision() const;
+   virtual double DefaultValue() const;
+   virtual double MinimumValue() const;
+   virtual double MaximumValue() const;
+};
+
+extern CFA2RGBColorMatrix11Parameter* TheCFA2RGBColorMatrix11Parameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBColorMatrix12Parameter : public MetaDouble
+{
+public:
+
+   CFA2RGBColorMatrix12Parameter( MetaProcess* );
+
+   virtual IsoString Id() const;
+   virtual int Precision() const;
+   virtual double DefaultValue() const;
+   virtual double MinimumValue() const;
+   virtual double MaximumValue() const;
+};
+
+extern CFA2RGBColorMatrix12Parameter* TheCFA2RGBColorMatrix12Parameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBColorMatrix20Parameter : public MetaDouble
+{
+public:
+
+   CFA2RGBColorMatrix20Parameter( MetaProcess* );
+
+   virtual IsoString Id() const;
+   virtual int Precision() const;
+   virtual double DefaultValue() const;
+   virtual double MinimumValue() const;
+   virtual double MaximumValue() const;
+};
+
+extern CFA2RGBColorMatrix20Parameter* TheCFA2RGBColorMatrix20Parameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBColorMatrix21Parameter : public MetaDouble
+{
+public:
+
+   CFA2RGBColorMatrix21Parameter( MetaProcess* );
+
+   virtual IsoString Id() const;
+   virtual int Precision() const;
+   virtual double DefaultValue() const;
+   virtual double MinimumValue() const;
+   virtual double MaximumValue() const;
+};
+
+extern CFA2RGBColorMatrix21Parameter* TheCFA2RGBColorMatrix21Parameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBColorMatrix22Parameter : public MetaDouble
+{
+public:
+
+   CFA2RGBColorMatrix22Parameter( MetaProcess* );
+
+   virtual IsoString Id() const;
+   virtual int Precision() const;
+   virtual double DefaultValue() const;
+   virtual double MinimumValue() const;
+   virtual double MaximumValue() const;
+};
+
+extern CFA2RGBColorMatrix22Parameter* TheCFA2RGBColorMatrix22Parameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBUseROIParameter : public MetaBoolean
+{
+public:
+
+   CFA2RGBUseROIParameter( MetaProcess* );
+
+   virtual IsoString Id() const;
+   virtual bool DefaultValue() const;
+};
+
+extern CFA2RGBUseROIParameter* TheCFA2RGBUseROIParameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBROIX0Parameter : public MetaInt32
+{
+public:
+
+   CFA2RGBROIX0Parameter( MetaProcess* );
+
+   virtual IsoString Id() const;
+   virtual double DefaultValue() const;
+   virtual double MinimumValue() const;
+   virtual double MaximumValue() const;
+};
+
+extern CFA2RGBROIX0Parameter* TheCFA2RGBROIX0Parameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBROIY0Parameter : public MetaInt32
+{
+public:
+
+   CFA2RGBROIY0Parameter( MetaProcess* );
+
+   virtual IsoString Id() const;
+   virtual double DefaultValue() const;
+   virtual double MinimumValue() const;
+   virtual double MaximumValue() const;
+};
+
+extern CFA2RGBROIY0Parameter* TheCFA2RGBROIY0Parameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBROIX1Parameter : public MetaInt32
+{
+public:
+
+   CFA2RGBROIX1Parameter( MetaProcess* );
+
+   virtual IsoString Id() const;
+   virtual double DefaultValue() const;
+   virtual double MinimumValue() const;
+   virtual double MaximumValue() const;
+};
+
+extern CFA2RGBROIX1Parameter* TheCFA2RGBROIX1Parameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBROIY1Parameter : public MetaInt32
+{
+public:
+
+   CFA2RGBROIY1Parameter( MetaProcess* );
+
+   virtual IsoString Id() const;
+   virtual double DefaultValue() const;
+   virtual double MinimumValue() const;
+   virtual double MaximumValue() const;
+};
+
+extern CFA2RGBROIY1Parameter* TheCFA2RGBROIY1Parameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBSourceViewParameter : public MetaString
+{
+public:
+
+   CFA2RGBSourceViewParameter( MetaProcess* );
+
+   virtual IsoString Id() const;
+};
+
+extern CFA2RGBSourceViewParameter* TheCFA2RGBSourceViewParameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBDirtyRectsParameter : public MetaTable
+{
+public:
+
+   CFA2RGBDirtyRectsParameter( MetaProcess* );
+
+   virtual IsoString Id() const;
+};
+
+extern CFA2RGBDirtyRectsParameter* TheCFA2RGBDirtyRectsParameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBDirtyX0Parameter : public MetaInt32
+{
+public:
+
+   CFA2RGBDirtyX0Parameter( MetaTable* );
+
+   virtual IsoString Id() const;
+   virtual double DefaultValue() const;
+   virtual double MinimumValue() const;
+   virtual double MaximumValue() const;
+};
+
+extern CFA2RGBDirtyX0Parameter* TheCFA2RGBDirtyX0Parameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBDirtyY0Parameter : public MetaInt32
+{
+public:
+
+   CFA2RGBDirtyY0Parameter( MetaTable* );
+
+   virtual IsoString Id() const;
+   virtual double DefaultValue() const;
+   virtual double MinimumValue() const;
+   virtual double MaximumValue() const;
+};
+
+extern CFA2RGBDirtyY0Parameter* TheCFA2RGBDirtyY0Parameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBDirtyX1Parameter : public MetaInt32
+{
+public:
+
+   CFA2RGBDirtyX1Parameter( MetaTable* );
+
+   virtual IsoString Id() const;
+   virtual double DefaultValue() const;
+   virtual double MinimumValue() const;
+   virtual double MaximumValue() const;
+};
+
+extern CFA2RGBDirtyX1Parameter* TheCFA2RGBDirtyX1Parameter;
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBDirtyY1Parameter : public MetaInt32
+{
+public:
+
+   CFA2RGBDirtyY1Parameter( MetaTable* );
+
+   virtual IsoString Id() const;
+   virtual double DefaultValue() const;
+   virtual double MinimumValue() const;
+   virtual double MaximumValue() const;
+};
+
+extern CFA2RGBDirtyY1Parameter* TheCFA2RGBDirtyY1Parameter;
+
+// ----------------------------------------------------------------------------
+
 PCL_END_LOCAL
 
 } // pcl
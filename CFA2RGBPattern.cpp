@@ -0,0 +1,217 @@
+//     ____   ______ __
+//    / __ \ / ____// /
+//   / /_/ // /    / /
+//  / ____// /___ / /___   PixInsight Class Library
+// /_/     \____//_____/   PCL 02.01.00.0779
+// ----------------------------------------------------------------------------
+// Standard CFA2RGB Process Module Version 01.01.01.0010
+// ----------------------------------------------------------------------------
+// CFA2RGBPattern.cpp - Released 2016/02/03 00:00:00 UTC
+// ----------------------------------------------------------------------------
+// This file is part of the standard CFA2RGB PixInsight module.
+//
+// Copyright (c) 2003-2016 Pleiades Astrophoto S.L. All Rights Reserved.
+//
+// Redistribution and use in both source and binary forms, with or without
+// modification, is permitted provided that the following conditions are met:
+//
+// 1. All redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. All redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the names "PixInsight" and "Pleiades Astrophoto", nor the names
+//    of their contributors, may be used to endorse or promote products derived
+//    from this software without specific prior written permission. For written
+//    permission, please contact info@pixinsight.com.
+//
+// 4. All products derived from this software, in any form whatsoever, must
+//    reproduce the following acknowledgment in the end-user documentation
+//    and/or other materials provided with the product:
+//
+//    "This product is based on software from the PixInsight project, developed
+//    by Pleiades Astrophoto and its contributors (http://pixinsight.com/)."
+//
+//    Alternatively, if that is where third-party acknowledgments normally
+//    appear, this acknowledgment must be reproduced in the product itself.
+//
+// THIS SOFTWARE IS PROVIDED BY PLEIADES ASTROPHOTO AND ITS CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL PLEIADES ASTROPHOTO OR ITS
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, BUSINESS
+// INTERRUPTION; PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; AND LOSS OF USE,
+// DATA OR PROFITS) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// ----------------------------------------------------------------------------
+
+
+#include "CFA2RGBParameters.h"
+#include "CFA2RGBPattern.h"
+
+#include <pcl/AutoLock.h>
+#include <pcl/AutoPointer.h>
+#include <pcl/Exception.h>
+
+namespace pcl
+{
+
+// ----------------------------------------------------------------------------
+
+/*
+ * Pattern layouts indexed by CFA2RGBBayerPatternParameter value: the 2x2
+ * Bayer cell, row by row, with each site replicated over a square block of
+ * blockSize pixels.
+ */
+static const struct { const char* bayerCell; int blockSize; pcl_enum binnedId; }
+s_layouts[ CFA2RGBBayerPatternParameter::NumberOfItems ] =
+{
+   { "RGGB", 1, CFA2RGBBayerPatternParameter::RGGB },
+   { "BGGR", 1, CFA2RGBBayerPatternParameter::BGGR },
+   { "GBRG", 1, CFA2RGBBayerPatternParameter::GBRG },
+   { "GRBG", 1, CFA2RGBBayerPatternParameter::GRBG },
+   { "RGGB", 2, CFA2RGBBayerPatternParameter::RGGB },
+   { "BGGR", 2, CFA2RGBBayerPatternParameter::BGGR },
+   { "GBRG", 2, CFA2RGBBayerPatternParameter::GBRG },
+   { "GRBG", 2, CFA2RGBBayerPatternParameter::GRBG },
+   { "RGGB", 3, CFA2RGBBayerPatternParameter::RGGB },
+   { "BGGR", 3, CFA2RGBBayerPatternParameter::BGGR },
+   { "GBRG", 3, CFA2RGBBayerPatternParameter::GBRG },
+   { "GRBG", 3, CFA2RGBBayerPatternParameter::GRBG }
+};
+
+static AutoPointer<CFA2RGBPattern> s_patterns[ CFA2RGBBayerPatternParameter::NumberOfItems ];
+static Mutex                       s_patternsMutex;
+
+// ----------------------------------------------------------------------------
+
+const CFA2RGBPattern& CFA2RGBPattern::ForId( pcl_enum pattern )
+{
+   if ( pattern < 0 || pattern >= CFA2RGBBayerPatternParameter::NumberOfItems )
+      throw Error( "CFA2RGB: Invalid CFA pattern." );
+
+   AutoLock lock( s_patternsMutex );
+   if ( s_patterns[pattern].IsNull() )
+      s_patterns[pattern].SetPointer( new CFA2RGBPattern( TheCFA2RGBBayerPatternParameter->ElementId( pattern ),
+                                                          s_layouts[pattern].bayerCell,
+                                                          s_layouts[pattern].blockSize,
+                                                          s_layouts[pattern].binnedId ) );
+   return *s_patterns[pattern];
+}
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBPattern::CFA2RGBPattern( const IsoString& id, const char* bayerCell, int blockSize, pcl_enum binnedId ) :
+m_id( id ),
+m_blockSize( blockSize ),
+m_period( 2*blockSize ),
+m_binnedId( binnedId ),
+m_channels( new uint8[ m_period*m_period ] ),
+m_rowMasks( new uint32[ m_period*3 ] ),
+m_laneMasks( new uint8[ m_period*3*LaneCount ] ),
+m_neighbors( new Neighbors[ m_period*m_period*3 ] ),
+m_greenRadius( 0 ),
+m_neighborRadius( 0 )
+{
+   const int period = m_period;
+
+   for ( int y = 0; y < period; ++y )
+      for ( int x = 0; x < period; ++x )
+         switch ( bayerCell[(y/blockSize)*2 + x/blockSize] )
+         {
+         case 'R': m_channels[y*period + x] = 0; break;
+         case 'G': m_channels[y*period + x] = 1; break;
+         case 'B': m_channels[y*period + x] = 2; break;
+         }
+
+   for ( int y = 0; y < period; ++y )
+      for ( int c = 0; c < 3; ++c )
+      {
+         uint32 mask = 0;
+         for ( int x = 0; x < period; ++x )
+            if ( m_channels[y*period + x] == c )
+               mask |= uint32( 1 ) << x;
+         m_rowMasks[y*3 + c] = mask;
+
+         uint8* lanes = m_laneMasks + (y*3 + c)*LaneCount;
+         for ( int i = 0; i < LaneCount; ++i )
+            lanes[i] = (mask >> (i % period)) & 1;
+      }
+
+   /*
+    * The neighbors of a channel around a site of another channel are all
+    * sites of the channel at the smallest Euclidean distance, searched within
+    * one pattern period.
+    */
+   for ( int y = 0; y < period; ++y )
+      for ( int x = 0; x < period; ++x )
+         for ( int c = 0; c < 3; ++c )
+         {
+            Neighbors& n = m_neighbors[(y*period + x)*3 + c];
+            n.count = 0;
+            n.directional = false;
+            if ( m_channels[y*period + x] == c )
+               continue;
+
+            int minD2 = int32_max;
+            for ( int dy = -period; dy <= period; ++dy )
+               for ( int dx = -period; dx <= period; ++dx )
+                  if ( Channel( x + dx + period, y + dy + period ) == c )
+                  {
+                     int d2 = dx*dx + dy*dy;
+                     if ( d2 < minD2 )
+                     {
+                        minD2 = d2;
+                        n.count = 0;
+                     }
+                     if ( d2 == minD2 && n.count < Neighbors::MaxCount )
+                     {
+                        n.dx[n.count] = dx;
+                        n.dy[n.count] = dy;
+                        ++n.count;
+                     }
+                  }
+
+            /*
+             * The search visits rows top to bottom, so four orthogonal
+             * neighbors are found as up, left, right, down.
+             */
+            if ( n.count == 4 && n.dx[0] == 0 && n.dx[3] == 0 && n.dy[0] == -n.dy[3] &&
+                                 n.dy[1] == 0 && n.dy[2] == 0 && n.dx[1] == -n.dx[2] )
+            {
+               int ux = n.dx[0], uy = n.dy[0];
+               n.dx[0] = n.dx[1]; n.dy[0] = n.dy[1];
+               n.dx[1] = n.dx[2]; n.dy[1] = n.dy[2];
+               n.dx[2] = ux;      n.dy[2] = uy;
+               n.directional = true;
+            }
+
+            for ( int i = 0; i < n.count; ++i )
+            {
+               int d = Max( Abs( n.dx[i] ), Abs( n.dy[i] ) );
+               m_neighborRadius = Max( m_neighborRadius, d );
+               if ( c == 1 )
+                  m_greenRadius = Max( m_greenRadius, d );
+            }
+         }
+}
+
+CFA2RGBPattern::~CFA2RGBPattern()
+{
+   delete [] m_channels;
+   delete [] m_rowMasks;
+   delete [] m_laneMasks;
+   delete [] m_neighbors;
+}
+
+// ----------------------------------------------------------------------------
+
+} // pcl
+
+// ****************************************************************************
+// EOF CFA2RGBPattern.cpp - Released 2016/02/03 00:00:00 UTC
@@ -0,0 +1,220 @@
+//     ____   ______ __
+//    / __ \ / ____// /
+//   / /_/ // /    / /
+//  / ____// /___ / /___   PixInsight Class Library
+// /_/     \____//_____/   PCL 02.01.00.0779
+// ----------------------------------------------------------------------------
+// Standard CFA2RGB Process Module Version 01.01.01.0010
+// ----------------------------------------------------------------------------
+// CFA2RGBPattern.h - Released 2016/02/03 00:00:00 UTC
+// ----------------------------------------------------------------------------
+// This file is part of the standard CFA2RGB PixInsight module.
+//
+// Copyright (c) 2003-2016 Pleiades Astrophoto S.L. All Rights Reserved.
+//
+// Redistribution and use in both source and binary forms, with or without
+// modification, is permitted provided that the following conditions are met:
+//
+// 1. All redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. All redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the names "PixInsight" and "Pleiades Astrophoto", nor the names
+//    of their contributors, may be used to endorse or promote products derived
+//    from this software without specific prior written permission. For written
+//    permission, please contact info@pixinsight.com.
+//
+// 4. All products derived from this software, in any form whatsoever, must
+//    reproduce the following acknowledgment in the end-user documentation
+//    and/or other materials provided with the product:
+//
+//    "This product is based on software from the PixInsight project, developed
+//    by Pleiades Astrophoto and its contributors (http://pixinsight.com/)."
+//
+//    Alternatively, if that is where third-party acknowledgments normally
+//    appear, this acknowledgment must be reproduced in the product itself.
+//
+// THIS SOFTWARE IS PROVIDED BY PLEIADES ASTROPHOTO AND ITS CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL PLEIADES ASTROPHOTO OR ITS
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, BUSINESS
+// INTERRUPTION; PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; AND LOSS OF USE,
+// DATA OR PROFITS) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// ----------------------------------------------------------------------------
+
+
+#ifndef __CFA2RGBPattern_h
+#define __CFA2RGBPattern_h
+
+#include <pcl/MetaParameter.h> // for pcl_enum
+#include <pcl/String.h>
+
+namespace pcl
+{
+
+// ----------------------------------------------------------------------------
+
+/*
+ * Immutable descriptor of a CFA pattern.
+ *
+ * Holds the channel layout of the pattern cell along with precomputed
+ * per-row channel masks and lane selection masks for the vectorized
+ * expansion kernels. Descriptors are built on first use and shared by all
+ * executions for the lifetime of the module.
+ */
+class CFA2RGBPattern
+{
+public:
+
+   /*
+    * Number of samples in a block of the expansion kernels. A multiple of
+    * every supported pattern period (2, 4 and 6), so that blocks aligned to
+    * the mosaic start at the same pattern phase.
+    */
+   enum { LaneCount = 48 };
+
+   /*
+    * The nearest samples of a channel around a site of another channel, as
+    * offsets from the site. Empty for sites of the channel itself.
+    *
+    * Directional neighbor sets are two opposite horizontal neighbors,
+    * stored first, followed by two opposite vertical neighbors, as for green
+    * around red and blue sites of a Bayer pattern.
+    */
+   struct Neighbors
+   {
+      enum { MaxCount = 8 };
+
+      int  count;
+      int  dx[ MaxCount ];
+      int  dy[ MaxCount ];
+      bool directional;
+   };
+
+   /*
+    * Returns the cached descriptor of a CFA2RGBBayerPatternParameter value.
+    */
+   static const CFA2RGBPattern& ForId( pcl_enum pattern );
+
+   ~CFA2RGBPattern();
+
+   IsoString Id() const
+   {
+      return m_id;
+   }
+
+   /*
+    * Horizontal and vertical period of the pattern cell, in pixels.
+    */
+   int Period() const
+   {
+      return m_period;
+   }
+
+   /*
+    * Side of the square blocks of same-color pixels: 1 for Bayer, 2 for
+    * quad-Bayer and 3 for nonacell patterns.
+    */
+   int BlockSize() const
+   {
+      return m_blockSize;
+   }
+
+   /*
+    * The Bayer pattern sampled by averaging each block of same-color pixels.
+    * For a Bayer pattern, this is the pattern itself.
+    */
+   const CFA2RGBPattern& BinnedPattern() const
+   {
+      return ForId( m_binnedId );
+   }
+
+   /*
+    * Channel index (0=R, 1=G, 2=B) at nonnegative mosaic coordinates.
+    */
+   int Channel( int x, int y ) const
+   {
+      return m_channels[(y % m_period)*m_period + x % m_period];
+   }
+
+   /*
+    * Bit i is set iff column i of the pattern cell row y mod Period() belongs
+    * to channel c.
+    */
+   uint32 RowMask( int y, int c ) const
+   {
+      return m_rowMasks[(y % m_period)*3 + c];
+   }
+
+   /*
+    * LaneCount() selection flags (0 or 1) for channel c on row y mod
+    * Period(), starting at a mosaic column multiple of LaneCount.
+    */
+   const uint8* LaneMask( int y, int c ) const
+   {
+      return m_laneMasks + ((y % m_period)*3 + c)*LaneCount;
+   }
+
+   /*
+    * Neighbors of channel c of the site at nonnegative mosaic coordinates.
+    */
+   const Neighbors& ChannelNeighbors( int x, int y, int c ) const
+   {
+      return m_neighbors[((y % m_period)*m_period + x % m_period)*3 + c];
+   }
+
+   const Neighbors& GreenNeighbors( int x, int y ) const
+   {
+      return ChannelNeighbors( x, y, 1 );
+   }
+
+   /*
+    * Largest horizontal or vertical distance to a green neighbor.
+    */
+   int GreenRadius() const
+   {
+      return m_greenRadius;
+   }
+
+   /*
+    * Largest horizontal or vertical distance to a neighbor of any channel.
+    */
+   int NeighborRadius() const
+   {
+      return m_neighborRadius;
+   }
+
+private:
+
+   IsoString m_id;
+   int       m_blockSize;
+   int       m_period;
+   pcl_enum  m_binnedId;
+   uint8*    m_channels;
+   uint32*   m_rowMasks;
+   uint8*    m_laneMasks;
+   Neighbors* m_neighbors;
+   int       m_greenRadius;
+   int       m_neighborRadius;
+
+   CFA2RGBPattern( const IsoString& id, const char* bayerCell, int blockSize, pcl_enum binnedId );
+   CFA2RGBPattern( const CFA2RGBPattern& ) = delete;
+   CFA2RGBPattern& operator =( const CFA2RGBPattern& ) = delete;
+};
+
+// ----------------------------------------------------------------------------
+
+} // pcl
+
+#endif   // __CFA2RGBPattern_h
+
+// ****************************************************************************
+// EOF CFA2RGBPattern.h - Released 2016/02/03 00:00:00 UTC
@@ -75,6 +75,68 @@ CFA2RGBProcess::CFA2RGBProcess() : MetaProcess()
 
    // Instantiate process parameters
    new CFA2RGBBayerPatternParameter( this );
+   new CFA2RGBBlockBinningParameter( this );
+   new CFA2RGBGenerateCoverageMapsParameter( this );
+   new CFA2RGBTargetFramesParameter( this );
+   new CFA2RGBTargetFrameEnabledParameter( TheCFA2RGBTargetFramesParameter );
+   new CFA2RGBTargetFramePathParameter( TheCFA2RGBTargetFramesParameter );
+   new CFA2RGBOutputDirectoryParameter( this );
+   new CFA2RGBRawPackingParameter( this );
+   new CFA2RGBRawWidthParameter( this );
+   new CFA2RGBRawHeightParameter( this );
+   new CFA2RGBRawStrideParameter( this );
+   new CFA2RGBOutputPostfixParameter( this );
+   new CFA2RGBOverwriteExistingFilesParameter( this );
+   new CFA2RGBUseFileCacheParameter( this );
+   new CFA2RGBOutputCompressionParameter( this );
+   new CFA2RGBOutputByteShufflingParameter( this );
+   new CFA2RGBOnErrorParameter( this );
+   new CFA2RGBWriteOutputFilesParameter( this );
+   new CFA2RGBIntegrateFramesParameter( this );
+   new CFA2RGBGeneratePyramidParameter( this );
+   new CFA2RGBPyramidLevelsParameter( this );
+   new CFA2RGBPyramidFormatParameter( this );
+   new CFA2RGBMemoryBudgetParameter( this );
+   new CFA2RGBOutputModeParameter( this );
+   new CFA2RGBConvertOpenViewsParameter( this );
+   new CFA2RGBOutputSampleFormatParameter( this );
+   new CFA2RGBInterpolationParameter( this );
+   new CFA2RGBClaimDirectoryParameter( this );
+   new CFA2RGBClaimTimeoutParameter( this );
+   new CFA2RGBConversionTimeParameter( this );
+   new CFA2RGBConversionRateParameter( this );
+   new CFA2RGBCorrectLateralCAParameter( this );
+   new CFA2RGBLateralCARedK0Parameter( this );
+   new CFA2RGBLateralCARedK1Parameter( this );
+   new CFA2RGBLateralCARedK2Parameter( this );
+   new CFA2RGBLateralCABlueK0Parameter( this );
+   new CFA2RGBLateralCABlueK1Parameter( this );
+   new CFA2RGBLateralCABlueK2Parameter( this );
+   new CFA2RGBCellBinningParameter( this );
+   new CFA2RGBCellBinningModeParameter( this );
+   new CFA2RGBCellBinningOutputParameter( this );
+   new CFA2RGBApplyColorMatrixParameter( this );
+   new CFA2RGBColorMatrixSourceParameter( this );
+   new CFA2RGBColorMatrix00Parameter( this );
+   new CFA2RGBColorMatrix01Parameter( this );
+   new CFA2RGBColorMatrix02Parameter( this );
+   new CFA2RGBColorMatrix10Parameter( this );
+   new CFA2RGBColorMatrix11Parameter( this );
+   new CFA2RGBColorMatrix12Parameter( this );
+   new CFA2RGBColorMatrix20Parameter( this );
+   new CFA2RGBColorMatrix21Parameter( this );
+   new CFA2RGBColorMatrix22Parameter( this );
+   new CFA2RGBUseROIParameter( this );
+   new CFA2RGBROIX0Parameter( this );
+   new CFA2RGBROIY0Parameter( this );
+   new CFA2RGBROIX1Parameter( this );
+   new CFA2RGBROIY1Parameter( this );
+   new CFA2RGBSourceViewParameter( this );
+   new CFA2RGBDirtyRectsParameter( this );
+   new CFA2RGBDirtyX0Parameter( TheCFA2RGBDirtyRectsParameter );
+   new CFA2RGBDirtyY0Parameter( TheCFA2RGBDirtyRectsParameter );
+   new CFA2RGBDirtyX1Parameter( TheCFA2RGBDirtyRectsParameter );
+   new CFA2RGBDirtyY1Parameter( TheCFA2RGBDirtyRectsParameter );
 }
 
 // ----------------------------------------------------------------------------
@@ -131,6 +193,21 @@ ProcessImplementation* CFA2RGBProcess::Clone( const ProcessImplementation& p ) c
 
 // ----------------------------------------------------------------------------
 
+/*
+ * Lets scripts run the conversion on Image objects, without creating views.
+ */
+bool CFA2RGBProcess::CanProcessImages() const
+{
+   return true;
+}
+
+bool CFA2RGBProcess::CanProcessGlobal() const
+{
+   return true;
+}
+
+// ----------------------------------------------------------------------------
+
 } // pcl
 
 // ****************************************************************************
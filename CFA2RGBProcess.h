@@ -80,6 +80,9 @@ public:
    virtual ProcessImplementation* Create() const;
    virtual ProcessImplementation* Clone( const ProcessImplementation& ) const;
 
+   virtual bool CanProcessImages() const;
+   virtual bool CanProcessGlobal() const;
+
    //virtual bool CanProcessCommandLines() const;
    //virtual int ProcessCommandLine( const StringList& ) const;
 };
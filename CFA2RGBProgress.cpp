@@ -0,0 +1,149 @@
+//     ____   ______ __
+//    / __ \ / ____// /
+//   / /_/ // /    / /
+//  / ____// /___ / /___   PixInsight Class Library
+// /_/     \____//_____/   PCL 02.01.00.0779
+// ----------------------------------------------------------------------------
+// Standard CFA2RGB Process Module Version 01.01.01.0010
+// ----------------------------------------------------------------------------
+// CFA2RGBProgress.cpp - Released 2016/02/03 00:00:00 UTC
+// ----------------------------------------------------------------------------
+// This file is part of the standard CFA2RGB PixInsight module.
+//
+// Copyright (c) 2003-2016 Pleiades Astrophoto S.L. All Rights Reserved.
+//
+// Redistribution and use in both source and binary forms, with or without
+// modification, is permitted provided that the following conditions are met:
+//
+// 1. All redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. All redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the names "PixInsight" and "Pleiades Astrophoto", nor the names
+//    of their contributors, may be used to endorse or promote products derived
+//    from this software without specific prior written permission. For written
+//    permission, please contact info@pixinsight.com.
+//
+// 4. All products derived from this software, in any form whatsoever, must
+//    reproduce the following acknowledgment in the end-user documentation
+//    and/or other materials provided with the product:
+//
+//    "This product is based on software from the PixInsight project, developed
+//    by Pleiades Astrophoto and its contributors (http://pixinsight.com/)."
+//
+//    Alternatively, if that is where third-party acknowledgments normally
+//    appear, this acknowledgment must be reproduced in the product itself.
+//
+// THIS SOFTWARE IS PROVIDED BY PLEIADES ASTROPHOTO AND ITS CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL PLEIADES ASTROPHOTO OR ITS
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, BUSINESS
+// INTERRUPTION; PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; AND LOSS OF USE,
+// DATA OR PROFITS) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// ----------------------------------------------------------------------------
+
+
+#include "CFA2RGBProgress.h"
+
+#include <pcl/Exception.h>
+#include <pcl/MetaModule.h>
+#include <pcl/Thread.h>
+
+namespace pcl
+{
+
+// ----------------------------------------------------------------------------
+
+static thread_local CFA2RGBProgress* s_current = 0;
+
+CFA2RGBProgress::CFA2RGBProgress() :
+   m_rows( 0 ), m_aborted( false ), m_frames( 0 ), m_total( 0 ), m_countFrames( false ), m_reported( 0 ),
+   m_initialized( false )
+{
+}
+
+void CFA2RGBProgress::Initialize( const String& info, size_type totalRows )
+{
+   m_total = totalRows;
+   m_countFrames = false;
+   m_monitor.SetCallback( &m_status );
+   m_monitor.Initialize( info, m_total );
+   m_console.EnableAbort();
+   m_initialized = true;
+}
+
+void CFA2RGBProgress::InitializeFrames( const String& info, size_type totalFrames )
+{
+   Initialize( info, totalFrames );
+   m_countFrames = true;
+}
+
+void CFA2RGBProgress::Complete()
+{
+   if ( m_initialized && !IsAborted() )
+      m_monitor.Complete();
+}
+
+/*
+ * The status monitor refreshes the console at its own rate, which is too
+ * slow for cancellation: abort requests are checked on every call.
+ */
+void CFA2RGBProgress::Poll()
+{
+   if ( !m_initialized || IsAborted() || !Thread::IsRootThread() )
+      return;
+
+   Module->ProcessEvents();
+   if ( m_console.AbortRequested() )
+   {
+      Abort();
+      return;
+   }
+
+   /*
+    * A bounded monitor cannot be advanced past its total, which some
+    * fallback paths, such as a complete conversion instead of an
+    * incremental update, may exceed.
+    */
+   size_type count = Min( m_countFrames ? m_frames : Rows(), m_total );
+   if ( count > m_reported )
+      try
+      {
+         m_monitor += count - m_reported;
+         m_reported = count;
+      }
+      catch ( ProcessAborted& )
+      {
+         Abort();
+      }
+}
+
+CFA2RGBProgress* CFA2RGBProgress::Current()
+{
+   return s_current;
+}
+
+CFA2RGBProgress::Scope::Scope( CFA2RGBProgress* progress ) : m_previous( s_current )
+{
+   s_current = progress;
+}
+
+CFA2RGBProgress::Scope::~Scope()
+{
+   s_current = m_previous;
+}
+
+// ----------------------------------------------------------------------------
+
+} // pcl
+
+// ****************************************************************************
+// EOF CFA2RGBProgress.cpp - Released 2016/02/03 00:00:00 UTC
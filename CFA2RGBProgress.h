@@ -0,0 +1,229 @@
+//     ____   ______ __
+//    / __ \ / ____// /
+//   / /_/ // /    / /
+//  / ____// /___ / /___   PixInsight Class Library
+// /_/     \____//_____/   PCL 02.01.00.0779
+// ----------------------------------------------------------------------------
+// Standard CFA2RGB Process Module Version 01.01.01.0010
+// ----------------------------------------------------------------------------
+// CFA2RGBProgress.h - Released 2016/02/03 00:00:00 UTC
+// ----------------------------------------------------------------------------
+// This file is part of the standard CFA2RGB PixInsight module.
+//
+// Copyright (c) 2003-2016 Pleiades Astrophoto S.L. All Rights Reserved.
+//
+// Redistribution and use in both source and binary forms, with or without
+// modification, is permitted provided that the following conditions are met:
+//
+// 1. All redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. All redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the names "PixInsight" and "Pleiades Astrophoto", nor the names
+//    of their contributors, may be used to endorse or promote products derived
+//    from this software without specific prior written permission. For written
+//    permission, please contact info@pixinsight.com.
+//
+// 4. All products derived from this software, in any form whatsoever, must
+//    reproduce the following acknowledgment in the end-user documentation
+//    and/or other materials provided with the product:
+//
+//    "This product is based on software from the PixInsight project, developed
+//    by Pleiades Astrophoto and its contributors (http://pixinsight.com/)."
+//
+//    Alternatively, if that is where third-party acknowledgments normally
+//    appear, this acknowledgment must be reproduced in the product itself.
+//
+// THIS SOFTWARE IS PROVIDED BY PLEIADES ASTROPHOTO AND ITS CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL PLEIADES ASTROPHOTO OR ITS
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, BUSINESS
+// INTERRUPTION; PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; AND LOSS OF USE,
+// DATA OR PROFITS) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// ----------------------------------------------------------------------------
+
+
+#ifndef __CFA2RGBProgress_h
+#define __CFA2RGBProgress_h
+
+#include <pcl/Console.h>
+#include <pcl/StandardStatus.h>
+#include <pcl/StatusMonitor.h>
+#include <pcl/String.h>
+
+#include <atomic>
+
+namespace pcl
+{
+
+// ----------------------------------------------------------------------------
+
+/*
+ * Progress and cancellation of a conversion.
+ *
+ * Kernel threads count the rows they complete and test the abort flag once
+ * per row, through a Band object, so that a conversion stops within one row
+ * of an abort request. Counters are accumulated per band and added to the
+ * shared atomic counter every few rows; there are no per-pixel checks.
+ *
+ * Only the root thread talks to the core application: while it waits for
+ * kernel tasks, it calls Poll() periodically to advance the status monitor
+ * and check whether the user has requested to abort.
+ */
+class CFA2RGBProgress
+{
+public:
+
+   /*
+    * Milliseconds between two Poll() calls of a waiting thread.
+    */
+   static const unsigned PollInterval = 50;
+
+   CFA2RGBProgress();
+
+   /*
+    * Starts a status monitor counting converted rows, out of the total
+    * number of output rows reported by the conversion kernels. Must be
+    * called from the root thread.
+    */
+   void Initialize( const String& info, size_type totalRows );
+
+   /*
+    * Starts a status monitor counting frames instead of rows, for batches
+    * whose frame sizes are not known in advance. Frames are counted with
+    * FrameDone().
+    */
+   void InitializeFrames( const String& info, size_type totalFrames );
+
+   /*
+    * Counts a completed frame of a batch. Must be called from the root thread.
+    */
+   void FrameDone()
+   {
+      ++m_frames;
+   }
+
+   /*
+    * Completes the status monitor, unless the conversion was aborted.
+    */
+   void Complete();
+
+   /*
+    * Called by threads waiting for kernel tasks. Does nothing unless called
+    * from the root thread.
+    */
+   void Poll();
+
+   void Abort()
+   {
+      m_aborted.store( true, std::memory_order_relaxed );
+   }
+
+   bool IsAborted() const
+   {
+      return m_aborted.load( std::memory_order_relaxed );
+   }
+
+   void AddRows( size_type rows )
+   {
+      m_rows.fetch_add( rows, std::memory_order_relaxed );
+   }
+
+   size_type Rows() const
+   {
+      return m_rows.load( std::memory_order_relaxed );
+   }
+
+   /*
+    * The progress object of the conversion being run by the calling thread,
+    * or zero.
+    */
+   static CFA2RGBProgress* Current();
+
+   /*
+    * Makes a progress object current for the calling thread during the
+    * lifetime of the scope object.
+    */
+   class Scope
+   {
+   public:
+
+      Scope( CFA2RGBProgress* progress );
+      ~Scope();
+
+   private:
+
+      CFA2RGBProgress* m_previous;
+   };
+
+   /*
+    * Row counter of a kernel task, reporting to the current progress object.
+    */
+   class Band
+   {
+   public:
+
+      Band() : m_progress( Current() ), m_rows( 0 )
+      {
+      }
+
+      ~Band()
+      {
+         if ( m_progress != 0 && m_rows > 0 )
+            m_progress->AddRows( m_rows );
+      }
+
+      /*
+       * Counts completed rows. Returns false if the task must stop.
+       */
+      bool Row( size_type rows = 1 )
+      {
+         if ( m_progress == 0 )
+            return true;
+         if ( (m_rows += rows) >= 16 )
+         {
+            m_progress->AddRows( m_rows );
+            m_rows = 0;
+         }
+         return !m_progress->IsAborted();
+      }
+
+   private:
+
+      CFA2RGBProgress* m_progress;
+      size_type        m_rows;
+   };
+
+private:
+
+   std::atomic<size_type> m_rows;
+   std::atomic<bool>      m_aborted;
+   size_type              m_frames;      // completed frames, root thread only
+   size_type              m_total;       // rows or frames
+   bool                   m_countFrames;
+   size_type              m_reported;
+   StatusMonitor          m_monitor;
+   StandardStatus         m_status;
+   Console                m_console;
+   bool                   m_initialized;
+
+   CFA2RGBProgress( const CFA2RGBProgress& ) = delete;
+   CFA2RGBProgress& operator =( const CFA2RGBProgress& ) = delete;
+};
+
+// ----------------------------------------------------------------------------
+
+} // pcl
+
+#endif   // __CFA2RGBProgress_h
+
+// ****************************************************************************
+// EOF CFA2RGBProgress.h - Released 2016/02/03 00:00:00 UTC
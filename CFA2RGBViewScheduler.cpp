@@ -0,0 +1,197 @@
+//     ____   ______ __
+//    / __ \ / ____// /
+//   / /_/ // /    / /
+//  / ____// /___ / /___   PixInsight Class Library
+// /_/     \____//_____/   PCL 02.01.00.0779
+// ----------------------------------------------------------------------------
+// Standard CFA2RGB Process Module Version 01.01.01.0010
+// ----------------------------------------------------------------------------
+// CFA2RGBViewScheduler.cpp - Released 2016/02/03 00:00:00 UTC
+// ----------------------------------------------------------------------------
+// This file is part of the standard CFA2RGB PixInsight module.
+//
+// Copyright (c) 2003-2016 Pleiades Astrophoto S.L. All Rights Reserved.
+//
+// Redistribution and use in both source and binary forms, with or without
+// modification, is permitted provided that the following conditions are met:
+//
+// 1. All redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. All redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the names "PixInsight" and "Pleiades Astrophoto", nor the names
+//    of their contributors, may be used to endorse or promote products derived
+//    from this software without specific prior written permission. For written
+//    permission, please contact info@pixinsight.com.
+//
+// 4. All products derived from this software, in any form whatsoever, must
+//    reproduce the following acknowledgment in the end-user documentation
+//    and/or other materials provided with the product:
+//
+//    "This product is based on software from the PixInsight project, developed
+//    by Pleiades Astrophoto and its contributors (http://pixinsight.com/)."
+//
+//    Alternatively, if that is where third-party acknowledgments normally
+//    appear, this acknowledgment must be reproduced in the product itself.
+//
+// THIS SOFTWARE IS PROVIDED BY PLEIADES ASTROPHOTO AND ITS CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL PLEIADES ASTROPHOTO OR ITS
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, BUSINESS
+// INTERRUPTION; PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; AND LOSS OF USE,
+// DATA OR PROFITS) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// ----------------------------------------------------------------------------
+
+
+#include "CFA2RGBProgress.h"
+#include "CFA2RGBViewScheduler.h"
+#include "CFA2RGBWorkerPool.h"
+
+#include <pcl/Exception.h>
+#include <pcl/Thread.h>
+
+namespace pcl
+{
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBViewJob : public Thread
+{
+public:
+
+   CFA2RGBViewJob( CFA2RGBViewScheduler& scheduler, CFA2RGBViewScheduler::Job& job ) :
+   Thread(), m_scheduler( scheduler ), m_job( job )
+   {
+   }
+
+   virtual void Run()
+   {
+      m_scheduler.RunJob( m_job );
+   }
+
+private:
+
+   CFA2RGBViewScheduler&      m_scheduler;
+   CFA2RGBViewScheduler::Job& m_job;
+};
+
+// ----------------------------------------------------------------------------
+
+CFA2RGBViewScheduler::CFA2RGBViewScheduler( const CFA2RGBEngine& engine ) :
+m_engine( engine ), m_concurrency( 0 )
+{
+}
+
+size_type CFA2RGBViewScheduler::Add( const ImageVariant& source, ImageVariant& target, CFA2RGBCoverageMap* coverage,
+                                     const CFA2RGBColorMatrix* matrix )
+{
+   Job job;
+   job.source = source;
+   job.target = target;
+   job.coverage = coverage;
+   job.hasMatrix = matrix != 0;
+   if ( matrix != 0 )
+      job.matrix = *matrix;
+   job.pixels = source->NumberOfPixels();
+   job.threads = 1;
+   job.succeeded = false;
+   m_jobs.Add( job );
+   return m_jobs.Length() - 1;
+}
+
+/*
+ * With N processors and K concurrent workers, a job of average size gets
+ * N/K threads; larger and smaller jobs get proportionally more or fewer,
+ * between one and N. The jobs are queued on the shared worker pool largest
+ * first, which keeps the workers busy until the end of the batch; the
+ * conversion threads of each job are pool tasks too, run by the worker that
+ * runs the job while it waits for them.
+ */
+void CFA2RGBViewScheduler::Run()
+{
+   if ( m_jobs.IsEmpty() )
+      return;
+
+   const int processors = Thread::NumberOfThreads( PCL_MAX_PROCESSORS, 1 );
+   m_concurrency = int( Min( m_jobs.Length(), size_type( processors ) ) );
+
+   double meanPixels = 0;
+   for ( Array<Job>::const_iterator i = m_jobs.Begin(); i != m_jobs.End(); ++i )
+      meanPixels += i->pixels;
+   meanPixels /= m_jobs.Length();
+
+   for ( Array<Job>::iterator i = m_jobs.Begin(); i != m_jobs.End(); ++i )
+      i->threads = Range( RoundInt( double( processors )/m_concurrency * i->pixels/meanPixels ), 1, processors );
+
+   if ( m_concurrency > 1 )
+   {
+      Array<size_type> order;
+      for ( size_type i = 0; i < m_jobs.Length(); ++i )
+         order.Add( i );
+      order.Sort( [this]( size_type a, size_type b ) { return m_jobs[a].pixels > m_jobs[b].pixels; } );
+
+      ReferenceArray<CFA2RGBViewJob> jobs;
+      Array<Thread*> tasks;
+      for ( Array<size_type>::const_iterator i = order.Begin(); i != order.End(); ++i )
+      {
+         jobs.Add( new CFA2RGBViewJob( *this, m_jobs[*i] ) );
+         tasks.Add( &jobs[jobs.Length()-1] );
+      }
+      try
+      {
+         CFA2RGBWorkerPool::Shared().Run( tasks, m_engine.Progress() );
+      }
+      catch ( ... )
+      {
+         jobs.Destroy();
+         throw;
+      }
+      jobs.Destroy();
+   }
+   else
+   {
+      // A single job can use all processors.
+      m_jobs[0].threads = 0;
+      RunJob( m_jobs[0] );
+   }
+}
+
+void CFA2RGBViewScheduler::RunJob( Job& job )
+{
+   try
+   {
+      CFA2RGBEngine engine( m_engine );
+      engine.SetMaxThreads( job.threads );
+      if ( job.hasMatrix )
+         engine.SetColorMatrix( job.matrix );
+      engine.Convert( job.target, job.source, job.coverage );
+      job.succeeded = true;
+   }
+   catch ( Exception& x )
+   {
+      job.errorMessage = x.Message();
+   }
+   catch ( std::bad_alloc& )
+   {
+      job.errorMessage = "Out of memory";
+   }
+   catch ( ... )
+   {
+      job.errorMessage = "Unknown error";
+   }
+}
+
+// ----------------------------------------------------------------------------
+
+} // pcl
+
+// ****************************************************************************
+// EOF CFA2RGBViewScheduler.cpp - Released 2016/02/03 00:00:00 UTC
@@ -0,0 +1,163 @@
+//     ____   ______ __
+//    / __ \ / ____// /
+//   / /_/ // /    / /
+//  / ____// /___ / /___   PixInsight Class Library
+// /_/     \____//_____/   PCL 02.01.00.0779
+// ----------------------------------------------------------------------------
+// Standard CFA2RGB Process Module Version 01.01.01.0010
+// ----------------------------------------------------------------------------
+// CFA2RGBViewScheduler.h - Released 2016/02/03 00:00:00 UTC
+// ----------------------------------------------------------------------------
+// This file is part of the standard CFA2RGB PixInsight module.
+//
+// Copyright (c) 2003-2016 Pleiades Astrophoto S.L. All Rights Reserved.
+//
+// Redistribution and use in both source and binary forms, with or without
+// modification, is permitted provided that the following conditions are met:
+//
+// 1. All redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. All redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the names "PixInsight" and "Pleiades Astrophoto", nor the names
+//    of their contributors, may be used to endorse or promote products derived
+//    from this software without specific prior written permission. For written
+//    permission, please contact info@pixinsight.com.
+//
+// 4. All products derived from this software, in any form whatsoever, must
+//    reproduce the following acknowledgment in the end-user documentation
+//    and/or other materials provided with the product:
+//
+//    "This product is based on software from the PixInsight project, developed
+//    by Pleiades Astrophoto and its contributors (http://pixinsight.com/)."
+//
+//    Alternatively, if that is where third-party acknowledgments normally
+//    appear, this acknowledgment must be reproduced in the product itself.
+//
+// THIS SOFTWARE IS PROVIDED BY PLEIADES ASTROPHOTO AND ITS CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL PLEIADES ASTROPHOTO OR ITS
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, BUSINESS
+// INTERRUPTION; PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; AND LOSS OF USE,
+// DATA OR PROFITS) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// ----------------------------------------------------------------------------
+
+
+#ifndef __CFA2RGBViewScheduler_h
+#define __CFA2RGBViewScheduler_h
+
+#include <pcl/Array.h>
+#include <pcl/ImageVariant.h>
+#include <pcl/String.h>
+
+#include "CFA2RGBEngine.h"
+
+namespace pcl
+{
+
+// ----------------------------------------------------------------------------
+
+/*
+ * Concurrent conversion of several images.
+ *
+ * Each job converts a source CFA image into a preallocated target image.
+ * Jobs are run as tasks of the shared worker pool, largest images first.
+ * Every job gets a share of the processor threads proportional to its size,
+ * so many mid-size images are converted side by side with one thread each,
+ * while a few large ones are split among all processors.
+ *
+ * Worker threads only access pixel data: targets must have the output
+ * geometry of the engine, so that no image is reallocated by a worker.
+ */
+class CFA2RGBViewScheduler
+{
+public:
+
+   CFA2RGBViewScheduler( const CFA2RGBEngine& engine );
+
+   /*
+    * Adds a conversion job. coverage can be zero. A nonzero matrix replaces
+    * the color matrix of the engine for this job. Returns the job index.
+    */
+   size_type Add( const ImageVariant& source, ImageVariant& target, CFA2RGBCoverageMap* coverage = 0,
+                  const CFA2RGBColorMatrix* matrix = 0 );
+
+   /*
+    * Runs all jobs and waits for them to complete. Errors are reported per
+    * job through Succeeded() and ErrorMessage(). If the engine has a progress
+    * object, it is polled while waiting; once it has been aborted, no more
+    * jobs are started and ProcessAborted is thrown.
+    */
+   void Run();
+
+   size_type NumberOfJobs() const
+   {
+      return m_jobs.Length();
+   }
+
+   bool Succeeded( size_type i ) const
+   {
+      return m_jobs[i].succeeded;
+   }
+
+   const String& ErrorMessage( size_type i ) const
+   {
+      return m_jobs[i].errorMessage;
+   }
+
+   /*
+    * Number of threads assigned to a job by the last Run().
+    */
+   int Threads( size_type i ) const
+   {
+      return m_jobs[i].threads;
+   }
+
+   /*
+    * Number of jobs run concurrently by the last Run().
+    */
+   int Concurrency() const
+   {
+      return m_concurrency;
+   }
+
+private:
+
+   struct Job
+   {
+      ImageVariant        source;
+      ImageVariant        target;
+      CFA2RGBCoverageMap* coverage;
+      bool                hasMatrix;
+      CFA2RGBColorMatrix  matrix;
+      size_type           pixels;
+      int                 threads;
+      bool                succeeded;
+      String              errorMessage;
+   };
+
+   const CFA2RGBEngine& m_engine;
+   Array<Job>           m_jobs;
+   int                  m_concurrency;
+
+   void RunJob( Job& );
+
+   friend class CFA2RGBViewJob;
+};
+
+// ----------------------------------------------------------------------------
+
+} // pcl
+
+#endif   // __CFA2RGBViewScheduler_h
+
+// ****************************************************************************
+// EOF CFA2RGBViewScheduler.h - Released 2016/02/03 00:00:00 UTC
@@ -0,0 +1,260 @@
+//     ____   ______ __
+//    / __ \ / ____// /
+//   / /_/ // /    / /
+//  / ____// /___ / /___   PixInsight Class Library
+// /_/     \____//_____/   PCL 02.01.00.0779
+// ----------------------------------------------------------------------------
+// Standard CFA2RGB Process Module Version 01.01.01.0010
+// ----------------------------------------------------------------------------
+// CFA2RGBWorkerPool.cpp - Released 2016/02/03 00:00:00 UTC
+// ----------------------------------------------------------------------------
+// This file is part of the standard CFA2RGB PixInsight module.
+//
+// Copyright (c) 2003-2016 Pleiades Astrophoto S.L. All Rights Reserved.
+//
+// Redistribution and use in both source and binary forms, with or without
+// modification, is permitted provided that the following conditions are met:
+//
+// 1. All redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. All redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the names "PixInsight" and "Pleiades Astrophoto", nor the names
+//    of their contributors, may be used to endorse or promote products derived
+//    from this software without specific prior written permission. For written
+//    permission, please contact info@pixinsight.com.
+//
+// 4. All products derived from this software, in any form whatsoever, must
+//    reproduce the following acknowledgment in the end-user documentation
+//    and/or other materials provided with the product:
+//
+//    "This product is based on software from the PixInsight project, developed
+//    by Pleiades Astrophoto and its contributors (http://pixinsight.com/)."
+//
+//    Alternatively, if that is where third-party acknowledgments normally
+//    appear, this acknowledgment must be reproduced in the product itself.
+//
+// THIS SOFTWARE IS PROVIDED BY PLEIADES ASTROPHOTO AND ITS CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL PLEIADES ASTROPHOTO OR ITS
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, BUSINESS
+// INTERRUPTION; PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; AND LOSS OF USE,
+// DATA OR PROFITS) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// ----------------------------------------------------------------------------
+
+
+#include "CFA2RGBProgress.h"
+#include "CFA2RGBWorkerPool.h"
+
+#include <pcl/Exception.h>
+
+#include <algorithm>
+#include <chrono>
+
+namespace pcl
+{
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBPoolWorker : public Thread
+{
+public:
+
+   CFA2RGBPoolWorker( CFA2RGBWorkerPool& pool ) : Thread(), m_pool( pool )
+   {
+   }
+
+   virtual void Run()
+   {
+      m_pool.Work();
+   }
+
+private:
+
+   CFA2RGBWorkerPool& m_pool;
+};
+
+// ----------------------------------------------------------------------------
+
+static CFA2RGBWorkerPool* s_pool = 0;
+static std::mutex         s_poolMutex;
+
+CFA2RGBWorkerPool& CFA2RGBWorkerPool::Shared()
+{
+   std::lock_guard<std::mutex> lock( s_poolMutex );
+   if ( s_pool == 0 )
+      s_pool = new CFA2RGBWorkerPool( Thread::NumberOfThreads( PCL_MAX_PROCESSORS, 1 ) - 1 );
+   return *s_pool;
+}
+
+void CFA2RGBWorkerPool::Shutdown()
+{
+   std::lock_guard<std::mutex> lock( s_poolMutex );
+   delete s_pool;
+   s_pool = 0;
+}
+
+/*
+ * Callers run one task of each batch themselves, so a single processor
+ * needs no workers at all.
+ */
+CFA2RGBWorkerPool::CFA2RGBWorkerPool( int numberOfWorkers ) : m_stop( false )
+{
+   for ( int i = 0; i < numberOfWorkers; ++i )
+   {
+      CFA2RGBPoolWorker* worker = new CFA2RGBPoolWorker( *this );
+      m_workers.Add( worker );
+      worker->Start( ThreadPriority::DefaultMax, i );
+   }
+}
+
+CFA2RGBWorkerPool::~CFA2RGBWorkerPool()
+{
+   {
+      std::lock_guard<std::mutex> lock( m_mutex );
+      m_stop = true;
+   }
+   m_notEmpty.notify_all();
+
+   for ( Array<CFA2RGBPoolWorker*>::iterator i = m_workers.Begin(); i != m_workers.End(); ++i )
+   {
+      (*i)->Wait();
+      delete *i;
+   }
+}
+
+void CFA2RGBWorkerPool::Run( const Array<Thread*>& tasks, CFA2RGBProgress* progress )
+{
+   if ( tasks.IsEmpty() )
+      return;
+
+   Batch batch;
+   batch.pending = int( tasks.Length() );
+   batch.progress = progress;
+
+   const size_type queued = m_workers.IsEmpty() ? 0 : ((progress != 0) ? tasks.Length() : tasks.Length()-1);
+   if ( queued > 0 )
+   {
+      {
+         std::lock_guard<std::mutex> lock( m_mutex );
+         for ( size_type i = 0; i < queued; ++i )
+         {
+            Task task = { tasks[i], &batch };
+            m_queue.push_back( task );
+         }
+      }
+      m_notEmpty.notify_all();
+   }
+
+   for ( size_type i = queued; i < tasks.Length(); ++i )
+   {
+      Finish( batch, RunTask( tasks[i], batch ) );
+      if ( progress != 0 )
+         progress->Poll();
+   }
+
+   std::unique_lock<std::mutex> lock( m_mutex );
+
+   /*
+    * Unless this is the root thread, which has to keep polling the progress
+    * object, run queued tasks of this batch while waiting for it. A task that
+    * runs a nested batch on the pool can thus never wait for workers that are
+    * all busy running tasks like itself.
+    */
+   if ( progress == 0 || !Thread::IsRootThread() )
+      for ( ;; )
+      {
+         std::deque<Task>::iterator i = std::find_if( m_queue.begin(), m_queue.end(),
+                                                      [&batch]( const Task& task ){ return task.batch == &batch; } );
+         if ( i == m_queue.end() )
+            break;
+         Thread* thread = i->thread;
+         m_queue.erase( i );
+         lock.unlock();
+         Finish( batch, RunTask( thread, batch ) );
+         lock.lock();
+      }
+
+   if ( progress != 0 )
+   {
+      while ( !m_done.wait_for( lock, std::chrono::milliseconds( CFA2RGBProgress::PollInterval ),
+                                [&batch]{ return batch.pending == 0; } ) )
+      {
+         lock.unlock();
+         progress->Poll();
+         lock.lock();
+      }
+      if ( progress->IsAborted() )
+         throw ProcessAborted();
+   }
+   else
+      m_done.wait( lock, [&batch]{ return batch.pending == 0; } );
+   if ( batch.error )
+      std::rethrow_exception( batch.error );
+}
+
+void CFA2RGBWorkerPool::Work()
+{
+   for ( ;; )
+   {
+      std::unique_lock<std::mutex> lock( m_mutex );
+      m_notEmpty.wait( lock, [this]{ return !m_queue.empty() || m_stop; } );
+      if ( m_queue.empty() )
+         return;
+      Task task = m_queue.front();
+      m_queue.pop_front();
+      lock.unlock();
+
+      Finish( *task.batch, RunTask( task.thread, *task.batch ) );
+   }
+}
+
+/*
+ * Runs a task with the progress object of its batch made current, unless
+ * the batch has been aborted. Returns the exception thrown by the task, if
+ * any, which is rethrown to the caller of Run(): the worker must survive.
+ */
+std::exception_ptr CFA2RGBWorkerPool::RunTask( Thread* thread, Batch& batch )
+{
+   if ( batch.progress != 0 && batch.progress->IsAborted() )
+      return std::exception_ptr();
+
+   CFA2RGBProgress::Scope scope( batch.progress );
+   try
+   {
+      thread->Run();
+      return std::exception_ptr();
+   }
+   catch ( ... )
+   {
+      return std::current_exception();
+   }
+}
+
+/*
+ * Notifies while holding the lock: once pending reaches zero, the caller of
+ * Run() may return and the pool may be shut down.
+ */
+void CFA2RGBWorkerPool::Finish( Batch& batch, std::exception_ptr error )
+{
+   std::lock_guard<std::mutex> lock( m_mutex );
+   if ( error && !batch.error )
+      batch.error = error;
+   if ( --batch.pending == 0 )
+      m_done.notify_all();
+}
+
+// ----------------------------------------------------------------------------
+
+} // pcl
+
+// ****************************************************************************
+// EOF CFA2RGBWorkerPool.cpp - Released 2016/02/03 00:00:00 UTC
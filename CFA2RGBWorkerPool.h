@@ -0,0 +1,161 @@
+//     ____   ______ __
+//    / __ \ / ____// /
+//   / /_/ // /    / /
+//  / ____// /___ / /___   PixInsight Class Library
+// /_/     \____//_____/   PCL 02.01.00.0779
+// ----------------------------------------------------------------------------
+// Standard CFA2RGB Process Module Version 01.01.01.0010
+// ----------------------------------------------------------------------------
+// CFA2RGBWorkerPool.h - Released 2016/02/03 00:00:00 UTC
+// ----------------------------------------------------------------------------
+// This file is part of the standard CFA2RGB PixInsight module.
+//
+// Copyright (c) 2003-2016 Pleiades Astrophoto S.L. All Rights Reserved.
+//
+// Redistribution and use in both source and binary forms, with or without
+// modification, is permitted provided that the following conditions are met:
+//
+// 1. All redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//
+// 2. All redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// 3. Neither the names "PixInsight" and "Pleiades Astrophoto", nor the names
+//    of their contributors, may be used to endorse or promote products derived
+//    from this software without specific prior written permission. For written
+//    permission, please contact info@pixinsight.com.
+//
+// 4. All products derived from this software, in any form whatsoever, must
+//    reproduce the following acknowledgment in the end-user documentation
+//    and/or other materials provided with the product:
+//
+//    "This product is based on software from the PixInsight project, developed
+//    by Pleiades Astrophoto and its contributors (http://pixinsight.com/)."
+//
+//    Alternatively, if that is where third-party acknowledgments normally
+//    appear, this acknowledgment must be reproduced in the product itself.
+//
+// THIS SOFTWARE IS PROVIDED BY PLEIADES ASTROPHOTO AND ITS CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+// PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL PLEIADES ASTROPHOTO OR ITS
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, BUSINESS
+// INTERRUPTION; PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; AND LOSS OF USE,
+// DATA OR PROFITS) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// ----------------------------------------------------------------------------
+
+
+#ifndef __CFA2RGBWorkerPool_h
+#define __CFA2RGBWorkerPool_h
+
+#include <pcl/Array.h>
+#include <pcl/Thread.h>
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+
+namespace pcl
+{
+
+// ----------------------------------------------------------------------------
+
+class CFA2RGBPoolWorker;
+class CFA2RGBProgress;
+
+/*
+ * Persistent pool of worker threads shared by all CFA2RGB instances.
+ *
+ * The pool is started on first use with one worker less than the processors
+ * allowed by the core application, each worker bound to its processor, since
+ * the thread calling Run() takes part in the work; the pool lives
+ * until the module is unloaded. Parallel kernels are still written as
+ * pcl::Thread subclasses, but instead of being started they are handed to
+ * Run(), which executes their Run() functions on the pool: no threads are
+ * created or destroyed per conversion.
+ *
+ * Run() can be called concurrently, also from tasks running on the pool;
+ * tasks of all callers are served in submission order.
+ */
+class CFA2RGBWorkerPool
+{
+public:
+
+   /*
+    * The pool of the module, started on the first call.
+    */
+   static CFA2RGBWorkerPool& Shared();
+
+   /*
+    * Stops the workers of the shared pool, if it has been started. Called
+    * when the module is unloaded.
+    */
+   static void Shutdown();
+
+   int NumberOfWorkers() const
+   {
+      return int( m_workers.Length() );
+   }
+
+   /*
+    * Runs the Run() functions of the specified threads, which must not have
+    * been started, and waits until all of them have returned. The calling
+    * thread runs the last task itself. If any task threw an exception, the
+    * first one thrown is rethrown here once all tasks have finished.
+    *
+    * With a progress object, all tasks are queued and the calling thread
+    * polls the object while it waits. Tasks not yet started when the
+    * conversion is aborted are skipped, and ProcessAborted is thrown.
+    */
+   void Run( const Array<Thread*>& tasks, CFA2RGBProgress* progress = 0 );
+
+private:
+
+   struct Batch
+   {
+      int                pending;
+      std::exception_ptr error;       // first exception thrown by a task
+      CFA2RGBProgress*   progress;
+   };
+
+   struct Task
+   {
+      Thread* thread;
+      Batch*  batch;
+   };
+
+   Array<CFA2RGBPoolWorker*> m_workers;
+   std::deque<Task>          m_queue;
+   bool                      m_stop;
+   std::mutex                m_mutex;
+   std::condition_variable   m_notEmpty;
+   std::condition_variable   m_done;
+
+   CFA2RGBWorkerPool( int numberOfWorkers );
+   ~CFA2RGBWorkerPool();
+
+   CFA2RGBWorkerPool( const CFA2RGBWorkerPool& ) = delete;
+   CFA2RGBWorkerPool& operator =( const CFA2RGBWorkerPool& ) = delete;
+
+   void Work();
+   std::exception_ptr RunTask( Thread*, Batch& );
+   void Finish( Batch&, std::exception_ptr error );
+
+   friend class CFA2RGBPoolWorker;
+};
+
+// ----------------------------------------------------------------------------
+
+} // pcl
+
+#endif   // __CFA2RGBWorkerPool_h
+
+// ****************************************************************************
+// EOF CFA2RGBWorkerPool.h - Released 2016/02/03 00:00:00 UTC